@@ -226,7 +226,11 @@ typedef enum
                                     was deleted in table. */
     RBUS_EVENT_VALUE_CHANGED,  /**< Notification that a property value
                                     was changed. */
-    RBUS_EVENT_GENERAL         /**< Provider defined event.*/
+    RBUS_EVENT_GENERAL,        /**< Provider defined event.*/
+    RBUS_EVENT_INTERVAL        /**< Periodic sample of the properties subscribed
+                                    to with an interval and no filter. The data
+                                    has one value per property instance, named
+                                    by the instance's full name. */
 } rbusEventType_t;
 
 /**
@@ -289,7 +293,12 @@ typedef struct _rbusEventSubscription
                                       */
     int32_t             interval;   /**< Total interval period after which
                                          the event needs to be fired. Should
-                                         be in multiples of minInterval
+                                         be in multiples of minInterval.
+                                         For a property without a filter, an
+                                         RBUS_EVENT_INTERVAL event with the
+                                         property's values is sent every interval
+                                         seconds. With a filter, the filter is
+                                         checked every interval seconds.
                                       */
     uint32_t            duration;   /** Optional maximum duration in seconds until which 
                                         the subscription should be in effect. Beyond this 
@@ -386,6 +395,32 @@ typedef rbusError_t (*rbusGetHandler_t)(
     rbusGetHandlerOptions_t* options
 );
 
+/** @fn typedef rbusError_t (*rbusGetMultiHandler_t)(
+ *          rbusHandle_t handle,
+ *          int numProps,
+ *          rbusProperty_t* properties,
+ *          rbusGetHandlerOptions_t* options)
+ *  @brief  A multi-property get callback handler.
+ *
+ * A provider can implement this handler to read many properties in one call, such as
+ * when their values come from a single backend query.  It is set on a registered element
+ * with rbus_regGetMultiHandler and is passed all the properties of a get request at or
+ * below that element, including those of a partial path or wildcard query.
+ * The handler should set the value of every property it can.  Properties left without
+ * a value, or all of them if the handler fails, are read with their own getHandler instead.
+ *  @param      handle          the rbus handle the properties are registered to.
+ *  @param      numProps        the number of properties in the properties array.
+ *  @param      properties      the properties whose values must be set by the handler.
+ *  @param      options         the additional information that to be used for GET.
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+typedef rbusError_t (*rbusGetMultiHandler_t)(
+    rbusHandle_t handle,
+    int numProps,
+    rbusProperty_t* properties,
+    rbusGetHandlerOptions_t* options
+);
+
 /** @fn typedef rbusError_t (*rbusSetHandler_t)(
  *          rbusHandle_t handle, 
  *          rbusProperty_t property,
@@ -410,6 +445,31 @@ typedef rbusError_t (*rbusSetHandler_t)(
     rbusSetHandlerOptions_t* options
 );
 
+/** @fn typedef rbusError_t (*rbusSetMultiHandler_t)(
+ *          rbusHandle_t handle,
+ *          int numProps,
+ *          rbusProperty_t* properties,
+ *          rbusSetHandlerOptions_t* options)
+ *  @brief  A multi-property set callback handler.
+ *
+ * A provider can implement this handler to apply many property values in one call, such
+ * as with one backend write.  It is set on a registered element with rbus_regSetMultiHandler
+ * and is passed, in one call, all the properties of a set request at or below that element.
+ * Every element of the request is looked up before any handler is called.  The options
+ * commit flag is that of the whole request, so the handler can apply all the values at once.
+ *  @param      handle          the rbus handle the properties are registered to.
+ *  @param      numProps        the number of properties in the properties array.
+ *  @param      properties      the properties with the names and values to set.
+ *  @param      options         the additional information that to be used for SET.
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+typedef rbusError_t (*rbusSetMultiHandler_t)(
+    rbusHandle_t handle,
+    int numProps,
+    rbusProperty_t* properties,
+    rbusSetHandlerOptions_t* options
+);
+
 /** @fn typedef rbusError_t (*rbusTableAddRowHandler_t)(
  *          rbusHandle_t handle,
  *          char const* tableName,
@@ -452,6 +512,62 @@ typedef rbusError_t (*rbusTableRemoveRowHandler_t)(
     rbusHandle_t handle,
     char const* rowName);
 
+/** @fn typedef rbusError_t (*rbusTableAddRowsHandler_t)(
+ *          rbusHandle_t handle,
+ *          char const* tableName,
+ *          int numRows,
+ *          char const* const* aliasNames,
+ *          uint32_t* instNums)
+ *  @brief A table multi-row add callback handler
+ *
+ * A provider can implement this handler to add many rows to a table in one call, such as when
+ * a consumer calls rbusTable_addRows.  It is set with rbusTable_setRowsHandlers after the
+ * table is registered.  If it's not set, rbus calls the tableAddRowHandler once per row instead.
+ * Each new row should be assigned a unique instance number, returned in instNums.  A row
+ * which can't be added must be left with instance number 0.
+ *  @param  handle          Bus Handle
+ *  @param  tableName       The name of a table (e.g. "Device.IP.Interface.")
+ *  @param  numRows         The number of rows to add
+ *  @param  aliasNames      Array of numRows optional names for the new rows.  Entries can be NULL.
+ *  @param  instNums        Output array of numRows where the instance numbers of the new rows are returned.
+ *                          Every entry is 0 when the handler is called.
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT
+ */
+typedef rbusError_t (*rbusTableAddRowsHandler_t)(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    char const* const* aliasNames,
+    uint32_t* instNums);
+
+/** @fn typedef rbusError_t (*rbusTableRemoveRowsHandler_t)(
+ *          rbusHandle_t handle,
+ *          char const* tableName,
+ *          int numRows,
+ *          char const* const* rowNames,
+ *          rbusError_t* results)
+ *  @brief A table multi-row remove callback handler
+ *
+ * A provider can implement this handler to remove many rows of a table in one call, such as when
+ * a consumer calls rbusTable_removeRows.  It is set with rbusTable_setRowsHandlers after the
+ * table is registered.  If it's not set, rbus calls the tableRemoveRowHandler once per row instead.
+ *  @param  handle          Bus Handle
+ *  @param  tableName       The name of the table the rows are in (e.g. "Device.IP.Interface.")
+ *  @param  numRows         The number of rows to remove
+ *  @param  rowNames        Array of numRows table row names (e.g. "Device.IP.Interface.1")
+ *  @param  results         Output array of numRows where the result of removing each row is returned.
+ *                          Every entry is RBUS_ERROR_SUCCESS when the handler is called.
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT
+ */
+typedef rbusError_t (*rbusTableRemoveRowsHandler_t)(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    char const* const* rowNames,
+    rbusError_t* results);
+
 /** @fn typedef rbusError_t (*rbusMethodHandler_t)(
  *          rbusHandle_t handle, 
  *          char const* methodName, 
@@ -700,6 +816,100 @@ rbusError_t rbus_open(
  */
 rbusError_t rbus_close(
     rbusHandle_t handle);
+
+/** @fn rbusError_t rbusHandle_ConfigGetTimeout(
+ *          rbusHandle_t handle,
+ *          uint32_t timeout)
+ *  @brief  Set the default timeout for get requests made with this handle.
+ *  This covers rbus_get, rbus_getExt, rbusTable_getRowNames and rbusElementInfo_get.
+ *  The timeout is overridden by rbusHandle_ConfigElementTimeouts and by the
+ *  /tmp/rbus_timeout_get file.
+ *  @param      handle          Bus Handle
+ *  @param      timeout         timeout in milliseconds, or 0 to use the process default
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+rbusError_t rbusHandle_ConfigGetTimeout(
+    rbusHandle_t handle,
+    uint32_t timeout);
+
+/** @fn rbusError_t rbusHandle_ConfigSetTimeout(
+ *          rbusHandle_t handle,
+ *          uint32_t timeout)
+ *  @brief  Set the default timeout for set requests made with this handle.
+ *  This covers rbus_set, rbus_setMulti, the rbusTable add and remove row calls
+ *  and rbusMethod_Invoke.  The timeout is overridden by rbusHandle_ConfigElementTimeouts
+ *  and by the /tmp/rbus_timeout_set file.
+ *  @param      handle          Bus Handle
+ *  @param      timeout         timeout in milliseconds, or 0 to use the process default
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+rbusError_t rbusHandle_ConfigSetTimeout(
+    rbusHandle_t handle,
+    uint32_t timeout);
+
+/** @fn rbusError_t rbusHandle_ConfigElementTimeouts(
+ *          rbusHandle_t handle,
+ *          char const* elementName,
+ *          uint32_t getTimeout,
+ *          uint32_t setTimeout)
+ *  @brief  Set the get and set timeouts for requests on elementName and every element below it.
+ *  elementName is matched as a prefix of the requested name, so "Device.WiFi."
+ *  covers all of Device.WiFi, and the longest matching prefix wins.
+ *  The override applies only to requests made with this handle and takes precedence over
+ *  its rbusHandle_ConfigGetTimeout and rbusHandle_ConfigSetTimeout timeouts, but not over
+ *  the /tmp/rbus_timeout_get and /tmp/rbus_timeout_set files.
+ *  @param      handle          Bus Handle
+ *  @param      elementName     the element name or partial path
+ *  @param      getTimeout      get timeout in milliseconds, or 0 to leave unset
+ *  @param      setTimeout      set timeout in milliseconds, or 0 to leave unset.
+ *                              Passing 0 for both removes the override.
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+rbusError_t rbusHandle_ConfigElementTimeouts(
+    rbusHandle_t handle,
+    char const* elementName,
+    uint32_t getTimeout,
+    uint32_t setTimeout);
+
+/** @fn rbusError_t rbusHandle_ConfigValueCache(
+ *          rbusHandle_t handle,
+ *          uint32_t ttl,
+ *          bool coherent)
+ *  @brief  Turn on caching of the values got with rbus_get and rbus_getExt on this handle.
+ *  A cached value is returned for ttl milliseconds after it was got, without a request
+ *  to the provider.  rbus_getExt uses the cache only when every name it asks for is cached.
+ *  Values set with rbus_set and rbus_setMulti on this handle are dropped from the cache.
+ *  When coherent is true, caching a property also subscribes to its value-change event,
+ *  and each event updates the cached value and restarts its ttl.  Properties which can't
+ *  be subscribed to are still cached for their ttl.  These subscriptions are the cache's own,
+ *  so the app can still subscribe to and unsubscribe from the same events.
+ *  @param      handle          Bus Handle
+ *  @param      ttl             how long a value is cached in milliseconds, or 0 to turn the cache off
+ *  @param      coherent        whether to keep cached values up to date with value-change events
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+rbusError_t rbusHandle_ConfigValueCache(
+    rbusHandle_t handle,
+    uint32_t ttl,
+    bool coherent);
+
+/** @fn rbusError_t rbusHandle_ConfigValueCacheTTL(
+ *          rbusHandle_t handle,
+ *          char const* elementName,
+ *          uint32_t ttl)
+ *  @brief  Set the value cache ttl for elementName and every element below it.
+ *  elementName is matched as a prefix of the property name and the longest matching
+ *  prefix wins, so a fast changing counter can be given a short ttl, or 0 to never
+ *  cache it, while the rest of its object uses the ttl from rbusHandle_ConfigValueCache.
+ *  @param      handle          Bus Handle
+ *  @param      elementName     the element name or partial path
+ *  @param      ttl             ttl in milliseconds, or 0 to never cache the values
+ *  @return                     RBus error code as defined by rbusError_t.
+ */
+rbusError_t rbusHandle_ConfigValueCacheTTL(
+    rbusHandle_t handle,
+    char const* elementName,
+    uint32_t ttl);
 /** @} */
 
 /** @addtogroup Discovery
@@ -810,6 +1020,51 @@ rbusError_t rbus_unregDataElements (
     int numDataElements,
     rbusDataElement_t *elements);
 
+/** @fn rbusError_t rbus_regGetMultiHandler(
+ *          rbusHandle_t handle,
+ *          char const* elementName,
+ *          rbusGetMultiHandler_t getMultiHandler)
+ *  @brief  Set the multi-property get handler of a registered element.
+ *
+ *  Get requests for properties at or below elementName are passed to getMultiHandler
+ *  in one call, instead of one getHandler call per property.  A property covered by
+ *  getMultiHandler doesn't need its own getHandler, except to be used with value-change
+ *  or interval subscriptions.  Where several elements have one, the nearest to the
+ *  property is used.                                                         \n
+ *  Used by:  Any provider that can read many of its properties at once.
+ *  @param      handle          Bus Handle
+ *  @param      elementName     The name of a registered object, table or property (e.g. "Device.WiFi.")
+ *  @param      getMultiHandler The multi-property get handler, or NULL to remove it
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, if the element isn't registered
+ */
+rbusError_t rbus_regGetMultiHandler(
+    rbusHandle_t handle,
+    char const* elementName,
+    rbusGetMultiHandler_t getMultiHandler);
+
+/** @fn rbusError_t rbus_regSetMultiHandler(
+ *          rbusHandle_t handle,
+ *          char const* elementName,
+ *          rbusSetMultiHandler_t setMultiHandler)
+ *  @brief  Set the multi-property set handler of a registered element.
+ *
+ *  The properties of a set request at or below elementName are passed to setMultiHandler
+ *  in one call, instead of one setHandler call per property.  A property covered by
+ *  setMultiHandler doesn't need its own setHandler.  Where several elements have one,
+ *  the nearest to the property is used.                                      \n
+ *  Used by:  Any provider that applies a change of many of its properties at once.
+ *  @param      handle          Bus Handle
+ *  @param      elementName     The name of a registered object, table or property (e.g. "Device.WiFi.")
+ *  @param      setMultiHandler The multi-property set handler, or NULL to remove it
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, if the element isn't registered
+ */
+rbusError_t rbus_regSetMultiHandler(
+    rbusHandle_t handle,
+    char const* elementName,
+    rbusSetMultiHandler_t setMultiHandler);
+
 /** @} */
 
 /** @addtogroup Consumers
@@ -895,6 +1150,191 @@ rbusError_t rbus_getExt(
     int *numProps,
     rbusProperty_t* properties);
 
+/** @fn rbusError_t rbus_getPage(
+ *          rbusHandle_t handle,
+ *          char const* query,
+ *          uint32_t pageSize,
+ *          uint32_t* cursor,
+ *          int* numProps,
+ *          rbusProperty_t* properties)
+ *  @brief Get one page of the results of a wildcard or partial path query.\n
+ *  Used by: Components that read large tables without holding all of them at once
+ *
+ * Start with a cursor of 0.  On return, cursor holds the position of the next page,
+ * or 0 once the last page was returned.  The cursor is only valid for the same query.
+ * Providers only read the values of the properties in the page, so neither side holds
+ * the whole result.  Rows added or removed between pages can make a property be skipped
+ * or returned twice.  A page can hold more than pageSize properties when the provider
+ * doesn't support paging and returns all its results, with a next cursor of 0.  A page
+ * can also hold fewer, including none, before the last one.
+ * The consumer should call rbusProperty_Release on the returned properties.
+ *  @param      handle          Bus Handle
+ *  @param      query           A wildcard or partial path query (see rbus_getExt)
+ *  @param      pageSize        The maximum number of properties the provider returns per page
+ *  @param      cursor          Input/output: the position of the page to get, then of the next page
+ *  @param      numProps        The number (count) of output properties
+ *  @param      properties      The output properties of the page
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are:
+ *  RBUS_ERROR_INVALID_INPUT: query is not a wildcard or partial path query.
+ *  RBUS_ERROR_ELEMENT_DOES_NOT_EXIST: Data Element was not previously registered.
+ *  RBUS_ERROR_DESTINATION_NOT_REACHABLE: Destination element was not reachable.
+ */
+rbusError_t rbus_getPage(
+    rbusHandle_t handle,
+    char const* query,
+    uint32_t pageSize,
+    uint32_t* cursor,
+    int* numProps,
+    rbusProperty_t* properties);
+
+/** @fn typedef bool (*rbusGetPageHandler_t)(
+ *          rbusHandle_t handle,
+ *          char const* query,
+ *          int numProps,
+ *          rbusProperty_t properties,
+ *          void* userData)
+ *  @brief A callback handler for each page of rbus_getStream.
+ *
+ * The properties are released after the handler returns; call rbusProperty_Retain to keep them.
+ *  @param      handle          Bus Handle
+ *  @param      query           The query passed to rbus_getStream
+ *  @param      numProps        The number of properties in the page
+ *  @param      properties      The properties of the page
+ *  @param      userData        The userData passed to rbus_getStream
+ *  @return true to get the next page, false to stop.
+ */
+typedef bool (*rbusGetPageHandler_t)(
+    rbusHandle_t handle,
+    char const* query,
+    int numProps,
+    rbusProperty_t properties,
+    void* userData);
+
+/** @fn rbusError_t rbus_getStream(
+ *          rbusHandle_t handle,
+ *          char const* query,
+ *          uint32_t pageSize,
+ *          rbusGetPageHandler_t handler,
+ *          void* userData)
+ *  @brief Get all the results of a wildcard or partial path query, one page at a time.\n
+ *  Used by: Components that export large tables
+ *
+ * Calls rbus_getPage until the last page and passes each page to handler as it arrives,
+ * so only one page is held at a time.
+ *  @param      handle          Bus Handle
+ *  @param      query           A wildcard or partial path query (see rbus_getExt)
+ *  @param      pageSize        The maximum number of properties the provider returns per page
+ *  @param      handler         The handler called with each page
+ *  @param      userData        User data passed back to handler
+ *  @return RBus error code as defined by rbusError_t, as for rbus_getPage.
+ */
+rbusError_t rbus_getStream(
+    rbusHandle_t handle,
+    char const* query,
+    uint32_t pageSize,
+    rbusGetPageHandler_t handler,
+    void* userData);
+
+/** @fn typedef void (*rbusGetAsyncHandler_t)(
+ *          rbusHandle_t handle,
+ *          char const* name,
+ *          rbusError_t error,
+ *          rbusValue_t value,
+ *          void* userData)
+ *  @brief A callback handler for the result of rbus_getAsync.
+ *
+ * The value is released after the handler returns; call rbusValue_Retain to keep it.
+ *  @param      handle          Bus Handle
+ *  @param      name            The name passed to rbus_getAsync
+ *  @param      error           The result of the get, as for rbus_get
+ *  @param      value           The value, or NULL if error isn't RBUS_ERROR_SUCCESS
+ *  @param      userData        The userData passed to rbus_getAsync
+ */
+typedef void (*rbusGetAsyncHandler_t)(
+    rbusHandle_t handle,
+    char const* name,
+    rbusError_t error,
+    rbusValue_t value,
+    void* userData);
+
+/** @fn rbusError_t rbus_getAsync(
+ *          rbusHandle_t handle,
+ *          char const* name,
+ *          rbusGetAsyncHandler_t callback,
+ *          void* userData)
+ *  @brief Get the value of a single parameter without blocking.
+ *
+ *  Used by: Components running an event loop, which can't block on a request
+ *
+ * The get is queued and made on a completion thread managed by rbus, which then calls
+ * callback with the result.  Up to 8 requests from rbus_getAsync, rbus_getExtAsync and
+ * rbus_setAsync are in flight at once, and the rest wait their turn in the order made.
+ * Callbacks can run on different threads at the same time.  Requests still queued when
+ * the handle is closed are completed by rbus_close with RBUS_ERROR_INVALID_HANDLE,
+ * and rbus_close waits for the running ones to complete.
+ *  @param      handle          Bus Handle
+ *  @param      name            The name of the parameter to get
+ *  @param      callback        The handler called with the result
+ *  @param      userData        User data passed back to callback
+ *  @return RBus error code as defined by rbusError_t.  If not RBUS_ERROR_SUCCESS,
+ *  the request wasn't queued and callback won't be called.
+ */
+rbusError_t rbus_getAsync(
+    rbusHandle_t handle,
+    char const* name,
+    rbusGetAsyncHandler_t callback,
+    void* userData);
+
+/** @fn typedef void (*rbusGetExtAsyncHandler_t)(
+ *          rbusHandle_t handle,
+ *          rbusError_t error,
+ *          int numProps,
+ *          rbusProperty_t properties,
+ *          void* userData)
+ *  @brief A callback handler for the result of rbus_getExtAsync.
+ *
+ * The properties are released after the handler returns; call rbusProperty_Retain to keep them.
+ *  @param      handle          Bus Handle
+ *  @param      error           The result of the get, as for rbus_getExt
+ *  @param      numProps        The number of properties, 0 if error isn't RBUS_ERROR_SUCCESS
+ *  @param      properties      The properties got, or NULL if error isn't RBUS_ERROR_SUCCESS
+ *  @param      userData        The userData passed to rbus_getExtAsync
+ */
+typedef void (*rbusGetExtAsyncHandler_t)(
+    rbusHandle_t handle,
+    rbusError_t error,
+    int numProps,
+    rbusProperty_t properties,
+    void* userData);
+
+/** @fn rbusError_t rbus_getExtAsync(
+ *          rbusHandle_t handle,
+ *          int paramCount,
+ *          char const** paramNames,
+ *          rbusGetExtAsyncHandler_t callback,
+ *          void* userData)
+ *  @brief Get the values of parameters, partial paths or wildcard queries without blocking.
+ *
+ *  Used by: Components running an event loop, which can't block on a request
+ *
+ * Queues an rbus_getExt to be made on a completion thread, as for rbus_getAsync.
+ * paramNames is copied, so it can be freed once this returns.
+ *  @param      handle          Bus Handle
+ *  @param      paramCount      The number (count) of input elements (parameters)
+ *  @param      paramNames      Input elements (parameters), as for rbus_getExt
+ *  @param      callback        The handler called with the result
+ *  @param      userData        User data passed back to callback
+ *  @return RBus error code as defined by rbusError_t.  If not RBUS_ERROR_SUCCESS,
+ *  the request wasn't queued and callback won't be called.
+ */
+rbusError_t rbus_getExtAsync(
+    rbusHandle_t handle,
+    int paramCount,
+    char const** paramNames,
+    rbusGetExtAsyncHandler_t callback,
+    void* userData);
+
 /** @fn rbusError_t rbus_getBoolean(
  *          rbusHandle_t handle,
  *          char const* paramName,
@@ -1022,6 +1462,54 @@ rbusError_t rbus_setMulti(
     rbusProperty_t properties,
     rbusSetOptions_t* opts);
 
+/** @fn typedef void (*rbusSetAsyncHandler_t)(
+ *          rbusHandle_t handle,
+ *          char const* name,
+ *          rbusError_t error,
+ *          void* userData)
+ *  @brief A callback handler for the result of rbus_setAsync.
+ *  @param      handle          Bus Handle
+ *  @param      name            The name passed to rbus_setAsync
+ *  @param      error           The result of the set, as for rbus_set
+ *  @param      userData        The userData passed to rbus_setAsync
+ */
+typedef void (*rbusSetAsyncHandler_t)(
+    rbusHandle_t handle,
+    char const* name,
+    rbusError_t error,
+    void* userData);
+
+/** @fn rbusError_t rbus_setAsync(
+ *          rbusHandle_t handle,
+ *          char const* name,
+ *          rbusValue_t value,
+ *          rbusSetOptions_t* opts,
+ *          rbusSetAsyncHandler_t callback,
+ *          void* userData)
+ *  @brief Set a single parameter without blocking.
+ *
+ *  Used by: Components running an event loop, which can't block on a request
+ *
+ * Queues an rbus_set to be made on a completion thread, as for rbus_getAsync.
+ * value is retained until the set is made, so it shouldn't be altered until callback
+ * is called.  opts is copied.
+ *  @param      handle          Bus Handle
+ *  @param      name            The name of the parameter to set.
+ *  @param      value           The value to set the parameter to.
+ *  @param      opts            Extra options, as for rbus_set, or NULL.
+ *  @param      callback        The handler called with the result
+ *  @param      userData        User data passed back to callback
+ *  @return RBus error code as defined by rbusError_t.  If not RBUS_ERROR_SUCCESS,
+ *  the request wasn't queued and callback won't be called.
+ */
+rbusError_t rbus_setAsync(
+    rbusHandle_t handle,
+    char const* name,
+    rbusValue_t value,
+    rbusSetOptions_t* opts,
+    rbusSetAsyncHandler_t callback,
+    void* userData);
+
 
 /** @fn rbusError_t rbus_setBoolean(
  *          rbusHandle_t handle,
@@ -1148,6 +1636,58 @@ rbusError_t rbusTable_removeRow(
     rbusHandle_t handle,
     char const* rowName); 
 
+/** @fn rbusError_t rbusTable_addRows(
+ *          busHandle handle, 
+ *          char const* tableName,
+ *          int numRows,
+ *          char const* const* aliasNames,
+ *          uint32_t* instNums)
+ *  @brief Add many new rows to a table
+ *
+ * This API does the same as calling rbusTable_addRow for each row, but sends all the rows
+ * to the provider in one request.  If the provider's rbus library doesn't support multi-row
+ * requests, the rows after the first are added one request at a time.
+ * Used by:  Any component that needs to add many table rows in another component.
+ *  @param  handle          Bus Handle
+ *  @param  tableName       The name of a table (e.g. "Device.IP.Interface.")
+ *  @param  numRows         The number of rows to add
+ *  @param  aliasNames      Optional array of numRows names for the new rows.  Each must be unique in the table.
+ *                          The array or any of its entries can be NULL.
+ *  @param  instNums        Output array of numRows where the instance numbers of the new rows are returned.
+ *                          The entry of a row which couldn't be added is set to 0.
+ *  @return RBus error code as defined by rbusError_t.
+ *  RBUS_ERROR_SUCCESS if all rows were added, otherwise the error of the first row which couldn't be added.
+ *  @ingroup Tables
+ */
+rbusError_t rbusTable_addRows(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    char const* const* aliasNames,
+    uint32_t* instNums);
+
+/** @fn rbusError_t rbusTable_removeRows(
+ *          busHandle handle, 
+ *          int numRows,
+ *          char const* const* rowNames)
+ *  @brief Remove many rows from tables
+ *
+ * This API does the same as calling rbusTable_removeRow for each row, but sends all the rows
+ * of the same table to the provider in one request.  If the provider's rbus library doesn't support
+ * multi-row requests, the rows after the first are removed one request at a time.
+ * Used by:  Any component that needs to remove many table rows in another component.
+ *  @param  handle          Bus Handle
+ *  @param  numRows         The number of rows to remove
+ *  @param  rowNames        Array of numRows table row names (e.g. "Device.IP.Interface.1")
+ *  @return RBus error code as defined by rbusError_t.
+ *  RBUS_ERROR_SUCCESS if all rows were removed, otherwise the error of the first row which couldn't be removed.
+ *  @ingroup Tables
+ */
+rbusError_t rbusTable_removeRows(
+    rbusHandle_t handle,
+    int numRows,
+    char const* const* rowNames);
+
 /** @fn rbusError_t rbusTable_getRowNames(
  *          busHandle handle, 
  *          char const* tableName,
@@ -1280,6 +1820,85 @@ rbusError_t rbusTable_unregisterRow(
     rbusHandle_t handle,
     char const* rowName);
 
+/** @fn rbusError_t rbusTable_registerRows(
+ *          busHandle handle, 
+ *          char const* tableName,
+ *          int numRows,
+ *          uint32_t const* instNums,
+ *          char const* const* aliasNames)
+ *  @brief Register many rows that the provider has added to its own table.
+ *
+ * This method does the same as calling rbusTable_registerRow for each row, but updates the
+ * element tree and matches subscriptions once for all the rows, which is much faster for
+ * large tables (e.g. syncing a host table at startup).  If publish batching is on, the
+ * row created events are sent together when the rows are registered.
+ * A row whose instance number or alias already exists in the table is skipped and the
+ * other rows are still registered.
+ * Used by:  Any provider that adds many rows to its own table at once.
+ *  @param  handle          Bus Handle
+ *  @param  tableName       The name of a table (e.g. "Device.IP.Interface.")
+ *  @param  numRows         The number of rows to register.
+ *  @param  instNums        Array of numRows unique instance numbers the provider has assigned the rows.
+ *  @param  aliasNames      Optional array of numRows names for the new rows.  Each must be unique in the table.
+ *                          The array or any of its entries can be NULL.
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, if the table doesn't exist or any row was skipped
+ *  @ingroup Tables
+ */
+rbusError_t rbusTable_registerRows(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    uint32_t const* instNums,
+    char const* const* aliasNames);
+
+/** @fn rbusError_t rbusTable_unregisterRows(
+ *          busHandle handle, 
+ *          int numRows,
+ *          char const* const* rowNames)
+ *  @brief Unregister many rows that the provider has removed from its own tables.
+ *
+ * This method does the same as calling rbusTable_unregisterRow for each row, but updates the
+ * element tree and subscriptions once for all the rows.  If publish batching is on, the
+ * row deleted events are sent together when the rows are unregistered.
+ * A row name which doesn't exist is skipped and the other rows are still unregistered.
+ * Used by:  Any provider that removes many rows from its own tables at once.
+ *  @param  handle          Bus Handle
+ *  @param  numRows         The number of rows to unregister.
+ *  @param  rowNames        Array of numRows table row names (e.g. "Device.IP.Interface.1")
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, if any row doesn't exist
+ *  @ingroup Tables
+ */
+rbusError_t rbusTable_unregisterRows(
+    rbusHandle_t handle,
+    int numRows,
+    char const* const* rowNames);
+
+/** @fn rbusError_t rbusTable_setRowsHandlers(
+ *          busHandle handle, 
+ *          char const* tableName,
+ *          rbusTableAddRowsHandler_t addRowsHandler,
+ *          rbusTableRemoveRowsHandler_t removeRowsHandler)
+ *  @brief Set a registered table's multi-row add and remove handlers.
+ *
+ * With these handlers set, the rows of a multi-row request (see rbusTable_addRows and
+ * rbusTable_removeRows) are passed to the provider in one call instead of one call per row.
+ * Used by:  Any provider that can add or remove many rows of its table at once.
+ *  @param  handle              Bus Handle
+ *  @param  tableName           The name of a registered table (e.g. "Device.IP.Interface." or "Device.IP.Interface.{i}.")
+ *  @param  addRowsHandler      The multi-row add handler, or NULL to add rows one at a time
+ *  @param  removeRowsHandler   The multi-row remove handler, or NULL to remove rows one at a time
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, if the table isn't registered
+ *  @ingroup Tables
+ */
+rbusError_t rbusTable_setRowsHandlers(
+    rbusHandle_t handle,
+    char const* tableName,
+    rbusTableAddRowsHandler_t addRowsHandler,
+    rbusTableRemoveRowsHandler_t removeRowsHandler);
+
 /** @} */
 
 /** @addtogroup Consumers
@@ -1495,6 +2114,93 @@ rbusError_t  rbusEvent_Publish(
     rbusHandle_t handle,
     rbusEvent_t* eventData);
 
+/** @fn rbusError_t  rbusEvent_NotifyValueChanged (
+ *          rbusHandle_t handle,
+ *          char const* propertyName)
+ *  @brief Tell rbus that a property's value may have changed.
+ *
+ *  If the property has value-change subscribers, rbus gets its value right
+ *  away and publishes a value-change event if it differs from the last value,
+ *  instead of waiting for the next time the property is polled.
+ *
+ *  Used by: Components that provide properties
+ *  @param      handle          Bus Handle
+ *  @param      propertyName    The full name of the property (e.g. Device.Table.1.Prop)
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, RBUS_ERROR_ELEMENT_DOES_NOT_EXIST
+ *  @ingroup Events
+ */
+rbusError_t  rbusEvent_NotifyValueChanged(
+    rbusHandle_t handle,
+    char const* propertyName);
+
+/** @fn rbusError_t  rbusEvent_SetValueChangePolling (
+ *          rbusHandle_t handle,
+ *          char const* propertyName,
+ *          bool enable)
+ *  @brief Turn value-change polling of a property on or off.
+ *
+ *  By default, rbus detects value-changes by polling the property's get handler.
+ *  A provider which calls rbusEvent_NotifyValueChanged each time the value
+ *  changes can turn polling off.  Setting this on a table's property template
+ *  (e.g. Device.Table.{i}.Prop) applies to the rows added after.
+ *
+ *  Used by: Components that provide properties
+ *  @param      handle          Bus Handle
+ *  @param      propertyName    The name of the property
+ *  @param      enable          false to only detect changes on rbusEvent_NotifyValueChanged
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_INVALID_INPUT, RBUS_ERROR_ELEMENT_DOES_NOT_EXIST
+ *  @ingroup Events
+ */
+rbusError_t  rbusEvent_SetValueChangePolling(
+    rbusHandle_t handle,
+    char const* propertyName,
+    bool enable);
+
+/** @fn rbusError_t  rbusEvent_SetPublishBatching (
+ *          rbusHandle_t handle,
+ *          uint32_t flushInterval,
+ *          uint32_t maxBatchSize,
+ *          bool coalesce)
+ *  @brief Turn batching of published events on or off.
+ *
+ *  With batching on, events published to the same subscriber are queued
+ *  and sent together in one message, either once the first of them has
+ *  waited flushInterval milliseconds or once maxBatchSize of them are queued.
+ *  Subscribers still get one handler call per event, in order.
+ *  Subscribers must use an rbus version which understands batches. \n
+ *  Used by: Components that provide events
+ *  @param      handle          Bus Handle
+ *  @param      flushInterval   Max milliseconds an event is queued, or 0 to turn
+ *                              batching off after sending anything queued
+ *  @param      maxBatchSize    Max events queued per subscriber, or 0 for no limit
+ *  @param      coalesce        If true, a value-change of a property replaces a
+ *                              queued value-change of the same property to the
+ *                              same subscriber, keeping the queued oldValue.
+ *                              Subscriptions with a filter are never coalesced.
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_SUCCESS, RBUS_ERROR_INVALID_INPUT
+ *  @ingroup Events
+ */
+rbusError_t  rbusEvent_SetPublishBatching(
+    rbusHandle_t handle,
+    uint32_t flushInterval,
+    uint32_t maxBatchSize,
+    bool coalesce);
+
+/** @fn rbusError_t  rbusEvent_FlushPublishBatch (
+ *          rbusHandle_t handle)
+ *  @brief Send all events queued by publish batching right away.
+ *  Used by: Components that provide events
+ *  @param      handle          Bus Handle
+ *  @return RBus error code as defined by rbusError_t.
+ *  Possible values are: RBUS_ERROR_SUCCESS, RBUS_ERROR_INVALID_INPUT
+ *  @ingroup Events
+ */
+rbusError_t  rbusEvent_FlushPublishBatch(
+    rbusHandle_t handle);
+
 /** @} */
 
 /** @addtogroup Consumers
@@ -23,17 +23,22 @@
 #include <assert.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <limits.h>
 #include <rtVector.h>
 #include <rtMemory.h>
 #include <rbus_core.h>
 #include <rbus_session_mgr.h>
 #include <rbus.h>
 #include "rbus_buffer.h"
+#include "rbus_pool.h"
 #include "rbus_element.h"
 #include "rbus_valuechange.h"
+#include "rbus_intervalsub.h"
 #include "rbus_subscriptions.h"
 #include "rbus_asyncsubscribe.h"
+#include "rbus_asyncrequest.h"
 #include "rbus_config.h"
+#include "rbus_ownercache.h"
 #include "rbus_log.h"
 #include "rbus_handle.h"
 
@@ -100,6 +105,13 @@ typedef enum _rbus_legacy_returns {
 //******************************* GLOBALS *****************************************//
 static pthread_mutex_t gMutex = PTHREAD_MUTEX_INITIALIZER;
 
+/* whether _client_disconnect_callback_handler is registered, guarded by gDisConnMutex */
+static pthread_mutex_t gDisConnMutex = PTHREAD_MUTEX_INITIALIZER;
+static bool gDisConnHandler = false;
+
+/* the last componentId given to a handle or its value cache, guarded by gMutex */
+static int32_t gLastComponentId = 0;
+
 //********************************************************************************//
 
 //******************************* INTERNAL FUNCTIONS *****************************//
@@ -219,17 +231,21 @@ void rbusEventSubscription_free(void* p)
     free(sub);
 }
 
-static rbusEventSubscription_t* rbusEventSubscription_find(rtVector eventSubs, char const* eventName, rbusFilter_t filter)
+static rbusEventSubscription_t* rbusEventSubscription_find(struct _rbusHandle* handleInfo, char const* eventName, rbusFilter_t filter)
 {
-    /*FIXME - convert to map */
-    size_t i;
-    for(i=0; i < rtVector_Size(eventSubs); ++i)
-    {
-        rbusEventSubscription_t* sub = (rbusEventSubscription_t*)rtVector_At(eventSubs, i);
-        if(sub && !strcmp(sub->eventName, eventName) && !rbusFilter_Compare(sub->filter, filter))
-            return sub;
-    }
-    return NULL;
+    return rbusEventSubIndex_Find(handleInfo->eventSubIndex, eventName, filter);
+}
+
+static void rbusEventSubscription_add(struct _rbusHandle* handleInfo, rbusEventSubscription_t* sub)
+{
+    rtVector_PushBack(handleInfo->eventSubs, sub);
+    rbusEventSubIndex_Add(handleInfo->eventSubIndex, sub);
+}
+
+static void rbusEventSubscription_remove(struct _rbusHandle* handleInfo, rbusEventSubscription_t* sub)
+{
+    rbusEventSubIndex_Remove(handleInfo->eventSubIndex, sub);
+    rtVector_RemoveItem(handleInfo->eventSubs, sub, rbusEventSubscription_free);
 }
 
 static bool _parse_rbusData_to_value (char const* pBuff, rbusLegacyDataType_t legacyType, rbusValue_t value)
@@ -319,6 +335,17 @@ void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int3
 void rbusFilter_AppendToMessage(rbusFilter_t filter, rbusMessage msg);
 void rbusFilter_InitFromMessage(rbusFilter_t* filter, rbusMessage msg);
 
+/* Received messages own the strings and bytes that values decoded from them reference */
+static void rbusMessage_retainOwner(void* msg)
+{
+    rbusMessage_Retain((rbusMessage)msg);
+}
+
+static void rbusMessage_releaseOwner(void* msg)
+{
+    rbusMessage_Release((rbusMessage)msg);
+}
+
 rbusError_t rbusValue_initFromMessage(rbusValue_t* value, rbusMessage msg)
 {
     uint8_t const* data;
@@ -327,12 +354,28 @@ rbusError_t rbusValue_initFromMessage(rbusValue_t* value, rbusMessage msg)
     int type;
     char const* pBuffer = NULL;
 
-    rbusValue_Init(value);
-
     rbusMessage_GetInt32(msg, (int*) &type);
 #if DEBUG_SERIALIZER
     RBUSLOG_INFO("> value pop type=%d", type);
 #endif
+
+    if(type == RBUS_STRING || type == RBUS_BYTES)
+    {
+        rbusBufferOwner_t owner = { msg, rbusMessage_retainOwner, rbusMessage_releaseOwner };
+
+        data = NULL;
+        length = 0;
+        rbusMessage_GetBytes(msg, &data, &length);
+        *value = rbusValue_InitView(type, data, length, &owner);
+        if(!*value)
+        {
+            rbusValue_Init(value);
+            rbusValue_SetTLV(*value, type, length, data);
+        }
+        return RBUS_ERROR_SUCCESS;
+    }
+
+    rbusValue_Init(value);
     if(type>=RBUS_LEGACY_STRING && type<=RBUS_LEGACY_NONE)
     {
         rbusMessage_GetString(msg, &pBuffer);
@@ -566,6 +609,79 @@ void rbusObject_initFromMessage(rbusObject_t* obj, rbusMessage msg)
     rbusObject_Release(children);
 }
 
+/* Get requests from consumers that can parse rbusBuffer encoded property lists end with
+   RBUS_GET_WIRE_VERSION.  Providers then reply with RBUS_PROPERTY_LIST_BLOB in place of
+   the property count, followed by a single bytes field holding the encoded list. */
+#define RBUS_GET_WIRE_VERSION       1
+#define RBUS_PROPERTY_LIST_BLOB     (-1)
+
+/* Paged get requests (see rbus_getPage) send RBUS_GET_PAGED_WIRE_VERSION followed by the cursor and
+   page size.  Providers answer the wildcard query with that page and end the response with the
+   cursor of the next page, 0 for the last.  A response without it is the complete result. */
+#define RBUS_GET_PAGED_WIRE_VERSION 2
+#define RBUS_GET_CURSOR_DEST_SHIFT  24
+#define RBUS_GET_CURSOR_OFFSET_MASK ((1u << RBUS_GET_CURSOR_DEST_SHIFT) - 1)
+#define RBUS_GET_CURSOR_MAX_DESTS   (1u << (32 - RBUS_GET_CURSOR_DEST_SHIFT))
+
+/* Appends the marker and blob for either an array of count properties or a list of count properties.
+   Returns false, having written nothing, if any value can't be encoded with rbusBuffer TLVs */
+static bool rbusPropertyList_appendBlobToMessage(rbusProperty_t* array, rbusProperty_t list, int count, rbusMessage msg)
+{
+    rbusBuffer_t buff;
+    int i;
+
+    rbusBuffer_Create(&buff);
+    rbusBuffer_WriteInt32TLV(buff, count);
+    for(i = 0; i < count; i++)
+    {
+        rbusProperty_t prop = array ? array[i] : list;
+        if(rbusProperty_Encode(prop, buff) < 0)
+        {
+            rbusBuffer_Destroy(buff);
+            return false;
+        }
+        if(!array)
+            list = rbusProperty_GetNext(list);
+    }
+    rbusMessage_SetInt32(msg, RBUS_PROPERTY_LIST_BLOB);
+    rbusMessage_SetBytes(msg, buff->data, buff->posWrite);
+#if DEBUG_SERIALIZER
+    RBUSLOG_INFO("> prop blob add numProps=%d bytes=%d", count, buff->posWrite);
+#endif
+    rbusBuffer_Destroy(buff);
+    return true;
+}
+
+static rbusError_t rbusPropertyList_initFromBlobMessage(rbusProperty_t* prop, int* numProps, rbusMessage msg)
+{
+    struct _rbusBuffer buff;
+    rbusBufferOwner_t owner = { msg, rbusMessage_retainOwner, rbusMessage_releaseOwner };
+    uint8_t const* data = NULL;
+    uint32_t length = 0;
+
+    *prop = NULL;
+    *numProps = 0;
+    if(rbusMessage_GetBytes(msg, &data, &length) != RT_OK || !data)
+        return RBUS_ERROR_BUS_ERROR;
+
+    /*decode straight out of the message instead of copying into a new buffer*/
+    memset(&buff, 0, sizeof(buff));
+    buff.data = (uint8_t*)data;
+    buff.lenAlloc = buff.posWrite = (int)length;
+    buff.owner = &owner;
+
+    if(rbusPropertyList_Decode(prop, &buff) < 0)
+    {
+        RBUSLOG_ERROR("failed to decode property list blob of %u bytes", length);
+        return RBUS_ERROR_BUS_ERROR;
+    }
+    *numProps = (int)rbusProperty_Count(*prop);
+#if DEBUG_SERIALIZER
+    RBUSLOG_INFO("> prop blob pop numProps=%d bytes=%u", *numProps, length);
+#endif
+    return RBUS_ERROR_SUCCESS;
+}
+
 void rbusValue_appendToMessage(char const* name, rbusValue_t value, rbusMessage msg)
 {
     rbusValueType_t type = RBUS_NONE;
@@ -707,6 +823,7 @@ void rbusEventData_updateFromMessage(rbusEvent_t* event, rbusFilter_t* filter, i
     RBUSLOG_INFO("> event pop name=%s type=%d", name, type);
 #endif
 
+    /*not carved from an arena: the subscriber's handler gets this tree and may keep any part of it*/
     rbusObject_initFromMessage(&data, msg);
 
     rbusMessage_GetInt32(msg, &hasFilter);
@@ -722,7 +839,8 @@ void rbusEventData_updateFromMessage(rbusEvent_t* event, rbusFilter_t* filter, i
     rbusMessage_GetInt32(msg, componentId);
 }
 
-void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int32_t componentId, rbusMessage msg)
+/*an event message is a body, which is the same for every subscriber, followed by a trailer specific to the subscriber*/
+static void rbusEventData_appendBodyToMessage(rbusEvent_t* event, rbusMessage msg)
 {
     rbusMessage_SetString(msg, event->name);
     rbusMessage_SetInt32(msg, event->type);
@@ -730,6 +848,10 @@ void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int3
     RBUSLOG_INFO("> event add name=%s type=%d", event->name, event->type);
 #endif
     rbusObject_appendToMessage(event->data, msg);
+}
+
+static void rbusEventData_appendTrailerToMessage(rbusFilter_t filter, int32_t componentId, rbusMessage msg)
+{
     if(filter)
     {
         rbusMessage_SetInt32(msg, 1);
@@ -742,6 +864,36 @@ void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int3
     rbusMessage_SetInt32(msg, componentId);
 }
 
+void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int32_t componentId, rbusMessage msg)
+{
+    rbusEventData_appendBodyToMessage(event, msg);
+    rbusEventData_appendTrailerToMessage(filter, componentId, msg);
+}
+
+/*serialize a message part once so it can be copied into many messages*/
+static void rbusEventData_encode(rbusEvent_t* event, rbusFilter_t filter, int32_t componentId, uint8_t** bytes, uint32_t* length)
+{
+    rbusMessage msg;
+    uint8_t* data = NULL;
+
+    rbusMessage_Init(&msg);
+    if(event)
+        rbusEventData_appendBodyToMessage(event, msg);
+    else
+        rbusEventData_appendTrailerToMessage(filter, componentId, msg);
+    rbusMessage_ToBytes(msg, &data, length);
+    *bytes = rt_malloc(*length);
+    memcpy(*bytes, data, *length);
+    rbusMessage_Release(msg);
+}
+
+/*cache the trailer of a new subscription so publishing doesn't serialize its filter for every event*/
+static void rbusSubscription_encodeTrailer(rbusSubscription_t* sub)
+{
+    if(!sub->trailer)
+        rbusEventData_encode(NULL, sub->filter, sub->componentId, &sub->trailer, &sub->trailerLength);
+}
+
 bool _is_valid_get_query(char const* name)
 {
     /* 1. Find whether the query ends with `!` to find out Event is being queried */
@@ -859,7 +1011,7 @@ void valueChangeTableRowUpdate(rbusHandle_t handle, elementNode* rowNode, bool a
     }
 }
 
-int subscribeHandlerImpl(
+static int subscribeHandlerLocked(
     rbusHandle_t handle,
     bool added,
     elementNode* el,
@@ -868,7 +1020,8 @@ int subscribeHandlerImpl(
     int32_t componentId,
     int32_t interval,
     int32_t duration,
-    rbusFilter_t filter)
+    rbusFilter_t filter,
+    int32_t version)
 {
     rbusSubscription_t* subscription = NULL;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
@@ -898,12 +1051,14 @@ int subscribeHandlerImpl(
 
     if(added)
     {
-        subscription = rbusSubscriptions_addSubscription(handleInfo->subscriptions, listener, eventName, componentId, filter, interval, duration, autoPublish, el);
+        subscription = rbusSubscriptions_addSubscription(handleInfo->subscriptions, listener, eventName, componentId, filter, interval, duration, autoPublish, version, el);
 
         if(!subscription)
         {
             return RTMESSAGE_BUS_ERROR_INVALID_STATE; /*unexpected*/
         }
+
+        rbusSubscription_encodeTrailer(subscription);
     }
     else
     {
@@ -917,8 +1072,10 @@ int subscribeHandlerImpl(
     }
 
     /* if autoPublish and its a property being subscribed to
-       then update rbusValueChange to handle the property */
-    if(el->type == RBUS_ELEMENT_TYPE_PROPERTY && subscription->autoPublish)
+       then update rbusValueChange to handle the property,
+       unless its an interval subscription without a filter which gets sampled instead */
+    if(el->type == RBUS_ELEMENT_TYPE_PROPERTY && subscription->autoPublish &&
+       !(subscription->interval > 0 && !subscription->filter))
     {
         rtListItem item;
         rtList_GetFront(subscription->instances, &item);
@@ -944,11 +1101,24 @@ int subscribeHandlerImpl(
                     rbusValueChange_RemovePropertyNode(handle, node);
                 }
             }
+            else
+            {
+                /* the polling period follows the smallest interval of the remaining subscribers */
+                rbusValueChange_SetPropertyNodeInterval(handle, node,
+                    elementGetAutoPubInterval(node, added ? NULL : subscription));
+            }
 
             rtListItem_GetNext(item, &item);
         }
     }
 
+    /* sampling of interval subscriptions and expiring subscriptions with a duration.
+       removeSubscription below stops timing it */
+    if(added && (subscription->interval > 0 || subscription->duration > 0))
+    {
+        rbusIntervalSub_AddSubscription(handle, subscription);
+    }
+
     /*remove subscription only after handling its ValueChange properties above*/
     if(!added)
     {
@@ -957,61 +1127,124 @@ int subscribeHandlerImpl(
     return RTMESSAGE_BUS_SUCCESS;
 }
 
-static void registerTableRow (rbusHandle_t handle, elementNode* tableInstElem, char const* tableName, char const* aliasName, uint32_t instNum)
+/*  called by the subscribe request handler, the interval thread when a duration ends and when a listener
+    disconnects, so the registry stays locked from looking the subscription up until it's added or removed */
+int subscribeHandlerImpl(
+    rbusHandle_t handle,
+    bool added,
+    elementNode* el,
+    char const* eventName,
+    char const* listener,
+    int32_t componentId,
+    int32_t interval,
+    int32_t duration,
+    rbusFilter_t filter,
+    int32_t version)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
-    elementNode* rowElem;
+    int rc;
 
-    RBUSLOG_DEBUG("%s table [%s] alias [%s] instNum [%u]", __FUNCTION__, tableName, aliasName, instNum);
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+    rc = subscribeHandlerLocked(handle, added, el, eventName, listener, componentId, interval, duration, filter, version);
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+    return rc;
+}
 
-    rowElem = instantiateTableRow(tableInstElem, instNum, aliasName);
+/*send OBJECT_CREATED event after we create the row*/
+static void publishRowCreated(rbusHandle_t handle, char const* tableName, elementNode* rowElem, uint32_t instNum, char const* aliasName)
+{
+    rbusEvent_t event = {0};
+    rbusError_t respub;
+    rbusObject_t data;
+    rbusValue_t instNumVal;
+    rbusValue_t aliasVal;
+    rbusValue_t rowNameVal;
 
-    rbusSubscriptions_onTableRowAdded(handleInfo->subscriptions, rowElem);
+    rbusValue_Init(&rowNameVal);
+    rbusValue_Init(&instNumVal);
+    rbusValue_Init(&aliasVal);
 
-    /*update ValueChange after rbusSubscriptions_onTableRowAdded */
-    valueChangeTableRowUpdate(handle, rowElem, true);
+    rbusValue_SetString(rowNameVal, rowElem->fullName);
+    rbusValue_SetUInt32(instNumVal, instNum);
+    rbusValue_SetString(aliasVal, aliasName ? aliasName : "");
+
+    rbusObject_Init(&data, NULL);
+    rbusObject_SetValue(data, "rowName", rowNameVal);
+    rbusObject_SetValue(data, "instNum", instNumVal);
+    rbusObject_SetValue(data, "alias", aliasVal);
 
-    /*send OBJECT_CREATED event after we create the row*/
+    event.name = tableName;
+    event.type = RBUS_EVENT_OBJECT_CREATED;
+    event.data = data;
+
+    RBUSLOG_INFO("%s publishing ObjectCreated table=%s rowName=%s", __FUNCTION__, tableName, rowElem->fullName);
+    respub = rbusEvent_Publish(handle, &event);
+
+    if(respub != RBUS_ERROR_SUCCESS && respub != RBUS_ERROR_NOSUBSCRIBERS)
     {
-        rbusEvent_t event = {0};
-        rbusError_t respub;
-        rbusObject_t data;
-        rbusValue_t instNumVal;
-        rbusValue_t aliasVal;
-        rbusValue_t rowNameVal;
+        RBUSLOG_WARN("failed to publish ObjectCreated event err:%d", respub);
+    }
+
+    rbusValue_Release(rowNameVal);
+    rbusValue_Release(instNumVal);
+    rbusValue_Release(aliasVal);
+    rbusObject_Release(data);
+}
 
-        rbusValue_Init(&rowNameVal);
-        rbusValue_Init(&instNumVal);
-        rbusValue_Init(&aliasVal);
+/*send OBJECT_DELETED event after we delete the row*/
+static void publishRowDeleted(rbusHandle_t handle, char const* tableFullName, char const* rowInstName)
+{
+    rbusEvent_t event = {0};
+    rbusError_t respub;
+    rbusValue_t rowNameVal;
+    rbusObject_t data;
+    char tableName[RBUS_MAX_NAME_LENGTH];
 
-        rbusValue_SetString(rowNameVal, rowElem->fullName);
-        rbusValue_SetUInt32(instNumVal, instNum);
-        rbusValue_SetString(aliasVal, aliasName ? aliasName : "");
+    /*must end the table name with a dot(.)*/
+    snprintf(tableName, RBUS_MAX_NAME_LENGTH, "%s.", tableFullName);
 
-        rbusObject_Init(&data, NULL);
-        rbusObject_SetValue(data, "rowName", rowNameVal);
-        rbusObject_SetValue(data, "instNum", instNumVal);
-        rbusObject_SetValue(data, "alias", aliasVal);
+    rbusValue_Init(&rowNameVal);
+    rbusValue_SetString(rowNameVal, rowInstName);
 
-        event.name = tableName;
-        event.type = RBUS_EVENT_OBJECT_CREATED;
-        event.data = data;
+    rbusObject_Init(&data, NULL);
+    rbusObject_SetValue(data, "rowName", rowNameVal);
 
-        RBUSLOG_INFO("%s publishing ObjectCreated table=%s rowName=%s", __FUNCTION__, tableName, rowElem->fullName);
-        respub = rbusEvent_Publish(handle, &event);
+    event.name = tableName;
+    event.data = data;
+    event.type = RBUS_EVENT_OBJECT_DELETED;
+    RBUSLOG_INFO("%s publishing ObjectDeleted table=%s rowName=%s", __FUNCTION__, tableFullName, rowInstName);
+    respub = rbusEvent_Publish(handle, &event);
 
-        if(respub != RBUS_ERROR_SUCCESS && respub != RBUS_ERROR_NOSUBSCRIBERS)
-        {
-            RBUSLOG_WARN("failed to publish ObjectCreated event err:%d", respub);
-        }
+    rbusValue_Release(rowNameVal);
+    rbusObject_Release(data);
 
-        rbusValue_Release(rowNameVal);
-        rbusValue_Release(instNumVal);
-        rbusValue_Release(aliasVal);
-        rbusObject_Release(data);
+    if(respub != RBUS_ERROR_SUCCESS && respub != RBUS_ERROR_NOSUBSCRIBERS)
+    {
+        RBUSLOG_WARN("failed to publish ObjectDeleted event err:%d", respub);
     }
 }
 
+static void registerTableRow (rbusHandle_t handle, elementNode* tableInstElem, char const* tableName, char const* aliasName, uint32_t instNum)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* rowElem;
+
+    RBUSLOG_DEBUG("%s table [%s] alias [%s] instNum [%u]", __FUNCTION__, tableName, aliasName, instNum);
+
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+
+    rowElem = instantiateTableRow(tableInstElem, instNum, aliasName);
+
+    rbusSubscriptions_onTableRowAdded(handleInfo->subscriptions, rowElem);
+
+    /*update ValueChange after rbusSubscriptions_onTableRowAdded */
+    valueChangeTableRowUpdate(handle, rowElem, true);
+
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+    publishRowCreated(handle, tableName, rowElem, instNum, aliasName);
+}
+
 static void unregisterTableRow (rbusHandle_t handle, elementNode* rowInstElem)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
@@ -1020,6 +1253,8 @@ static void unregisterTableRow (rbusHandle_t handle, elementNode* rowInstElem)
 
     RBUSLOG_DEBUG("%s [%s]", __FUNCTION__, rowInstElem->fullName);
 
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+
     /*update ValueChange before rbusSubscriptions_onTableRowRemoved */
     valueChangeTableRowUpdate(handle, rowInstElem, false);
 
@@ -1027,38 +1262,157 @@ static void unregisterTableRow (rbusHandle_t handle, elementNode* rowInstElem)
 
     deleteTableRow(rowInstElem);
 
-    /*send OBJECT_DELETED event after we delete the row*/
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+    publishRowDeleted(handle, tableInstElem->fullName, rowInstName);
+    free(rowInstName);
+}
+
+/*  register rows of one table with one pass over the element tree and one pass over the subscriptions.
+    rows[] is filled with the rows created, or NULL for any skipped because they already exist.
+    the row events are flushed together if the provider has publish batching on */
+static int registerTableRows (rbusHandle_t handle, elementNode* tableInstElem, char const* tableName, int numRows, uint32_t const* instNums, char const* const* aliasNames, elementNode** rows)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    int count;
+    int i;
+
+    RBUSLOG_DEBUG("%s table [%s] numRows [%d]", __FUNCTION__, tableName, numRows);
+
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+
+    count = instantiateTableRows(tableInstElem, numRows, instNums, aliasNames, rows);
+
+    rbusSubscriptions_onTableRowsAdded(handleInfo->subscriptions, rows, numRows);
+
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i])
+            valueChangeTableRowUpdate(handle, rows[i], true);
+    }
+
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i])
+            publishRowCreated(handle, tableName, rows[i], instNums[i], aliasNames ? aliasNames[i] : NULL);
+    }
+
+    if(handleInfo->eventBatch)
+        rbusEventBatch_Flush(handleInfo->eventBatch);
+
+    return count;
+}
+
+typedef struct _rowRef
+{
+    elementNode* row;
+    int index;
+} rowRef;
+
+/*by row then by position in the caller's list*/
+static int compareRowRefs(const void* a, const void* b)
+{
+    rowRef const* refA = (rowRef const*)a;
+    rowRef const* refB = (rowRef const*)b;
+    if(refA->row != refB->row)
+        return refA->row < refB->row ? -1 : 1;
+    return refA->index - refB->index;
+}
+
+static int compareRowRefRows(const void* a, const void* b)
+{
+    rowRef const* refA = (rowRef const*)a;
+    rowRef const* refB = (rowRef const*)b;
+    if(refA->row != refB->row)
+        return refA->row < refB->row ? -1 : 1;
+    return 0;
+}
+
+/*  unregister rows, possibly of different tables, with one pass over the element tree and one pass
+    over the subscriptions.  rows[] entries repeated or under another row in rows[] are set to NULL */
+static void unregisterTableRows (rbusHandle_t handle, elementNode** rows, int numRows)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    rowRef* sorted;
+    char** rowInstNames;
+    char** tableNames;
+    int i;
+
+    RBUSLOG_DEBUG("%s numRows [%d]", __FUNCTION__, numRows);
+
+    /*a row listed twice or under another row being removed would be freed twice*/
+    sorted = rt_malloc(numRows * sizeof(rowRef));
+    for(i = 0; i < numRows; ++i)
+    {
+        sorted[i].row = rows[i];
+        sorted[i].index = i;
+    }
+    qsort(sorted, numRows, sizeof(rowRef), compareRowRefs);
+
+    for(i = 1; i < numRows; ++i)
     {
-        rbusEvent_t event = {0};
-        rbusError_t respub;
-        rbusValue_t rowNameVal;
-        rbusObject_t data;
-        char tableName[RBUS_MAX_NAME_LENGTH];
+        if(sorted[i].row == sorted[i-1].row)
+            rows[sorted[i].index] = NULL;
+    }
+
+    for(i = 0; i < numRows; ++i)
+    {
+        rowRef key;
+
+        if(!rows[i])
+            continue;
+
+        for(key.row = rows[i]->parent; key.row; key.row = key.row->parent)
+        {
+            if(bsearch(&key, sorted, numRows, sizeof(rowRef), compareRowRefRows))
+            {
+                rows[i] = NULL;
+                break;
+            }
+        }
+    }
+    free(sorted);
+
+    rowInstNames = rt_calloc(numRows, sizeof(char*));
+    tableNames = rt_calloc(numRows, sizeof(char*));
 
-        /*must end the table name with a dot(.)*/
-        snprintf(tableName, RBUS_MAX_NAME_LENGTH, "%s.", tableInstElem->fullName);
+    rbusSubscriptions_lock(handleInfo->subscriptions);
 
-        rbusValue_Init(&rowNameVal);
-        rbusValue_SetString(rowNameVal, rowInstName);
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i])
+        {
+            /*must dup because we are deleting the instances*/
+            rowInstNames[i] = strdup(rows[i]->fullName);
+            tableNames[i] = strdup(rows[i]->parent->fullName);
+
+            /*update ValueChange before rbusSubscriptions_onTableRowsRemoved */
+            valueChangeTableRowUpdate(handle, rows[i], false);
+        }
+    }
 
-        rbusObject_Init(&data, NULL);
-        rbusObject_SetValue(data, "rowName", rowNameVal);
+    rbusSubscriptions_onTableRowsRemoved(handleInfo->subscriptions, rows, numRows);
 
-        event.name = tableName;
-        event.data = data;
-        event.type = RBUS_EVENT_OBJECT_DELETED;
-        RBUSLOG_INFO("%s publishing ObjectDeleted table=%s rowName=%s", __FUNCTION__, tableInstElem->fullName, rowInstName);
-        respub = rbusEvent_Publish(handle, &event);
+    deleteTableRows(rows, numRows);
 
-        rbusValue_Release(rowNameVal);
-        rbusObject_Release(data);
-        free(rowInstName);
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
 
-        if(respub != RBUS_ERROR_SUCCESS && respub != RBUS_ERROR_NOSUBSCRIBERS)
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rowInstNames[i])
         {
-            RBUSLOG_WARN("failed to publish ObjectDeleted event err:%d", respub);
+            publishRowDeleted(handle, tableNames[i], rowInstNames[i]);
+            free(rowInstNames[i]);
+            free(tableNames[i]);
         }
     }
+    free(rowInstNames);
+    free(tableNames);
+
+    if(handleInfo->eventBatch)
+        rbusEventBatch_Flush(handleInfo->eventBatch);
 }
 //******************************* CALLBACKS *************************************//
 static int _event_subscribe_callback_handler(char const* object,  char const* eventName, char const* listener, int added, const rbusMessage payload, void* userData)
@@ -1078,6 +1432,7 @@ static int _event_subscribe_callback_handler(char const* object,  char const* ev
         int32_t componentId = 0;
         int32_t interval = 0;
         int32_t duration = 0;
+        int32_t version = 0;
         rbusFilter_t filter = NULL;
 
         /* copy the optional filter */
@@ -1092,6 +1447,9 @@ static int _event_subscribe_callback_handler(char const* object,  char const* ev
             {
                 rbusFilter_InitFromMessage(&filter, payload);
             }
+            /*older subscribers end the payload here*/
+            if(rbusMessage_GetInt32(payload, &version) != RT_OK)
+                version = 0;
         }
         else
         {
@@ -1100,7 +1458,7 @@ static int _event_subscribe_callback_handler(char const* object,  char const* ev
 
         RBUSLOG_DEBUG("%s: found element of type %d", __FUNCTION__, el->type);
 
-        err = subscribeHandlerImpl(handle, added, el, eventName, listener, componentId, interval, duration, filter);
+        err = subscribeHandlerImpl(handle, added, el, eventName, listener, componentId, interval, duration, filter, version);
 
         if(filter)
         {
@@ -1117,11 +1475,34 @@ static int _event_subscribe_callback_handler(char const* object,  char const* ev
 
 static void _client_disconnect_callback_handler(const char * listener)
 {
+    /*the advisory names the client's listener, not its component, so forget every owner*/
+    rbusOwnerCache_Clear();
+
     LockMutex();
     rbusHandleList_ClientDisconnect(listener);
     UnlockMutex();
 }
 
+/*register for client disconnect advisories, once per broker connection.
+  providers need them to clean up subscriptions and consumers to drop cached owners*/
+static void _register_client_disconnect_handler()
+{
+    rbus_error_t err;
+
+    pthread_mutex_lock(&gDisConnMutex);
+    if(!gDisConnHandler)
+    {
+        err = rbus_registerClientDisconnectHandler(_client_disconnect_callback_handler);
+        if(err != RTMESSAGE_BUS_SUCCESS)
+        {
+            RBUSLOG_ERROR("%s : rbus_registerClientDisconnectHandler error %d", __FUNCTION__, err);
+        }
+        else
+            gDisConnHandler = true;
+    }
+    pthread_mutex_unlock(&gDisConnMutex);
+}
+
 void _subscribe_async_callback_handler(rbusHandle_t handle, rbusEventSubscription_t* subscription, rbusError_t error)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
@@ -1130,7 +1511,7 @@ void _subscribe_async_callback_handler(rbusHandle_t handle, rbusEventSubscriptio
 
     if(error == RBUS_ERROR_SUCCESS)
     {
-        rtVector_PushBack(handleInfo->eventSubs, subscription);
+        rbusEventSubscription_add(handleInfo, subscription);
     }
     else
     {
@@ -1138,6 +1519,8 @@ void _subscribe_async_callback_handler(rbusHandle_t handle, rbusEventSubscriptio
     }
 }
 
+static int _event_batch_callback_handler(char const* sender, rbusMessage message);
+
 int _event_callback_handler (char const* objectName, char const* eventName, rbusMessage message, void* userData)
 {
     rbusEventSubscription_t* subscription = NULL;
@@ -1149,6 +1532,12 @@ int _event_callback_handler (char const* objectName, char const* eventName, rbus
     RBUSLOG_DEBUG("Received event callback: objectName=%s eventName=%s", 
         objectName, eventName);
 
+    /*a batch can hold events of other subscriptions too*/
+    if(eventName && strcmp(eventName, RBUS_EVENT_BATCH_NAME) == 0)
+    {
+        return _event_batch_callback_handler(objectName, message);
+    }
+
     subscription = (rbusEventSubscription_t*)userData;
 
     if(!subscription || !subscription->handle || !subscription->handler)
@@ -1176,6 +1565,11 @@ static int _master_event_callback_handler(char const* sender, char const* eventN
     struct _rbusHandle* handleInfo = NULL;
     UNUSED1(userData);
 
+    if(eventName && strcmp(eventName, RBUS_EVENT_BATCH_NAME) == 0)
+    {
+        return _event_batch_callback_handler(sender, message);
+    }
+
     rbusEventData_updateFromMessage(&event, &filter, &componentId, message);
 
     LockMutex();
@@ -1190,7 +1584,15 @@ static int _master_event_callback_handler(char const* sender, char const* eventN
 
     RBUSLOG_DEBUG("Received master event callback: sender=%s eventName=%s componentId=%d", sender, eventName, componentId);
 
-    subscription = rbusEventSubscription_find(handleInfo->eventSubs, eventName, filter);
+    if(componentId == handleInfo->valueCacheComponentId && handleInfo->valueCache)
+    {
+        rbusValueCache_Update(handleInfo->valueCache, &event);
+        rbusObject_Release(event.data);
+        rbusFilter_Release(filter);
+        return RTMESSAGE_BUS_SUCCESS;
+    }
+
+    subscription = rbusEventSubscription_find(handleInfo, eventName, filter);
 
     if(subscription)
     {
@@ -1208,6 +1610,49 @@ static int _master_event_callback_handler(char const* sender, char const* eventN
     return RTMESSAGE_BUS_SUCCESS;
 }
 
+/*unpack a batch of events published by a provider with batching on (see rbus_eventbatch.c)
+  and handle each as if it came on its own*/
+static int _event_batch_callback_handler(char const* sender, rbusMessage message)
+{
+    int32_t count = 0;
+    int32_t i;
+
+    rbusMessage_GetInt32(message, &count);
+
+    RBUSLOG_DEBUG("Received event batch: sender=%s count=%d", sender, count);
+
+    for(i = 0; i < count; ++i)
+    {
+        char const* eventName = NULL;
+        rbusMessage eventMsg = NULL;
+
+        if(rbusMessage_GetString(message, &eventName) != RT_OK ||
+           rbusMessage_GetMessage(message, &eventMsg) != RT_OK)
+        {
+            RBUSLOG_WARN("Received bad event batch: sender=%s event %d of %d", sender, i, count);
+            return RTMESSAGE_BUS_ERROR_GENERAL;
+        }
+
+        _master_event_callback_handler(sender, eventName, eventMsg, NULL);
+
+        rbusMessage_Release(eventMsg);
+    }
+
+    return RTMESSAGE_BUS_SUCCESS;
+}
+
+static elementNode* _set_multi_handler_owner(elementNode* el)
+{
+    elementNode* node = getRegistrationElement(el);
+    while(node)
+    {
+        if(node->setMultiHandler)
+            return node;
+        node = node->parent;
+    }
+    return NULL;
+}
+
 static void _set_callback_handler (rbusHandle_t handle, rbusMessage request, rbusMessage *response)
 {
     rbusError_t rc = 0;
@@ -1219,6 +1664,9 @@ static void _set_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
     bool isCommit = false;
     char const* pFailedElement = NULL;
     rbusProperty_t* pProperties = NULL;
+    elementNode** pNodes = NULL;
+    elementNode** pOwners = NULL;
+    int lastSingle = -1;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
     rbusSetHandlerOptions_t opts;
 
@@ -1255,44 +1703,103 @@ static void _set_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
             if (strncasecmp("TRUE", pIsCommit, 4) == 0)
                 isCommit = true;
 
+            /* Look up every element before calling any handler, so a set that can't be applied isn't partly applied */
+            pNodes = (elementNode**)rt_try_calloc(numVals, 2*sizeof(elementNode*));
+            if(!pNodes)
+            {
+                RBUSLOG_WARN("Set Failed: failed to malloc %d elements", numVals);
+                rc = RBUS_ERROR_OUT_OF_RESOURCES;
+                pFailedElement = pCompName;
+                goto exit;
+            }
+            pOwners = pNodes + numVals;
+
             for (loopCnt = 0; loopCnt < numVals; loopCnt++)
             {
                 /* Retrive the element node */
                 char const* paramName = rbusProperty_GetName(pProperties[loopCnt]);
                 el = retrieveInstanceElement(handleInfo->elementRoot, paramName);
-                if(el != NULL)
+                if(el == NULL)
                 {
-                    if(el->cbTable.setHandler)
-                    {
-                        if(isCommit && loopCnt == numVals -1)
-                            opts.commit = true;
-
-                        rc = el->cbTable.setHandler(handle, pProperties[loopCnt], &opts);
-                        if (rc != RBUS_ERROR_SUCCESS)
-                        {
-                            RBUSLOG_WARN("Set Failed for %s; Component Owner returned Error", paramName);
-                            pFailedElement = paramName;
-                            break;
-                        }
-                        else
-                        {
-                            setPropertyChangeComponent(el, pCompName);
-                        }
-                    }
-                    else
+                    RBUSLOG_WARN("Set Failed for %s; No Element registered", paramName);
+                    rc = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+                    pFailedElement = paramName;
+                    goto exit;
+                }
+                pNodes[loopCnt] = el;
+                pOwners[loopCnt] = _set_multi_handler_owner(el);
+                if(!pOwners[loopCnt])
+                {
+                    if(!el->cbTable.setHandler)
                     {
                         RBUSLOG_WARN("Set Failed for %s; No Handler found", paramName);
                         rc = RBUS_ERROR_INVALID_OPERATION;
                         pFailedElement = paramName;
-                        break;
+                        goto exit;
                     }
+                    lastSingle = loopCnt;
                 }
-                else
-                {
-                    RBUSLOG_WARN("Set Failed for %s; No Element registered", paramName);
-                    rc = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
-                    pFailedElement = paramName;
-                    break;
+            }
+
+            for (loopCnt = 0; loopCnt < numVals; loopCnt++)
+            {
+                char const* paramName = rbusProperty_GetName(pProperties[loopCnt]);
+                elementNode* owner = pOwners[loopCnt];
+
+                /* Already passed to a setMultiHandler with an earlier property */
+                if(!pNodes[loopCnt])
+                    continue;
+
+                if(owner)
+                {
+                    /* Pass all the properties under owner to its setMultiHandler at once, with the commit of the whole set */
+                    rbusProperty_t* group;
+                    int i, n = 0;
+
+                    group = (rbusProperty_t*)rt_malloc((numVals - loopCnt)*sizeof(rbusProperty_t));
+                    for (i = loopCnt; i < numVals; i++)
+                    {
+                        if(pOwners[i] == owner)
+                            group[n++] = pProperties[i];
+                    }
+
+                    RBUSLOG_DEBUG("%s calling setMultiHandler of %s with %d properties", __FUNCTION__, owner->fullName, n);
+
+                    opts.commit = isCommit;
+                    rc = owner->setMultiHandler(handle, n, group, &opts);
+                    free(group);
+
+                    if (rc != RBUS_ERROR_SUCCESS)
+                    {
+                        RBUSLOG_WARN("Set Failed for %s; Component Owner returned Error", paramName);
+                        pFailedElement = paramName;
+                        break;
+                    }
+
+                    for (i = loopCnt; i < numVals; i++)
+                    {
+                        if(pOwners[i] == owner)
+                        {
+                            setPropertyChangeComponent(pNodes[i], pCompName);
+                            pNodes[i] = NULL;
+                        }
+                    }
+                }
+                else
+                {
+                    opts.commit = isCommit && loopCnt == lastSingle;
+
+                    rc = pNodes[loopCnt]->cbTable.setHandler(handle, pProperties[loopCnt], &opts);
+                    if (rc != RBUS_ERROR_SUCCESS)
+                    {
+                        RBUSLOG_WARN("Set Failed for %s; Component Owner returned Error", paramName);
+                        pFailedElement = paramName;
+                        break;
+                    }
+                    else
+                    {
+                        setPropertyChangeComponent(pNodes[loopCnt], pCompName);
+                    }
                 }
             }
         }
@@ -1324,6 +1831,7 @@ exit:
         }
         free(pProperties);
     }
+    free(pNodes);
 
     return;
 }
@@ -1406,18 +1914,230 @@ static char const* _convert_reg_name_to_instance_name(char const* registrationNa
     node can be either an instance node or a registration node (if an instance node doesn't exist).
     query will be set if node is a registration node, so that registration names can be converted to instance names
  */
-static void _get_recursive_partialpath_handler(elementNode* node, char const* query, rbusHandle_t handle, const char* pRequestingComp, rbusProperty_t properties, int *pCount, int level)
+/* The properties of a get request are gathered first and resolved after, so that all those covered by
+   the same getMultiHandler (see rbus_regGetMultiHandler) are passed to it in one call */
+typedef struct _rbusGetBatchItem
 {
-    rbusGetHandlerOptions_t options;
-    memset(&options, 0, sizeof(options));
+    elementNode*    node;       /* element of the property, NULL if resolved when added */
+    elementNode*    owner;      /* nearest registration ancestor with a getMultiHandler, NULL if none */
+    rbusProperty_t  property;   /* the property, or for a table getHandler the list it returned */
+    int             count;      /* number of properties in the list once resolved */
+    rbusError_t     result;
+    bool            resolved;
+    bool            required;   /* a failure fails the whole request, instead of leaving the property out */
+} rbusGetBatchItem_t;
+
+typedef struct _rbusGetBatch
+{
+    rbusGetBatchItem_t* items;
+    int                 numItems;
+    int                 capacity;
+    int                 skip;       /* for a paged get, the number of items before the page, which are dropped */
+    int                 limit;      /* for a paged get, the page size; 0 to keep every item */
+    bool                more;       /* an item was dropped after the page was full */
+    rbusArena_t         arena;      /* carves the properties gathered for the response, NULL while a provider handler runs */
+} rbusGetBatch_t;
+
+/*  the properties a get request gathers are serialized and freed before the callback returns, so they are
+    carved from an arena.  it is ended before any provider handler runs, since what a provider allocates
+    may outlive the request, and begun again after */
+static void _get_batch_arena_begin(rbusGetBatch_t* batch)
+{
+    if(!batch->arena)
+        rbusArena_Begin(&batch->arena);
+}
+
+static void _get_batch_arena_end(rbusGetBatch_t* batch)
+{
+    if(batch->arena)
+    {
+        rbusArena_End(batch->arena);
+        batch->arena = NULL;
+    }
+}
+
+static elementNode* _get_multi_handler_owner(elementNode* el)
+{
+    elementNode* node = getRegistrationElement(el);
+    while(node)
+    {
+        if(node->getMultiHandler)
+            return node;
+        node = node->parent;
+    }
+    return NULL;
+}
+
+static rbusGetBatchItem_t* _get_batch_add(rbusGetBatch_t* batch, elementNode* node, rbusProperty_t property, bool required)
+{
+    rbusGetBatchItem_t* item;
+
+    if(batch->skip > 0)
+    {
+        batch->skip--;
+        return NULL;
+    }
+    if(batch->limit > 0 && batch->numItems == batch->limit)
+    {
+        batch->more = true;
+        return NULL;
+    }
+
+    if(batch->numItems == batch->capacity)
+    {
+        batch->capacity = batch->capacity ? batch->capacity * 2 : 16;
+        batch->items = rt_realloc(batch->items, batch->capacity * sizeof(rbusGetBatchItem_t));
+    }
 
-    /* Update the Get Handler input options */
-    options.requestingComponent = pRequestingComp;
+    item = &batch->items[batch->numItems++];
+    item->node = node;
+    item->owner = node ? _get_multi_handler_owner(node) : NULL;
+    item->property = property;
+    item->count = 0;
+    item->result = RBUS_ERROR_SUCCESS;
+    item->resolved = node == NULL;
+    item->required = required;
+    rbusProperty_Retain(property);
+    return item;
+}
+
+/*  drop the gathered properties, keeping the arena and the items array */
+static void _get_batch_clear(rbusGetBatch_t* batch)
+{
+    int i;
+    for(i = 0; i < batch->numItems; ++i)
+        rbusProperty_Release(batch->items[i].property);
+    batch->numItems = 0;
+    batch->skip = 0;
+    batch->limit = 0;
+    batch->more = false;
+}
+
+/*  free the gathered properties.  the paging state is kept for the response */
+static void _get_batch_free(rbusGetBatch_t* batch)
+{
+    int i;
+    for(i = 0; i < batch->numItems; ++i)
+        rbusProperty_Release(batch->items[i].property);
+    _get_batch_arena_end(batch);
+    free(batch->items);
+}
+
+/*  call each getMultiHandler once with all of the batch's properties it covers, then the getHandler
+    of every property still without a value.  returns the first failure of a required property */
+static rbusError_t _get_batch_resolve(rbusHandle_t handle, rbusGetBatch_t* batch, rbusGetHandlerOptions_t* options)
+{
+    int i, j, n;
+    rbusError_t result;
+
+    _get_batch_arena_end(batch);
+
+    for(i = 0; i < batch->numItems; ++i)
+    {
+        elementNode* owner = batch->items[i].owner;
+        rbusProperty_t* props;
+
+        if(!owner || batch->items[i].resolved)
+            continue;
+
+        for(n = 0, j = i; j < batch->numItems; ++j)
+            if(batch->items[j].owner == owner && !batch->items[j].resolved)
+                n++;
+
+        props = rt_malloc(n * sizeof(rbusProperty_t));
+        for(n = 0, j = i; j < batch->numItems; ++j)
+            if(batch->items[j].owner == owner && !batch->items[j].resolved)
+                props[n++] = batch->items[j].property;
+
+        RBUSLOG_DEBUG("%s calling getMultiHandler of %s with %d properties", __FUNCTION__, owner->fullName, n);
+
+        result = owner->getMultiHandler(handle, n, props, options);
+        if(result != RBUS_ERROR_SUCCESS)
+            RBUSLOG_WARN("%s getMultiHandler of %s failed with result [%d]", __FUNCTION__, owner->fullName, result);
+
+        /*the properties left without a value fall back to their getHandler*/
+        for(j = i; j < batch->numItems; ++j)
+        {
+            rbusGetBatchItem_t* item = &batch->items[j];
+            if(item->owner != owner || item->resolved)
+                continue;
+            item->owner = NULL;
+            if(result == RBUS_ERROR_SUCCESS && rbusProperty_GetValue(item->property))
+            {
+                item->count = 1;
+                item->resolved = true;
+            }
+        }
+        free(props);
+    }
+
+    for(i = 0; i < batch->numItems; ++i)
+    {
+        rbusGetBatchItem_t* item = &batch->items[i];
+
+        if(!item->resolved)
+        {
+            if(item->node->cbTable.getHandler)
+            {
+                item->result = item->node->cbTable.getHandler(handle, item->property, options);
+                if(item->result == RBUS_ERROR_SUCCESS)
+                    item->count = 1;
+                else
+                    RBUSLOG_WARN("%s getHandler of %s failed with result [%d]", __FUNCTION__, rbusProperty_GetName(item->property), item->result);
+            }
+            else
+            {
+                RBUSLOG_WARN("%s no getHandler installed for [%s]", __FUNCTION__, rbusProperty_GetName(item->property));
+                item->result = RBUS_ERROR_INVALID_OPERATION;
+            }
+            item->resolved = true;
+        }
+
+        if(item->required && item->result != RBUS_ERROR_SUCCESS)
+            return item->result;
+    }
+    return RBUS_ERROR_SUCCESS;
+}
+
+/*  append the resolved properties of the batch to the properties list, in the order they were gathered */
+static void _get_batch_append(rbusGetBatch_t* batch, rbusProperty_t properties, int* pCount)
+{
+    int i;
+    rbusProperty_t tail = properties;
+
+    while(rbusProperty_GetNext(tail))
+        tail = rbusProperty_GetNext(tail);
+
+    for(i = 0; i < batch->numItems; ++i)
+    {
+        rbusGetBatchItem_t* item = &batch->items[i];
+
+        if(item->result != RBUS_ERROR_SUCCESS || item->count == 0)
+            continue;
+
+        rbusProperty_SetNext(tail, item->property);
+        *pCount += item->count;
+        while(rbusProperty_GetNext(tail))
+            tail = rbusProperty_GetNext(tail);
+    }
+}
 
+static void _get_recursive_partialpath_handler(elementNode* node, char const* query, rbusHandle_t handle, rbusGetHandlerOptions_t* options, rbusGetBatch_t* batch, int level)
+{
     RBUSLOG_DEBUG("%*s_get_recursive_partialpath_handler node=%s type=%d query=%s", level*4, " ", node ? node->fullName : "NULL", node ? node->type : 0, query ? query : "NULL");
 
     if (node != NULL)
     {
+        /*a virtual row has no instance children yet, so walk its row template with the row name as the query*/
+        if(!query && node->virtualRow)
+        {
+            char rowQuery[RBUS_MAX_NAME_LENGTH];
+
+            snprintf(rowQuery, RBUS_MAX_NAME_LENGTH, "%s.", node->fullName);
+            _get_recursive_partialpath_handler(node->regNode, rowQuery, handle, options, batch, level);
+            return;
+        }
+
         /*if table getHandler, then pass the query to it and stop recursion*/
         if(node->type == RBUS_ELEMENT_TYPE_TABLE && node->cbTable.getHandler)
         {
@@ -1433,7 +2153,16 @@ static void _get_recursive_partialpath_handler(elementNode* node, char const* qu
 
             rbusProperty_Init(&tmpProperties, partialPath, NULL);
 
-            result = node->cbTable.getHandler(handle, tmpProperties, &options);
+            if(batch->arena)
+            {
+                _get_batch_arena_end(batch);
+                result = node->cbTable.getHandler(handle, tmpProperties, options);
+                _get_batch_arena_begin(batch);
+            }
+            else
+            {
+                result = node->cbTable.getHandler(handle, tmpProperties, options);
+            }
 
             if (result == RBUS_ERROR_SUCCESS )
             {
@@ -1442,11 +2171,36 @@ static void _get_recursive_partialpath_handler(elementNode* node, char const* qu
                 RBUSLOG_DEBUG("%*s_get_recursive_partialpath_handler table getHandler returned %d properties", level*4, " ", count-1);
 
                 /*the first property is just the partialPath we passed in */
-                if(count > 1)
+                if(count > 1 && batch->skip == 0 && batch->limit == 0)
                 {
                     /*take the second property, which is a list*/
-                    rbusProperty_Append(properties, rbusProperty_GetNext(tmpProperties));
-                    *pCount += count - 1;
+                    rbusGetBatchItem_t* item = _get_batch_add(batch, NULL, rbusProperty_GetNext(tmpProperties), false);
+                    if(item)
+                        item->count = count - 1;
+                }
+                else if(count > 1)
+                {
+                    /*a paged get counts each property against the page, so unlink the list into single properties*/
+                    rbusProperty_t prop = rbusProperty_GetNext(tmpProperties);
+
+                    rbusProperty_Retain(prop);
+                    rbusProperty_SetNext(tmpProperties, NULL);
+                    while(prop && !batch->more)
+                    {
+                        rbusGetBatchItem_t* item;
+                        rbusProperty_t next = rbusProperty_GetNext(prop);
+
+                        if(next)
+                            rbusProperty_Retain(next);
+                        rbusProperty_SetNext(prop, NULL);
+                        item = _get_batch_add(batch, NULL, prop, false);
+                        if(item)
+                            item->count = 1;
+                        rbusProperty_Release(prop);
+                        prop = next;
+                    }
+                    if(prop)
+                        rbusProperty_Release(prop);
                 }
             }
             else
@@ -1460,30 +2214,26 @@ static void _get_recursive_partialpath_handler(elementNode* node, char const* qu
 
         elementNode* child = node->child;
 
-        while(child)
+        /*stop walking once a paged get has its page*/
+        while(child && !batch->more)
         {
-            if(child->type != RBUS_ELEMENT_TYPE_TABLE && child->cbTable.getHandler)
+            if(child->type != RBUS_ELEMENT_TYPE_TABLE &&
+               (child->cbTable.getHandler || (child->type == RBUS_ELEMENT_TYPE_PROPERTY && _get_multi_handler_owner(child))))
             {
-                rbusError_t result;
                 char instanceName[RBUS_MAX_NAME_LENGTH];
                 rbusProperty_t tmpProperties;
 
-                RBUSLOG_DEBUG("%*s_get_recursive_partialpath_handler calling property getHandler node=%s", level*4, " ", child->fullName);
+                RBUSLOG_DEBUG("%*s_get_recursive_partialpath_handler gathering property node=%s", level*4, " ", child->fullName);
 
                 rbusProperty_Init(&tmpProperties, query ? _convert_reg_name_to_instance_name(child->fullName, query, instanceName) : child->fullName, NULL);
-                result = child->cbTable.getHandler(handle, tmpProperties, &options);
-                if (result == RBUS_ERROR_SUCCESS)
-                {
-                    rbusProperty_Append(properties, tmpProperties);
-                    *pCount += 1;
-                }
+                _get_batch_add(batch, child, tmpProperties, false);
                 rbusProperty_Release(tmpProperties);
             }
             /*recurse into children that are not row templates without table getHandler*/
-            else if(child->child && !(child->parent->type == RBUS_ELEMENT_TYPE_TABLE && strcmp(child->name, "{i}") == 0 && child->cbTable.getHandler == NULL) )
+            else if((child->child || child->virtualRow) && !(child->parent->type == RBUS_ELEMENT_TYPE_TABLE && strcmp(child->name, "{i}") == 0 && child->cbTable.getHandler == NULL) )
             {
                 RBUSLOG_DEBUG("%*s_get_recursive_partialpath_handler recurse into %s", level*4, " ", child->fullName);
-                _get_recursive_partialpath_handler(child, query, handle, pRequestingComp, properties, pCount, level+1);
+                _get_recursive_partialpath_handler(child, query, handle, options, batch, level+1);
             }
             else
             {
@@ -1495,7 +2245,7 @@ static void _get_recursive_partialpath_handler(elementNode* node, char const* qu
     }
 }
 
-static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char const *parameterName, const char* pRequestingComp, rbusProperty_t properties, int *pCount)
+static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char const *parameterName, rbusGetHandlerOptions_t* options, rbusGetBatch_t* batch)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
     rbusError_t result = RBUS_ERROR_SUCCESS;
@@ -1506,10 +2256,6 @@ static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char co
     char wildcardName[RBUS_MAX_NAME_LENGTH];
     char* tmpPtr = NULL;
 
-    /* Update the Get Handler input options */
-    rbusGetHandlerOptions_t options;
-    options.requestingComponent = pRequestingComp;
-
     /* Have the backup of given name */
     snprintf(instanceName, RBUS_MAX_NAME_LENGTH, "%s", parameterName);
     int length = strlen(instanceName) - 1;
@@ -1527,7 +2273,7 @@ static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char co
         tmpPtr[0] = '\0';
         tmpPtr++;
 
-        el = retrieveInstanceElement(handleInfo->elementRoot, instanceName);
+        el = lookupInstanceElement(handleInfo->elementRoot, instanceName);
         if (!el)
             return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
 
@@ -1535,12 +2281,12 @@ static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char co
             return RBUS_ERROR_ACCESS_NOT_ALLOWED;
 
         child = el->child;
-        while(child)
+        while(child && !batch->more)
         {
             if(strcmp(child->name, "{i}") != 0)
             {
                 snprintf (wildcardName, RBUS_MAX_NAME_LENGTH, "%s%s%s", instanceName, child->name, tmpPtr);
-                result = _get_recursive_wildcard_handler(handle, wildcardName, pRequestingComp, properties, pCount);
+                result = _get_recursive_wildcard_handler(handle, wildcardName, options, batch);
                 if (result != RBUS_ERROR_SUCCESS)
                 {
                     RBUSLOG_WARN("Something went wrong while retriving the datamodel value...");
@@ -1553,94 +2299,72 @@ static rbusError_t _get_recursive_wildcard_handler (rbusHandle_t handle, char co
     else if (instanceName[length] == '.')
     {
         int hasInstance = 1;
-        el = retrieveInstanceElement(handleInfo->elementRoot, instanceName);
+        el = lookupInstanceElement(handleInfo->elementRoot, instanceName);
 
         if(el)
         {
             if(strstr(el->fullName, "{i}"))
                 hasInstance = 0;
 
-            _get_recursive_partialpath_handler(el, hasInstance ? NULL : parameterName, handle, pRequestingComp, properties, pCount, 0);
+            _get_recursive_partialpath_handler(el, hasInstance ? NULL : parameterName, handle, options, batch, 0);
         }
         else
             result = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
     }
     else
     {
-        child = retrieveInstanceElement(handleInfo->elementRoot, instanceName);
+        child = lookupInstanceElement(handleInfo->elementRoot, instanceName);
         if (!child)
             return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
 
-        if(child->type != RBUS_ELEMENT_TYPE_TABLE && child->cbTable.getHandler)
+        if(child->type != RBUS_ELEMENT_TYPE_TABLE && (child->cbTable.getHandler || _get_multi_handler_owner(child)))
         {
-            rbusError_t result;
             rbusProperty_t tmpProperties;
             rbusProperty_Init(&tmpProperties, instanceName, NULL);
-            result = child->cbTable.getHandler(handle, tmpProperties, &options);
-            if (result == RBUS_ERROR_SUCCESS)
-            {
-                rbusProperty_Append(properties, tmpProperties);
-                *pCount += 1;
-            }
+            _get_batch_add(batch, child, tmpProperties, true);
             rbusProperty_Release(tmpProperties);
-            return result;
         }
     }
     return result;
 }
 
-
-static rbusError_t _get_single_dml_handler (rbusHandle_t handle, char const *parameterName, char const *pRequestingComp, rbusProperty_t properties)
+/*  add a property of a get request by name, failing if its element doesn't exist */
+static rbusError_t _get_batch_add_name(rbusHandle_t handle, rbusGetBatch_t* batch, rbusProperty_t property)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
-    elementNode* el = NULL;
-    rbusError_t result = RBUS_ERROR_SUCCESS;
-    /* Update the Get Handler input options */
-    rbusGetHandlerOptions_t options;
-    options.requestingComponent = pRequestingComp;
+    char const* parameterName = rbusProperty_GetName(property);
+    elementNode* el;
 
     RBUSLOG_DEBUG("calling get single for [%s]", parameterName);
 
-    el = retrieveInstanceElement(handleInfo->elementRoot, parameterName);
+    el = lookupInstanceElement(handleInfo->elementRoot, parameterName);
     if(el != NULL)
     {
         RBUSLOG_DEBUG("Retrieved [%s]", parameterName);
-
-        if(el->cbTable.getHandler)
-        {
-            RBUSLOG_DEBUG("Table and CB exists for [%s], call the CB!", parameterName);
-
-            result = el->cbTable.getHandler(handle, properties, &options);
-
-            if (result != RBUS_ERROR_SUCCESS)
-            {
-                RBUSLOG_WARN("called CB with result [%d]", result);
-            }
-        }
-        else
-        {
-            RBUSLOG_WARN("Element retrieved, but no cb installed for [%s]!", parameterName);
-            result = RBUS_ERROR_INVALID_OPERATION;
-        }
+        _get_batch_add(batch, el, property, true);
+        return RBUS_ERROR_SUCCESS;
     }
     else
     {
         RBUSLOG_WARN("Not able to retrieve element [%s]", parameterName);
-        result = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
     }
-    return result;
 }
 
 static void _get_callback_handler (rbusHandle_t handle, rbusMessage request, rbusMessage *response)
 {
     int paramSize = 1, i = 0;
+    int version = 0;
+    int32_t cursor = 0, pageSize = 0;
     rbusError_t result = RBUS_ERROR_SUCCESS;
     char const *parameterName = NULL;
     char const *pCompName = NULL;
     rbusProperty_t* properties = NULL;
     rbusGetHandlerOptions_t options;
+    rbusGetBatch_t batch;
 
     memset(&options, 0, sizeof(options));
+    memset(&batch, 0, sizeof(batch));
     rbusMessage_GetString(request, &pCompName);
     rbusMessage_GetInt32(request, &paramSize);
 
@@ -1654,11 +2378,7 @@ static void _get_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
         properties = rt_try_malloc(paramSize*sizeof(rbusProperty_t));
         if(properties)
         {
-            for(i = 0; i < paramSize; i++)
-            {
-                rbusProperty_Init(&properties[i], NULL, NULL);
-            }
-
+            _get_batch_arena_begin(&batch);
             for(i = 0; i < paramSize; i++)
             {
                 parameterName = NULL;
@@ -1666,7 +2386,20 @@ static void _get_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
 
                 RBUSLOG_DEBUG("Param Name [%d]:[%s]", i, parameterName);
 
-                rbusProperty_SetName(properties[i], parameterName);
+                rbusProperty_Init(&properties[i], parameterName, NULL);
+            }
+
+            /* Older consumers don't send a version and only understand the rbusMessage encoding */
+            if(rbusMessage_GetInt32(request, &version) != RT_OK)
+                version = 0;
+
+            if(version >= RBUS_GET_PAGED_WIRE_VERSION &&
+               (rbusMessage_GetInt32(request, &cursor) != RT_OK || rbusMessage_GetInt32(request, &pageSize) != RT_OK))
+                cursor = pageSize = 0;
+
+            for(i = 0; i < paramSize; i++)
+            {
+                parameterName = rbusProperty_GetName(properties[i]);
 
                 /* Check for wildcard query */
                 if (_is_wildcard_query(parameterName))
@@ -1680,35 +2413,68 @@ static void _get_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
                     rbusProperty_Init(&xproperties, "tmpProp", xtmp);
                     rbusValue_Release(xtmp);
 
-                    result = _get_recursive_wildcard_handler(handle, parameterName, pCompName, xproperties, &count);
+                    /* only the wildcard query is answered, so drop the properties gathered before it */
+                    _get_batch_clear(&batch);
+
+                    /* a paged get only resolves the properties of the page */
+                    if(pageSize > 0)
+                    {
+                        batch.skip = cursor > 0 ? cursor : 0;
+                        batch.limit = pageSize;
+                    }
+
+                    result = _get_recursive_wildcard_handler(handle, parameterName, &options, &batch);
+                    if (result == RBUS_ERROR_SUCCESS)
+                        result = _get_batch_resolve(handle, &batch, &options);
+                    if (result == RBUS_ERROR_SUCCESS)
+                        _get_batch_append(&batch, xproperties, &count);
+                    if (batch.more)
+                        RBUSLOG_DEBUG("%s page of %d at %d for %s has more", __FUNCTION__, pageSize, cursor, parameterName);
+                    _get_batch_free(&batch);
+
                     rbusMessage_Init(response);
                     rbusMessage_SetInt32(*response, (int) result);
                     if (result == RBUS_ERROR_SUCCESS)
                     {
-                        rbusMessage_SetInt32(*response, count);
-                        if (count > 0)
+                        if(version < RBUS_GET_WIRE_VERSION ||
+                           !rbusPropertyList_appendBlobToMessage(NULL, rbusProperty_GetNext(xproperties), count, *response))
                         {
-                            first = rbusProperty_GetNext(xproperties);
-                            for(i = 0; i < count; i++)
+                            rbusMessage_SetInt32(*response, count);
+                            if (count > 0)
                             {
-                                rbusValue_appendToMessage(rbusProperty_GetName(first), rbusProperty_GetValue(first), *response);
-                                first = rbusProperty_GetNext(first);
+                                first = rbusProperty_GetNext(xproperties);
+                                for(i = 0; i < count; i++)
+                                {
+                                    rbusValue_appendToMessage(rbusProperty_GetName(first), rbusProperty_GetValue(first), *response);
+                                    first = rbusProperty_GetNext(first);
+                                }
                             }
                         }
+                        if(pageSize > 0)
+                            rbusMessage_SetInt32(*response, batch.more ? cursor + pageSize : 0);
                     }
                     /* Release the memory */
                     rbusProperty_Release(xproperties);
+                    for (i = 0; i < paramSize; i++)
+                    {
+                        rbusProperty_Release(properties[i]);
+                    }
+                    free (properties);
 
                     return;
                 }
                 else
                 {
-                    //Do a look up and call the corresponding method
-                    result = _get_single_dml_handler(handle, parameterName, pCompName, properties[i]);
+                    //Do a look up and gather the property for its getHandler or getMultiHandler
+                    result = _get_batch_add_name(handle, &batch, properties[i]);
                     if (result != RBUS_ERROR_SUCCESS)
                         break;
                 }
             }
+
+            if (result == RBUS_ERROR_SUCCESS)
+                result = _get_batch_resolve(handle, &batch, &options);
+            _get_batch_free(&batch);
         }
         else
         {
@@ -1722,10 +2488,14 @@ static void _get_callback_handler (rbusHandle_t handle, rbusMessage request, rbu
         {
             if (result == RBUS_ERROR_SUCCESS)
             {
-                rbusMessage_SetInt32(*response, paramSize);
-                for(i = 0; i < paramSize; i++)
+                if(version < RBUS_GET_WIRE_VERSION ||
+                   !rbusPropertyList_appendBlobToMessage(properties, NULL, paramSize, *response))
                 {
-                    rbusValue_appendToMessage(rbusProperty_GetName(properties[i]), rbusProperty_GetValue(properties[i]), *response);
+                    rbusMessage_SetInt32(*response, paramSize);
+                    for(i = 0; i < paramSize; i++)
+                    {
+                        rbusValue_appendToMessage(rbusProperty_GetName(properties[i]), rbusProperty_GetValue(properties[i]), *response);
+                    }
                 }
             }
         
@@ -1763,13 +2533,13 @@ static void _get_parameter_names_recurse(elementNode* el, int* count, rbusMessag
             uint32_t access = 0;
             char objectName[RBUS_MAX_NAME_LENGTH];
 
-            if(el->cbTable.getHandler)
+            if(el->cbTable.getHandler || (el->type == RBUS_ELEMENT_TYPE_PROPERTY && _get_multi_handler_owner(el)))
                 access |= RBUS_ACCESS_GET;
-            if(el->cbTable.setHandler)
+            if(el->cbTable.setHandler || (el->type == RBUS_ELEMENT_TYPE_PROPERTY && _set_multi_handler_owner(el)))
                 access |= RBUS_ACCESS_SET;
-            if(el->cbTable.tableAddRowHandler)
+            if(el->cbTable.tableAddRowHandler || getRegistrationElement(el)->tableAddRowsHandler)
                 access |= RBUS_ACCESS_ADDROW;
-            if(el->cbTable.tableRemoveRowHandler)
+            if(el->cbTable.tableRemoveRowHandler || getRegistrationElement(el)->tableRemoveRowsHandler)
                 access |= RBUS_ACCESS_REMOVEROW;
             if(el->cbTable.eventSubHandler)
                 access |= RBUS_ACCESS_SUBSCRIBE;
@@ -1799,7 +2569,12 @@ static void _get_parameter_names_recurse(elementNode* el, int* count, rbusMessag
 
     if(currentDepth < absDepth)
     {
-        elementNode* child = el->child;
+        elementNode* child;
+
+        if(el->virtualRow)
+            materializeTableRow(el);
+
+        child = el->child;
         while(child)
         {
             if( !(child->type == RBUS_ELEMENT_TYPE_TABLE && child->cbTable.getHandler) && /*TODO table with get handler */
@@ -1948,6 +2723,92 @@ static void _get_parameter_names_handler (rbusHandle_t handle, rbusMessage reque
     #endif
 }
 
+/* Add and remove row requests from consumers that can send several rows end with
+   RBUS_TABLE_ROWS_WIRE_VERSION, the row count and every row's alias (add) or name (remove).
+   Providers that see it handle all the rows and append the same version, the row count
+   and every row's instance number (add) or result (remove) to the response.
+   Older providers ignore the trailing fields and handle only the first row, which is also
+   sent in the usual place, so the consumer then sends the other rows one at a time. */
+#define RBUS_TABLE_ROWS_WIRE_VERSION    1
+
+/*  add rows with the provider's tableAddRowsHandler, or its tableAddRowHandler one row at a time,
+    and register the rows added.  instNums[i] is left 0 for a row not added */
+static rbusError_t _table_add_rows (rbusHandle_t handle, elementNode* tableRegElem, elementNode* tableInstElem, char const* tableName, int numRows, char const** aliasNames, uint32_t* instNums)
+{
+    rbusError_t result = RBUS_ERROR_SUCCESS;
+    elementNode** rows;
+    int numAdded = 0;
+    int i;
+
+    memset(instNums, 0, numRows * sizeof(uint32_t));
+
+    if(tableRegElem->tableAddRowsHandler)
+    {
+        RBUSLOG_INFO("%s calling tableAddRowsHandler table [%s] numRows [%d]", __FUNCTION__, tableName, numRows);
+
+        result = tableRegElem->tableAddRowsHandler(handle, tableName, numRows, aliasNames, instNums);
+
+        if(result != RBUS_ERROR_SUCCESS)
+        {
+            RBUSLOG_WARN("%s tableAddRowsHandler failed table [%s] err [%d]", __FUNCTION__, tableName, result);
+        }
+    }
+    else if(tableRegElem->cbTable.tableAddRowHandler)
+    {
+        for(i = 0; i < numRows; ++i)
+        {
+            rbusError_t rc;
+
+            RBUSLOG_INFO("%s calling tableAddRowHandler table [%s] alias [%s]", __FUNCTION__, tableName, aliasNames[i]);
+
+            rc = tableRegElem->cbTable.tableAddRowHandler(handle, tableName, aliasNames[i], &instNums[i]);
+
+            if(rc != RBUS_ERROR_SUCCESS)
+            {
+                RBUSLOG_WARN("%s tableAddRowHandler failed table [%s] alias [%s]", __FUNCTION__, tableName, aliasNames[i]);
+                instNums[i] = 0;
+                if(result == RBUS_ERROR_SUCCESS)
+                    result = rc;
+            }
+        }
+    }
+    else
+    {
+        RBUSLOG_WARN("%s tableAddRowHandler not registered table [%s]", __FUNCTION__, tableName);
+        return RBUS_ERROR_INVALID_OPERATION;
+    }
+
+    /*register the rows added, moving them to the front of the arrays*/
+    {
+        uint32_t* addedInstNums = rt_malloc(numRows * sizeof(uint32_t));
+        char const** addedAliasNames = rt_malloc(numRows * sizeof(char const*));
+
+        for(i = 0; i < numRows; ++i)
+        {
+            if(instNums[i] != 0)
+            {
+                addedInstNums[numAdded] = instNums[i];
+                addedAliasNames[numAdded] = aliasNames[i];
+                numAdded++;
+            }
+            else if(result == RBUS_ERROR_SUCCESS)
+            {
+                result = RBUS_ERROR_BUS_ERROR;
+            }
+        }
+
+        if(numAdded)
+        {
+            rows = rt_malloc(numAdded * sizeof(elementNode*));
+            registerTableRows(handle, tableInstElem, tableName, numAdded, addedInstNums, addedAliasNames, rows);
+            free(rows);
+        }
+        free(addedInstNums);
+        free(addedAliasNames);
+    }
+    return result;
+}
+
 static void _table_add_row_callback_handler (rbusHandle_t handle, rbusMessage request, rbusMessage* response)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
@@ -1956,7 +2817,12 @@ static void _table_add_row_callback_handler (rbusHandle_t handle, rbusMessage re
     char const* tableName;
     char const* aliasName = NULL;
     int err;
+    int version = 0;
+    int numRows = 1;
+    char const** aliasNames = &aliasName;
     uint32_t instNum = 0;
+    uint32_t* instNums = &instNum;
+    int i;
 
     rbusMessage_GetInt32(request, &sessionId);
     rbusMessage_GetString(request, &tableName);
@@ -1965,33 +2831,35 @@ static void _table_add_row_callback_handler (rbusHandle_t handle, rbusMessage re
     if(err != RT_OK || (aliasName && strlen(aliasName)==0))
         aliasName = NULL;
 
-    RBUSLOG_DEBUG("%s table [%s] alias [%s] err [%d]", __FUNCTION__, tableName, aliasName, err);
+    /*a multi-row request carries every row after the version*/
+    if(err == RT_OK &&
+       rbusMessage_GetInt32(request, &version) == RT_OK && version >= RBUS_TABLE_ROWS_WIRE_VERSION &&
+       rbusMessage_GetInt32(request, &numRows) == RT_OK && numRows > 0)
+    {
+        aliasNames = rt_malloc(numRows * sizeof(char const*));
+        instNums = rt_malloc(numRows * sizeof(uint32_t));
+        for(i = 0; i < numRows; ++i)
+        {
+            if(rbusMessage_GetString(request, &aliasNames[i]) != RT_OK || strlen(aliasNames[i]) == 0)
+                aliasNames[i] = NULL;
+        }
+    }
+    else
+    {
+        version = 0;
+        numRows = 1;
+    }
+
+    RBUSLOG_DEBUG("%s table [%s] alias [%s] numRows [%d] err [%d]", __FUNCTION__, tableName, aliasName, numRows, err);
 
     elementNode* tableRegElem = retrieveElement(handleInfo->elementRoot, tableName);
     elementNode* tableInstElem = retrieveInstanceElement(handleInfo->elementRoot, tableName);
 
+    memset(instNums, 0, numRows * sizeof(uint32_t));
+
     if(tableRegElem && tableInstElem)
     {
-        if(tableRegElem->cbTable.tableAddRowHandler)
-        {
-            RBUSLOG_INFO("%s calling tableAddRowHandler table [%s] alias [%s]", __FUNCTION__, tableName, aliasName);
-
-            result = tableRegElem->cbTable.tableAddRowHandler(handle, tableName, aliasName, &instNum);
-
-            if (result == RBUS_ERROR_SUCCESS)
-            {
-                registerTableRow(handle, tableInstElem, tableName, aliasName, instNum);
-            }
-            else
-            {
-                RBUSLOG_WARN("%s tableAddRowHandler failed table [%s] alias [%s]", __FUNCTION__, tableName, aliasName);
-            }
-        }
-        else
-        {
-            RBUSLOG_WARN("%s tableAddRowHandler not registered table [%s] alias [%s]", __FUNCTION__, tableName, aliasName);
-            result = RBUS_ERROR_INVALID_OPERATION;
-        }
+        result = _table_add_rows(handle, tableRegElem, tableInstElem, tableName, numRows, aliasNames, instNums);
     }
     else
     {
@@ -2001,68 +2869,194 @@ static void _table_add_row_callback_handler (rbusHandle_t handle, rbusMessage re
 
     rbusMessage_Init(response);
     rbusMessage_SetInt32(*response, result);
-    rbusMessage_SetInt32(*response, (int32_t)instNum);
+    rbusMessage_SetInt32(*response, (int32_t)instNums[0]);
+
+    if(version >= RBUS_TABLE_ROWS_WIRE_VERSION)
+    {
+        rbusMessage_SetInt32(*response, RBUS_TABLE_ROWS_WIRE_VERSION);
+        rbusMessage_SetInt32(*response, numRows);
+        for(i = 0; i < numRows; ++i)
+            rbusMessage_SetInt32(*response, (int32_t)instNums[i]);
+        free(aliasNames);
+        free(instNums);
+    }
 }
 
-static void _table_remove_row_callback_handler (rbusHandle_t handle, rbusMessage request, rbusMessage* response)
+/*  remove rows of one table with the provider's tableRemoveRowsHandler, or its tableRemoveRowHandler one
+    row at a time, and unregister the rows removed.  results[i] is set for every row */
+static rbusError_t _table_remove_rows (rbusHandle_t handle, int numRows, char const** rowNames, rbusError_t* results)
 {
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
-    rbusError_t result = RBUS_ERROR_BUS_ERROR;
-    int sessionId;
-    char const* rowName;
+    rbusError_t result = RBUS_ERROR_SUCCESS;
+    elementNode** rows;
+    elementNode* tableRegElem = NULL;
+    elementNode* tableInstElem = NULL;
+    char tableName[RBUS_MAX_NAME_LENGTH] = "";
+    int i;
 
-    rbusMessage_GetInt32(request, &sessionId);
-    rbusMessage_GetString(request, &rowName);
+    rows = rt_malloc(numRows * sizeof(elementNode*));
 
-    RBUSLOG_DEBUG("%s row [%s]", __FUNCTION__, rowName);
+    for(i = 0; i < numRows; ++i)
+    {
+        /*get the element for the row */
+        elementNode* rowRegElem = retrieveElement(handleInfo->elementRoot, rowNames[i]);
 
-    /*get the element for the row */
-    elementNode* rowRegElem = retrieveElement(handleInfo->elementRoot, rowName);
-    elementNode* rowInstElem = retrieveInstanceElement(handleInfo->elementRoot, rowName);
+        rows[i] = retrieveInstanceElement(handleInfo->elementRoot, rowNames[i]);
+        results[i] = RBUS_ERROR_SUCCESS;
 
-    if(rowRegElem && rowInstElem)
-    {
         /*switch to the row's table */
-        elementNode* tableRegElem = rowRegElem->parent;
-        elementNode* tableInstElem = rowInstElem->parent;
+        if(!rowRegElem || !rows[i] || !rowRegElem->parent || !rows[i]->parent)
+        {
+            RBUSLOG_WARN("%s no element found row [%s]", __FUNCTION__, rowNames[i]);
+            results[i] = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+        }
+        else if(tableInstElem && rows[i]->parent != tableInstElem)
+        {
+            RBUSLOG_WARN("%s row [%s] is not in table [%s]", __FUNCTION__, rowNames[i], tableName);
+            results[i] = RBUS_ERROR_INVALID_INPUT;
+        }
+        else if(!tableInstElem)
+        {
+            /*the table name passed to tableRemoveRowsHandler ends in a dot.  it's taken from the table
+              row's element, since a row name may end in a dot or be an alias*/
+            tableRegElem = rowRegElem->parent;
+            tableInstElem = rows[i]->parent;
+            snprintf(tableName, RBUS_MAX_NAME_LENGTH, "%s.", tableInstElem->fullName);
+        }
+
+        if(results[i] != RBUS_ERROR_SUCCESS)
+            rows[i] = NULL;
+    }
+
+    if(!tableRegElem)
+    {
+        result = results[0];
+    }
+    else if(tableRegElem->tableRemoveRowsHandler)
+    {
+        char const** validNames = rt_malloc(numRows * sizeof(char const*));
+        rbusError_t* validResults = rt_malloc(numRows * sizeof(rbusError_t));
+        int numValid = 0;
 
-        if(tableRegElem && tableInstElem)
+        for(i = 0; i < numRows; ++i)
         {
-            if(tableRegElem->cbTable.tableRemoveRowHandler)
+            if(rows[i])
             {
-                RBUSLOG_INFO("%s calling tableRemoveRowHandler row [%s]", __FUNCTION__, rowName);
+                validNames[numValid] = rowNames[i];
+                validResults[numValid] = RBUS_ERROR_SUCCESS;
+                numValid++;
+            }
+        }
 
-                result = tableRegElem->cbTable.tableRemoveRowHandler(handle, rowName);
+        RBUSLOG_INFO("%s calling tableRemoveRowsHandler table [%s] numRows [%d]", __FUNCTION__, tableName, numValid);
 
-                if (result == RBUS_ERROR_SUCCESS)
-                {
-                    unregisterTableRow(handle, rowInstElem);
-                }
-                else
+        result = tableRegElem->tableRemoveRowsHandler(handle, tableName, numValid, validNames, validResults);
+
+        if(result != RBUS_ERROR_SUCCESS)
+        {
+            RBUSLOG_WARN("%s tableRemoveRowsHandler failed table [%s] err [%d]", __FUNCTION__, tableName, result);
+        }
+
+        numValid = 0;
+        for(i = 0; i < numRows; ++i)
+        {
+            if(rows[i])
+                results[i] = validResults[numValid++];
+        }
+        free(validNames);
+        free(validResults);
+    }
+    else if(tableRegElem->cbTable.tableRemoveRowHandler)
+    {
+        for(i = 0; i < numRows; ++i)
+        {
+            if(rows[i])
+            {
+                RBUSLOG_INFO("%s calling tableRemoveRowHandler row [%s]", __FUNCTION__, rowNames[i]);
+
+                results[i] = tableRegElem->cbTable.tableRemoveRowHandler(handle, rowNames[i]);
+
+                if(results[i] != RBUS_ERROR_SUCCESS)
                 {
-                    RBUSLOG_WARN("%s tableRemoveRowHandler failed row [%s]", __FUNCTION__, rowName);
+                    RBUSLOG_WARN("%s tableRemoveRowHandler failed row [%s]", __FUNCTION__, rowNames[i]);
                 }
             }
-            else
-            {
-                RBUSLOG_INFO("%s tableRemoveRowHandler not registered row [%s]", __FUNCTION__, rowName);
-                result = RBUS_ERROR_INVALID_OPERATION;
-            }
         }
-        else
+    }
+    else
+    {
+        RBUSLOG_INFO("%s tableRemoveRowHandler not registered table [%s]", __FUNCTION__, tableName);
+        for(i = 0; i < numRows; ++i)
         {
-            RBUSLOG_WARN("%s no parent element found row [%s]", __FUNCTION__, rowName);
-            result = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+            if(rows[i])
+                results[i] = RBUS_ERROR_INVALID_OPERATION;
+        }
+    }
+
+    for(i = 0; i < numRows; ++i)
+    {
+        if(results[i] != RBUS_ERROR_SUCCESS)
+        {
+            rows[i] = NULL;
+            if(result == RBUS_ERROR_SUCCESS)
+                result = results[i];
+        }
+    }
+
+    unregisterTableRows(handle, rows, numRows);
+    free(rows);
+    return result;
+}
+
+static void _table_remove_row_callback_handler (rbusHandle_t handle, rbusMessage request, rbusMessage* response)
+{
+    rbusError_t result = RBUS_ERROR_BUS_ERROR;
+    int sessionId;
+    char const* rowName;
+    int version = 0;
+    int numRows = 1;
+    char const** rowNames = &rowName;
+    rbusError_t rowResult;
+    rbusError_t* results = &rowResult;
+    int i;
+
+    rbusMessage_GetInt32(request, &sessionId);
+    rbusMessage_GetString(request, &rowName);
+
+    /*a multi-row request carries every row after the version*/
+    if(rbusMessage_GetInt32(request, &version) == RT_OK && version >= RBUS_TABLE_ROWS_WIRE_VERSION &&
+       rbusMessage_GetInt32(request, &numRows) == RT_OK && numRows > 0)
+    {
+        rowNames = rt_malloc(numRows * sizeof(char const*));
+        results = rt_malloc(numRows * sizeof(rbusError_t));
+        for(i = 0; i < numRows; ++i)
+        {
+            if(rbusMessage_GetString(request, &rowNames[i]) != RT_OK)
+                rowNames[i] = "";
         }
     }
     else
     {
-        RBUSLOG_WARN("%s no element found row [%s]", __FUNCTION__, rowName);
-        result = RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+        version = 0;
+        numRows = 1;
     }
 
+    RBUSLOG_DEBUG("%s row [%s] numRows [%d]", __FUNCTION__, rowName, numRows);
+
+    result = _table_remove_rows(handle, numRows, rowNames, results);
+
     rbusMessage_Init(response);
-    rbusMessage_SetInt32(*response, result);
+    rbusMessage_SetInt32(*response, version >= RBUS_TABLE_ROWS_WIRE_VERSION ? result : results[0]);
+
+    if(version >= RBUS_TABLE_ROWS_WIRE_VERSION)
+    {
+        rbusMessage_SetInt32(*response, RBUS_TABLE_ROWS_WIRE_VERSION);
+        rbusMessage_SetInt32(*response, numRows);
+        for(i = 0; i < numRows; ++i)
+            rbusMessage_SetInt32(*response, results[i]);
+        free(rowNames);
+        free(results);
+    }
 }
 
 static int _method_callback_handler(rbusHandle_t handle, rbusMessage request, rbusMessage* response, const rtMessageHeader* hdr)
@@ -2204,7 +3198,7 @@ static void _rbus_open_pre_initialize(bool retain)
     else if(!retain && sRetained)
     {
         rbusConfig_Destroy();
-        rbusElement_mutex_destroy();
+        rbusOwnerCache_Clear();
         sRetained = false;
     }
 }
@@ -2222,7 +3216,6 @@ rbusError_t rbus_open(rbusHandle_t* handle, char const* componentName)
     rbusError_t ret = RBUS_ERROR_SUCCESS;
     rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
     rbusHandle_t tmpHandle = NULL;
-    static int32_t sLastComponentId = 0;
 
     if(!handle || !componentName)
     {
@@ -2292,10 +3285,12 @@ rbusError_t rbus_open(rbusHandle_t* handle, char const* componentName)
     }
 
     tmpHandle->componentName = strdup(componentName);
-    tmpHandle->componentId = ++sLastComponentId;
+    tmpHandle->componentId = ++gLastComponentId;
     tmpHandle->connection = rbus_getConnection();
     rtVector_Create(&tmpHandle->eventSubs);
+    rbusEventSubIndex_Create(&tmpHandle->eventSubIndex);
     rtVector_Create(&tmpHandle->messageCallbacks);
+    rbusElementTimeouts_Create(&tmpHandle->elementTimeouts);
 
     *handle = tmpHandle;
 
@@ -2351,11 +3346,15 @@ rbusError_t rbus_close(rbusHandle_t handle)
     rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
     char* componentName = NULL;
+    bool lastHandle = false;
 
     VERIFY_NULL(handle);
 
     RBUSLOG_INFO("%s(%s)", __FUNCTION__, handleInfo->componentName);
 
+    /*before taking the lock, since a completion callback may be waiting on it*/
+    rbusAsyncRequest_CloseHandle(handle);
+
     LockMutex();
 
     if(handleInfo->eventSubs)
@@ -2374,6 +3373,8 @@ rbusError_t rbus_close(rbusHandle_t handle)
         }
         rtVector_Destroy(handleInfo->eventSubs, NULL);
         handleInfo->eventSubs = NULL;
+        rbusEventSubIndex_Destroy(handleInfo->eventSubIndex);
+        handleInfo->eventSubIndex = NULL;
     }
 
     if (handleInfo->messageCallbacks)
@@ -2383,6 +3384,14 @@ rbusError_t rbus_close(rbusHandle_t handle)
         handleInfo->messageCallbacks = NULL;
     }
 
+    rbusIntervalSub_CloseHandle(handle);//called before rbusSubscriptions_destroy below
+
+    if(handleInfo->eventBatch)
+    {
+        rbusEventBatch_Destroy(handleInfo->eventBatch);
+        handleInfo->eventBatch = NULL;
+    }
+
     if(handleInfo->subscriptions != NULL)
     {
         rbusSubscriptions_destroy(handleInfo->subscriptions);
@@ -2393,6 +3402,16 @@ rbusError_t rbus_close(rbusHandle_t handle)
 
     rbusAsyncSubscribe_CloseHandle(handle);
 
+    /*after rbusAsyncSubscribe_CloseHandle dropped its pending value-change subscriptions*/
+    if(handleInfo->valueCache)
+    {
+        rbusValueCache_Destroy(handleInfo->valueCache);
+        handleInfo->valueCache = NULL;
+    }
+
+    rbusElementTimeouts_Destroy(handleInfo->elementTimeouts);
+    handleInfo->elementTimeouts = NULL;
+
     if(handleInfo->elementRoot)
     {
         freeElementNode(handleInfo->elementRoot);
@@ -2405,6 +3424,8 @@ rbusError_t rbus_close(rbusHandle_t handle)
         ret = RBUS_ERROR_INVALID_HANDLE;
     }
 
+    rbusOwnerCache_RemoveOwner(handleInfo->componentName);
+
     componentName = handleInfo->componentName;
 
     rbusHandleList_Remove(handleInfo);
@@ -2419,6 +3440,9 @@ rbusError_t rbus_close(rbusHandle_t handle)
             RBUSLOG_ERROR("%s(%s): rbus_unregisterClientDisconnectHandler error %d", __FUNCTION__, componentName, err);
             ret = RBUS_ERROR_BUS_ERROR;
         }
+        pthread_mutex_lock(&gDisConnMutex);
+        gDisConnHandler = false;
+        pthread_mutex_unlock(&gDisConnMutex);
 
         if((err = rbus_closeBrokerConnection()) != RTMESSAGE_BUS_SUCCESS)
         {
@@ -2427,10 +3451,15 @@ rbusError_t rbus_close(rbusHandle_t handle)
         }
 
         _rbus_open_pre_initialize(false);
+        lastHandle = true;
     }
 
     UnlockMutex();
 
+    /*outside the lock, so completion threads blocked on it can finish*/
+    if(lastHandle)
+        rbusAsyncRequest_Shutdown();
+
     if(ret == RBUS_ERROR_SUCCESS)
         RBUSLOG_INFO("%s(%s) success", __FUNCTION__, componentName);
 
@@ -2439,21 +3468,122 @@ rbusError_t rbus_close(rbusHandle_t handle)
     return ret;
 }
 
+rbusError_t rbusHandle_ConfigGetTimeout(rbusHandle_t handle, uint32_t timeout)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handleInfo);
+
+    handleInfo->getTimeout = timeout > INT_MAX ? INT_MAX : (int)timeout;
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbusHandle_ConfigSetTimeout(rbusHandle_t handle, uint32_t timeout)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handleInfo);
+
+    handleInfo->setTimeout = timeout > INT_MAX ? INT_MAX : (int)timeout;
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbusHandle_ConfigElementTimeouts(rbusHandle_t handle, char const* elementName, uint32_t getTimeout, uint32_t setTimeout)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(elementName);
+
+    if(elementName[0] == '\0' || _is_wildcard_query(elementName))
+    {
+        RBUSLOG_WARN("%s invalid element name %s", __FUNCTION__, elementName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    rbusElementTimeouts_Set(handleInfo->elementTimeouts, elementName,
+        getTimeout > INT_MAX ? INT_MAX : (int)getTimeout,
+        setTimeout > INT_MAX ? INT_MAX : (int)setTimeout);
+    return RBUS_ERROR_SUCCESS;
+}
+
+/*the cache gets a componentId of its own for its value-change subscriptions*/
+static void _create_value_cache(struct _rbusHandle* handleInfo)
+{
+    LockMutex();
+    handleInfo->valueCacheComponentId = ++gLastComponentId;
+    UnlockMutex();
+    rbusValueCache_Create(&handleInfo->valueCache, handleInfo);
+}
+
+rbusError_t rbusHandle_ConfigValueCache(rbusHandle_t handle, uint32_t ttl, bool coherent)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handleInfo);
+
+    if(!handleInfo->valueCache)
+    {
+        if(ttl == 0)
+            return RBUS_ERROR_SUCCESS;
+        _create_value_cache(handleInfo);
+    }
+
+    rbusValueCache_SetOptions(handleInfo->valueCache, ttl, coherent);
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbusHandle_ConfigValueCacheTTL(rbusHandle_t handle, char const* elementName, uint32_t ttl)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(elementName);
+
+    if(elementName[0] == '\0' || _is_wildcard_query(elementName))
+    {
+        RBUSLOG_WARN("%s invalid element name %s", __FUNCTION__, elementName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    if(!handleInfo->valueCache)
+        _create_value_cache(handleInfo);
+
+    rbusValueCache_SetTTL(handleInfo->valueCache, elementName, ttl);
+    return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t rbus_regDataElements(
     rbusHandle_t handle,
     int numDataElements,
     rbusDataElement_t *elements)
 {
-    static bool sDisConnHandler = false;
     int i;
     rbusError_t rc = RBUS_ERROR_SUCCESS;
     rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode** nodes;
 
     VERIFY_NULL(handleInfo);
     VERIFY_NULL(elements);
     VERIFY_ZERO(numDataElements);
 
+    if(handleInfo->elementRoot == NULL)
+    {
+        RBUSLOG_DEBUG("First Time, create the root node for [%s]!", handleInfo->componentName);
+        handleInfo->elementRoot = getEmptyElementNode();
+        handleInfo->elementRoot->name = strdup(handleInfo->componentName);
+        RBUSLOG_DEBUG("Root node created for [%s]", handleInfo->elementRoot->name);
+    }
+
+    if(handleInfo->subscriptions == NULL)
+    {
+        rbusSubscriptions_create(&handleInfo->subscriptions, handle, handleInfo->componentName, handleInfo->elementRoot, rbusConfig_Get()->tmpDir);
+    }
+
+    /*the inserted nodes, so cached subscriptions can be resubscribed in one pass once all are registered*/
+    nodes = rt_malloc(numDataElements * sizeof(elementNode*));
+
     for(i=0; i<numDataElements; ++i)
     {
         char* name = elements[i].name;
@@ -2465,19 +3595,6 @@ rbusError_t rbus_regDataElements(
 
         RBUSLOG_DEBUG("%s: %s", __FUNCTION__, name);
 
-        if(handleInfo->elementRoot == NULL)
-        {
-            RBUSLOG_DEBUG("First Time, create the root node for [%s]!", handleInfo->componentName);
-            handleInfo->elementRoot = getEmptyElementNode();
-            handleInfo->elementRoot->name = strdup(handleInfo->componentName);
-            RBUSLOG_DEBUG("Root node created for [%s]", handleInfo->elementRoot->name);
-        }
-
-        if(handleInfo->subscriptions == NULL)
-        {
-            rbusSubscriptions_create(&handleInfo->subscriptions, handle, handleInfo->componentName, handleInfo->elementRoot, rbusConfig_Get()->tmpDir);
-        }
-
         if((err = rbus_addElement(handleInfo->componentName, name)) != RTMESSAGE_BUS_SUCCESS)
         {
             RBUSLOG_ERROR("%s: failed to add element with core [%s] err=%d!!", __FUNCTION__, name, err);
@@ -2486,8 +3603,7 @@ rbusError_t rbus_regDataElements(
         }
         else
         {
-            elementNode* node;
-            if((node = insertElement(handleInfo->elementRoot, &elements[i])) == NULL)
+            if((nodes[i] = insertElement(handleInfo->elementRoot, &elements[i])) == NULL)
             {
                 RBUSLOG_ERROR("%s: failed to insert element [%s]!!", __FUNCTION__, name);
                 rc = RBUS_ERROR_OUT_OF_RESOURCES;
@@ -2495,12 +3611,15 @@ rbusError_t rbus_regDataElements(
             }
             else
             {
-                rbusSubscriptions_resubscribeCache(handle, handleInfo->subscriptions, name, node);
                 RBUSLOG_INFO("%s inserted successfully!", name);
             }
         }
     }
 
+    if(rc == RBUS_ERROR_SUCCESS)
+        rbusSubscriptions_resubscribeCache(handle, handleInfo->subscriptions, numDataElements, elements, nodes);
+    free(nodes);
+
     /*TODO: need to review if this is how we should handle any failed register.
       To avoid a provider having a half registered data model, and to avoid
       the complexity of returning a list of error codes for each element in the list,
@@ -2512,16 +3631,8 @@ rbusError_t rbus_regDataElements(
     if(rc != RBUS_ERROR_SUCCESS && i > 0)
         rbus_unregDataElements(handle, i, elements);
 
-    if((rc == RBUS_ERROR_SUCCESS) && (!sDisConnHandler))
-    {
-        err = rbus_registerClientDisconnectHandler(_client_disconnect_callback_handler);
-        if(err != RTMESSAGE_BUS_SUCCESS)
-        {
-            RBUSLOG_ERROR("%s : rbus_registerClientDisconnectHandler error %d", __FUNCTION__, err);
-        }
-        else
-            sDisConnHandler = true;
-    }
+    if(rc == RBUS_ERROR_SUCCESS)
+        _register_client_disconnect_handler();
 
     return rc;
 }
@@ -2553,6 +3664,53 @@ rbusError_t rbus_unregDataElements(
         removeElement(&(handleInfo->elementRoot), name);
 */
     }
+
+    /*registration names can be table templates, so drop everything this component owns*/
+    rbusOwnerCache_RemoveOwner(handleInfo->componentName);
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbus_regGetMultiHandler(
+    rbusHandle_t handle,
+    char const* elementName,
+    rbusGetMultiHandler_t getMultiHandler)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* el;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(elementName);
+
+    el = retrieveElement(handleInfo->elementRoot, elementName);
+    if(!el)
+    {
+        RBUSLOG_WARN("%s: element not registered %s", __FUNCTION__, elementName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    el->getMultiHandler = getMultiHandler;
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbus_regSetMultiHandler(
+    rbusHandle_t handle,
+    char const* elementName,
+    rbusSetMultiHandler_t setMultiHandler)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* el;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(elementName);
+
+    el = retrieveElement(handleInfo->elementRoot, elementName);
+    if(!el)
+    {
+        RBUSLOG_WARN("%s: element not registered %s", __FUNCTION__, elementName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    el->setMultiHandler = setMultiHandler;
     return RBUS_ERROR_SUCCESS;
 }
 
@@ -2579,6 +3737,17 @@ rbusError_t rbus_discoverComponentName (rbusHandle_t handle,
     {
         *componentName = output;
         *numComponents = out_count;
+
+        /*refresh the owner cache while we have a full answer*/
+        if(out_count == numElements)
+        {
+            int i;
+            for(i = 0; i < numElements; ++i)
+            {
+                if(output[i] && output[i][0])
+                    rbusOwnerCache_Add(elementNames[i], output[i]);
+            }
+        }
     }
     else
     {
@@ -2588,6 +3757,101 @@ rbusError_t rbus_discoverComponentName (rbusHandle_t handle,
     return errorcode;
 }
 
+/*like rbus_discoverComponentName but taking what it can from the owner cache
+  and asking the broker only about the rest.  *cached is set if any owner came from the cache*/
+static rbusError_t _discover_component_names(rbusHandle_t handle,
+                            int numElements, char const** elementNames,
+                            int *numComponents, char ***componentNames, bool* cached)
+{
+    char** owners;
+    char const** missing;
+    int numMissing;
+    int numFound;
+    int i, j;
+    rbusError_t errorcode;
+
+    *cached = false;
+    *numComponents = 0;
+    *componentNames = NULL;
+
+    if(numElements < 1)
+        return rbus_discoverComponentName(handle, numElements, elementNames, numComponents, componentNames);
+
+    /*so owners learned here are dropped when their component disconnects*/
+    _register_client_disconnect_handler();
+
+    owners = rt_try_calloc(numElements, sizeof(char*));
+    if(!owners)
+        return rbus_discoverComponentName(handle, numElements, elementNames, numComponents, componentNames);
+
+    numFound = rbusOwnerCache_Lookup(numElements, elementNames, owners);
+    if(numFound == numElements)
+    {
+        *cached = true;
+        *componentNames = owners;
+        *numComponents = numElements;
+        return RBUS_ERROR_SUCCESS;
+    }
+    else if(numFound == 0)
+    {
+        free(owners);
+        return rbus_discoverComponentName(handle, numElements, elementNames, numComponents, componentNames);
+    }
+
+    numMissing = numElements - numFound;
+    missing = rt_try_malloc(numMissing * sizeof(char const*));
+    if(!missing)
+    {
+        for(i = 0; i < numElements; ++i)
+            free(owners[i]);
+        free(owners);
+        return rbus_discoverComponentName(handle, numElements, elementNames, numComponents, componentNames);
+    }
+    for(i = 0, j = 0; i < numElements; ++i)
+    {
+        if(!owners[i])
+            missing[j++] = elementNames[i];
+    }
+
+    /*merge the discovered owners into the cached ones, in name order*/
+    {
+        int numDiscovered = 0;
+        char** discovered = NULL;
+
+        errorcode = rbus_discoverComponentName(handle, numMissing, missing, &numDiscovered, &discovered);
+        if(errorcode == RBUS_ERROR_SUCCESS && numDiscovered == numMissing)
+        {
+            for(i = 0, j = 0; i < numElements; ++i)
+            {
+                if(!owners[i])
+                    owners[i] = discovered[j++];
+            }
+            *cached = true;
+            *componentNames = owners;
+            *numComponents = numElements;
+        }
+        else
+        {
+            for(i = 0; i < numDiscovered; ++i)
+                free(discovered[i]);
+            for(i = 0; i < numElements; ++i)
+                free(owners[i]);
+            free(owners);
+        }
+        free(discovered);
+    }
+    free(missing);
+    return errorcode;
+}
+
+/*errors that can mean a request was batched by a stale owner from the owner cache*/
+static bool _is_stale_owner_error(rbusError_t errorcode)
+{
+    return errorcode == RBUS_ERROR_ELEMENT_DOES_NOT_EXIST ||
+           errorcode == RBUS_ERROR_DESTINATION_NOT_FOUND ||
+           errorcode == RBUS_ERROR_DESTINATION_NOT_REACHABLE;
+}
+
 rbusError_t rbus_discoverComponentDataElements (rbusHandle_t handle,
                             char const* name, bool nextLevel,
                             int *numElements, char*** elementNames)
@@ -2617,6 +3881,7 @@ rbusError_t rbus_get(rbusHandle_t handle, char const* name, rbusValue_t* value)
     rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
     rbusMessage request, response;
     int ret = -1;
+    uint64_t cacheGeneration = 0;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*) handle;
 
     VERIFY_NULL(handleInfo);
@@ -2634,6 +3899,16 @@ rbusError_t rbus_get(rbusHandle_t handle, char const* name, rbusValue_t* value)
         return RBUS_ERROR_ACCESS_NOT_ALLOWED;
     }
 
+    if(handleInfo->valueCache)
+    {
+        if((*value = rbusValueCache_Get(handleInfo->valueCache, name)) != NULL)
+        {
+            RBUSLOG_DEBUG("%s %s from the value cache", __FUNCTION__, name);
+            return RBUS_ERROR_SUCCESS;
+        }
+        cacheGeneration = rbusValueCache_GetGeneration(handleInfo->valueCache);
+    }
+
     rbusMessage_Init(&request);
     /* Set the Component name that invokes the set */
     rbusMessage_SetString(request, handleInfo->componentName);
@@ -2643,7 +3918,7 @@ rbusError_t rbus_get(rbusHandle_t handle, char const* name, rbusValue_t* value)
 
     RBUSLOG_DEBUG("Calling rbus_invokeRemoteMethod for [%s]", name);
 
-    if((err = rbus_invokeRemoteMethod(name, METHOD_GETPARAMETERVALUES, request, rbusConfig_ReadGetTimeout(), &response)) != RTMESSAGE_BUS_SUCCESS)
+    if((err = rbus_invokeRemoteMethod(name, METHOD_GETPARAMETERVALUES, request, rbusConfig_GetTimeoutFor(handle, name), &response)) != RTMESSAGE_BUS_SUCCESS)
     {
         RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, name);
         errorcode = rbuscoreError_to_rbusError(err);
@@ -2675,6 +3950,8 @@ rbusError_t rbus_get(rbusHandle_t handle, char const* name, rbusValue_t* value)
                 if(buff && (strcmp(name, buff) == 0))
                 {
                     rbusValue_initFromMessage(value, response);
+                    if(handleInfo->valueCache)
+                        rbusValueCache_Put(handleInfo->valueCache, name, *value, cacheGeneration);
                 }
                 else
                 {
@@ -2697,27 +3974,157 @@ rbusError_t rbus_get(rbusHandle_t handle, char const* name, rbusValue_t* value)
     return errorcode;
 }
 
-rbusError_t _getExt_response_parser(rbusMessage response, int *numValues, rbusProperty_t* retProperties)
+/* A request to one component, sent by _invoke_remote_calls */
+typedef struct _rbusRemoteCall
 {
-    rbusError_t errorcode = RBUS_ERROR_SUCCESS;
-    rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
-    int numOfVals = 0;
-    int ret = -1;
-    int i = 0;
-    RBUSLOG_DEBUG("Received response for remote method invocation!");
+    char const*     objectName;     /* the name the request is routed by */
+    char const*     method;
+    rbusMessage     request;        /* consumed by rbus_invokeRemoteMethod */
+    int             timeout;
+    rbusMessage     response;
+    rbus_error_t    err;
+} rbusRemoteCall_t;
+
+#define RBUS_MAX_PARALLEL_CALLS 8
+
+/* The calls of one _invoke_remote_calls, shared with the helpers it queues on the async request threads.
+   A helper can run after the calls are done, so it is freed by whichever of them lets go of it last */
+typedef struct _rbusRemoteCalls
+{
+    rbusRemoteCall_t*   calls;
+    int                 count;
+    int                 next;       /* the next call to claim */
+    int                 done;       /* the calls completed */
+    int                 refs;       /* the caller, and each helper not yet run or canceled */
+    pthread_mutex_t     mutex;
+    pthread_cond_t      doneCond;
+} rbusRemoteCalls_t;
+
+static void _remote_calls_release(rbusRemoteCalls_t* rc)
+{
+    int refs;
 
-    rbusMessage_GetInt32(response, &ret);
+    pthread_mutex_lock(&rc->mutex);
+    refs = --rc->refs;
+    pthread_mutex_unlock(&rc->mutex);
+    if(refs == 0)
+    {
+        pthread_cond_destroy(&rc->doneCond);
+        pthread_mutex_destroy(&rc->mutex);
+        free(rc);
+    }
+}
+
+static void _remote_calls_work(rbusRemoteCalls_t* rc)
+{
+    int i;
+    while((i = __atomic_fetch_add(&rc->next, 1, __ATOMIC_RELAXED)) < rc->count)
+    {
+        rbusRemoteCall_t* call = &rc->calls[i];
+        call->response = NULL;
+        call->err = rbus_invokeRemoteMethod(call->objectName, call->method, call->request, call->timeout, &call->response);
+
+        pthread_mutex_lock(&rc->mutex);
+        if(++rc->done == rc->count)
+            pthread_cond_signal(&rc->doneCond);
+        pthread_mutex_unlock(&rc->mutex);
+    }
+}
+
+static void _remote_calls_helper_run(void* p)
+{
+    _remote_calls_work(p);
+    _remote_calls_release(p);
+}
+
+static void _remote_calls_helper_cancel(void* p, rbusError_t error)
+{
+    (void)error;
+    _remote_calls_release(p);
+}
+
+/* Sends each call's request and waits for all the responses.  When there's more than one call,
+   up to RBUS_MAX_PARALLEL_CALLS are in flight at once so the total wait is about that of the slowest
+   component rather than the sum of them.  The helpers run on the async request threads, which are
+   kept until the last handle is closed and bound how many run across all requests.  The calling thread
+   works too, so it only waits for the calls a helper already started.  The results are left in each
+   call, in the original order. */
+static void _invoke_remote_calls(rbusHandle_t handle, rbusRemoteCall_t* calls, int count)
+{
+    rbusRemoteCalls_t* rc;
+    int i;
+
+    if(count == 1 || !(rc = rt_try_malloc(sizeof(rbusRemoteCalls_t))))
+    {
+        for(i = 0; i < count; ++i)
+        {
+            calls[i].response = NULL;
+            calls[i].err = rbus_invokeRemoteMethod(calls[i].objectName, calls[i].method, calls[i].request, calls[i].timeout, &calls[i].response);
+        }
+        return;
+    }
+
+    rc->calls = calls;
+    rc->count = count;
+    rc->next = 0;
+    rc->done = 0;
+    rc->refs = 1;
+    pthread_mutex_init(&rc->mutex, NULL);
+    pthread_cond_init(&rc->doneCond, NULL);
+
+    for(i = 0; i < count-1 && i < RBUS_MAX_PARALLEL_CALLS-1; ++i)
+    {
+        pthread_mutex_lock(&rc->mutex);
+        rc->refs++;
+        pthread_mutex_unlock(&rc->mutex);
+        if(rbusAsyncRequest_Submit(handle, _remote_calls_helper_run, _remote_calls_helper_cancel, rc) != RBUS_ERROR_SUCCESS)
+        {
+            _remote_calls_release(rc);
+            break;
+        }
+    }
+
+    _remote_calls_work(rc);
+
+    pthread_mutex_lock(&rc->mutex);
+    while(rc->done < rc->count)
+        pthread_cond_wait(&rc->doneCond, &rc->mutex);
+    pthread_mutex_unlock(&rc->mutex);
+    _remote_calls_release(rc);
+}
+
+/* nextCursor, if not NULL, gets the cursor a paged get response ends with, or 0 if it has none */
+rbusError_t _getExt_response_parser(rbusMessage response, int *numValues, rbusProperty_t* retProperties, int32_t* nextCursor)
+{
+    rbusError_t errorcode = RBUS_ERROR_SUCCESS;
+    rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
+    int numOfVals = 0;
+    int ret = -1;
+    int i = 0;
+    RBUSLOG_DEBUG("Received response for remote method invocation!");
+
+    rbusMessage_GetInt32(response, &ret);
     RBUSLOG_DEBUG("Response from the remote method is [%d]!",ret);
 
     errorcode = (rbusError_t) ret;
     legacyRetCode = (rbusLegacyReturn_t) ret;
 
     *numValues = 0;
+    if(nextCursor)
+        *nextCursor = 0;
     if((errorcode == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
     {
         errorcode = RBUS_ERROR_SUCCESS;
         RBUSLOG_DEBUG("Received valid response!");
         rbusMessage_GetInt32(response, &numOfVals);
+        if(numOfVals == RBUS_PROPERTY_LIST_BLOB)
+        {
+            errorcode = rbusPropertyList_initFromBlobMessage(retProperties, numValues, response);
+            if(nextCursor && errorcode == RBUS_ERROR_SUCCESS && rbusMessage_GetInt32(response, nextCursor) != RT_OK)
+                *nextCursor = 0;
+            rbusMessage_Release(response);
+            return errorcode;
+        }
         *numValues = numOfVals;
         RBUSLOG_DEBUG("Number of return params = %d", numOfVals);
 
@@ -2742,6 +4149,8 @@ rbusError_t _getExt_response_parser(rbusMessage response, int *numValues, rbusPr
                 }
             }
         }
+        if(nextCursor && rbusMessage_GetInt32(response, nextCursor) != RT_OK)
+            *nextCursor = 0;
     }
     else
     {
@@ -2755,11 +4164,48 @@ rbusError_t _getExt_response_parser(rbusMessage response, int *numValues, rbusPr
     return errorcode;
 }
 
+/*answer a getExt from the value cache, but only if every name is a cached property*/
+static bool _getExt_from_value_cache(rbusValueCache_t cache, int paramCount, char const** pParamNames, int *numValues, rbusProperty_t* retProperties)
+{
+    rbusProperty_t first = NULL;
+    int i;
+
+    for(i = 0; i < paramCount; ++i)
+    {
+        rbusValue_t value;
+        rbusProperty_t prop;
+
+        if(_is_wildcard_query(pParamNames[i]) || (value = rbusValueCache_Get(cache, pParamNames[i])) == NULL)
+        {
+            if(first)
+                rbusProperty_Release(first);
+            return false;
+        }
+
+        rbusProperty_Init(&prop, pParamNames[i], value);
+        rbusValue_Release(value);
+        if(first)
+        {
+            rbusProperty_Append(first, prop);
+            rbusProperty_Release(prop);
+        }
+        else
+        {
+            first = prop;
+        }
+    }
+
+    *numValues = paramCount;
+    *retProperties = first;
+    return true;
+}
+
 rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParamNames, int *numValues, rbusProperty_t* retProperties)
 {
     rbusError_t errorcode = RBUS_ERROR_SUCCESS;
     rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
     int i;
+    uint64_t cacheGeneration = 0;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*) handle;
 
     VERIFY_NULL(handleInfo);
@@ -2786,10 +4232,17 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
             }
             else
             {
-                for(i = 0; i < numDestinations; i++)
+                rbusRemoteCall_t* calls = rt_try_calloc(numDestinations, sizeof(rbusRemoteCall_t));
+                *retProperties = NULL;
+                if(!calls)
                 {
-                    int tmpNumOfValues = 0;
-                    rbusMessage request, response;
+                    RBUSLOG_WARN("Failed to malloc %d calls", numDestinations);
+                    errorcode = RBUS_ERROR_OUT_OF_RESOURCES;
+                }
+
+                for(i = 0; calls && i < numDestinations; i++)
+                {
+                    rbusMessage request;
                     RBUSLOG_DEBUG("Destination %d is %s", i, destinations[i]);
 
                     /* Get the query sent to each component identified */
@@ -2798,55 +4251,59 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
                     rbusMessage_SetString(request, handleInfo->componentName);
                     rbusMessage_SetInt32(request, 1);
                     rbusMessage_SetString(request, pParamNames[0]);
-                    /* Invoke the method */
-                    if((err = rbus_invokeRemoteMethod(destinations[i], METHOD_GETPARAMETERVALUES, request, rbusConfig_ReadGetTimeout(), &response)) != RTMESSAGE_BUS_SUCCESS)
+                    rbusMessage_SetInt32(request, RBUS_GET_WIRE_VERSION);
+
+                    calls[i].objectName = destinations[i];
+                    calls[i].method = METHOD_GETPARAMETERVALUES;
+                    calls[i].request = request;
+                    calls[i].timeout = rbusConfig_GetTimeoutFor(handle, pParamNames[0]);
+                }
+
+                /* Invoke the method on every destination at once */
+                if(calls)
+                    _invoke_remote_calls(handle, calls, numDestinations);
+
+                /* Merge the responses in destination order */
+                for(i = 0; calls && i < numDestinations; i++)
+                {
+                    int tmpNumOfValues = 0;
+                    rbusProperty_t tmpProperties = NULL;
+
+                    if(errorcode != RBUS_ERROR_SUCCESS)
+                    {
+                        if(calls[i].err == RTMESSAGE_BUS_SUCCESS)
+                            rbusMessage_Release(calls[i].response);
+                        continue;
+                    }
+
+                    if((err = calls[i].err) != RTMESSAGE_BUS_SUCCESS)
                     {
                         RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, destinations[i]);
                         errorcode = rbuscoreError_to_rbusError(err);
                     }
-                    else
+                    else if((errorcode = _getExt_response_parser(calls[i].response, &tmpNumOfValues, &tmpProperties, NULL)) != RBUS_ERROR_SUCCESS)
                     {
-                        if (0 == i)
+                        RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
+                    }
+                    else if(tmpNumOfValues > 0 && tmpProperties)
+                    {
+                        if(last)
                         {
-                            if((errorcode = _getExt_response_parser(response, &tmpNumOfValues, retProperties)) != RBUS_ERROR_SUCCESS)
-                            {
-                                RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
-                            }
-                            else
-                            {
-                                if(tmpNumOfValues > 0)
-                                    last = *retProperties;
-                            }
+                            rbusProperty_SetNext(last, tmpProperties);
+                            rbusProperty_Release(tmpProperties);
                         }
                         else
                         {
-                            rbusProperty_t tmpProperties;
-
-                            if((errorcode = _getExt_response_parser(response, &tmpNumOfValues, &tmpProperties)) != RBUS_ERROR_SUCCESS)
-                            {
-                                RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
-                            }
-                            else
-                            {
-                                if(tmpNumOfValues > 0 && tmpProperties)
-                                {
-                                    if(NULL != last)
-                                    {
-                                        rbusProperty_Append(last, tmpProperties);
-                                    }
-                                    else
-                                    {
-                                        last = tmpProperties;
-                                        *retProperties = last;
-                                    }
-                                }
-                            }
+                            *retProperties = tmpProperties;
                         }
+                        /*keep track of the tail so appending stays linear*/
+                        for(last = tmpProperties; rbusProperty_GetNext(last); last = rbusProperty_GetNext(last))
+                            ;
                     }
+
                     if (errorcode != RBUS_ERROR_SUCCESS)
                     {
                         RBUSLOG_WARN("Failed to get the data from %s Component", destinations[i]);
-                        break;
                     }
                     else
                     {
@@ -2854,6 +4311,8 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
                     }
                 }
 
+                free(calls);
+
                 for(i = 0; i < numDestinations; i++)
                     free(destinations[i]);
                 free(destinations);
@@ -2868,13 +4327,33 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
         }
     }
 
+    if(handleInfo->valueCache)
     {
-        rbusMessage request, response;
+        if(_getExt_from_value_cache(handleInfo->valueCache, paramCount, pParamNames, numValues, retProperties))
+        {
+            RBUSLOG_DEBUG("%s %d params from the value cache", __FUNCTION__, paramCount);
+            return RBUS_ERROR_SUCCESS;
+        }
+        cacheGeneration = rbusValueCache_GetGeneration(handleInfo->valueCache);
+    }
+
+    bool ownersCached = false;
+    bool rediscovered = false;
+
+discover:
+    {
+        rbusMessage request;
         int numComponents;
         char** componentNames = NULL;
+        rbusRemoteCall_t* calls = NULL;
+        int numCalls = 0;
+        rbusProperty_t last = NULL;
 
         /*discover which components have some ownership of the params in the list*/
-        errorcode = rbus_discoverComponentName(handle, paramCount, pParamNames, &numComponents, &componentNames);
+        if(rediscovered)
+            errorcode = rbus_discoverComponentName(handle, paramCount, pParamNames, &numComponents, &componentNames);
+        else
+            errorcode = _discover_component_names(handle, paramCount, pParamNames, &numComponents, &componentNames, &ownersCached);
         if(errorcode == RBUS_ERROR_SUCCESS && paramCount == numComponents)
         {
 #if 0
@@ -2902,8 +4381,18 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
             *retProperties = NULL;/*NULL to mark first batch*/
             *numValues = 0;
 
+            /*there can't be more batches than params*/
+            calls = rt_try_calloc(paramCount, sizeof(rbusRemoteCall_t));
+            if(!calls)
+            {
+                RBUSLOG_WARN("Failed to malloc %d calls", paramCount);
+                errorcode = RBUS_ERROR_OUT_OF_RESOURCES;
+                for(i = 0; i < paramCount; ++i)
+                    free(componentNames[i]);
+            }
+
             /*batch by component*/
-            for(;;)
+            while(calls)
             {
                 char* componentName = NULL;
                 char const* firstParamName = NULL;
@@ -2947,45 +4436,69 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
                             componentNames[i] = NULL;
                         }
                     }                  
+                    rbusMessage_SetInt32(request, RBUS_GET_WIRE_VERSION);
 
-                    RBUSLOG_DEBUG("%s sending batch request with %d params to component %s", __FUNCTION__, batchCount, componentName);
+                    RBUSLOG_DEBUG("%s queuing batch request with %d params to component %s", __FUNCTION__, batchCount, componentName);
                     free(componentName);
 
-                    if((err = rbus_invokeRemoteMethod(firstParamName, METHOD_GETPARAMETERVALUES, request, rbusConfig_ReadGetTimeout(), &response)) != RTMESSAGE_BUS_SUCCESS)
-                    {
-                        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, firstParamName);
-                        errorcode = rbuscoreError_to_rbusError(err);
-                        break;
-                    }
-                    else
+                    calls[numCalls].objectName = firstParamName;
+                    calls[numCalls].method = METHOD_GETPARAMETERVALUES;
+                    calls[numCalls].request = request;
+                    calls[numCalls].timeout = rbusConfig_GetTimeoutFor(handle, firstParamName);
+                    numCalls++;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            /*send every batch at once and merge the responses in batch order*/
+            if(numCalls > 0)
+                _invoke_remote_calls(handle, calls, numCalls);
+
+            for(i = 0; i < numCalls; ++i)
+            {
+                rbusProperty_t batchResult = NULL;
+                int batchNumVals = 0;
+
+                if(errorcode != RBUS_ERROR_SUCCESS)
+                {
+                    if(calls[i].err == RTMESSAGE_BUS_SUCCESS)
+                        rbusMessage_Release(calls[i].response);
+                    continue;
+                }
+
+                if((err = calls[i].err) != RTMESSAGE_BUS_SUCCESS)
+                {
+                    RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, calls[i].objectName);
+                    errorcode = rbuscoreError_to_rbusError(err);
+                }
+                else if((errorcode = _getExt_response_parser(calls[i].response, &batchNumVals, &batchResult, NULL)) != RBUS_ERROR_SUCCESS)
+                {
+                    RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
+                }
+                else
+                {
+                    RBUSLOG_DEBUG("%s got valid response", __FUNCTION__);
+                    if(batchResult)
                     {
-                        rbusProperty_t batchResult;
-                        int batchNumVals;
-                        if((errorcode = _getExt_response_parser(response, &batchNumVals, &batchResult)) != RBUS_ERROR_SUCCESS)
+                        if(*retProperties == NULL) /*first batch*/
                         {
-                            RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
+                            *retProperties = batchResult;
                         }
-                        else
+                        else /*append subsequent batches*/
                         {
-                            RBUSLOG_DEBUG("%s got valid response", __FUNCTION__);
-                            if(*retProperties == NULL) /*first batch*/
-                            {
-                                *retProperties = batchResult;
-                            }
-                            else /*append subsequent batches*/
-                            {
-                                rbusProperty_Append(*retProperties, batchResult);
-                                rbusProperty_Release(batchResult);
-                            }
-                            *numValues += batchNumVals;
+                            rbusProperty_SetNext(last, batchResult);
+                            rbusProperty_Release(batchResult);
                         }
+                        for(last = batchResult; rbusProperty_GetNext(last); last = rbusProperty_GetNext(last))
+                            ;
                     }
-                }
-                else
-                {
-                    break;
+                    *numValues += batchNumVals;
                 }
             }
+            free(calls);
         }
         else
         {
@@ -2994,10 +4507,196 @@ rbusError_t rbus_getExt(rbusHandle_t handle, int paramCount, char const** pParam
         }
         if(componentNames)
             free(componentNames);
+
+        if(errorcode == RBUS_ERROR_SUCCESS && handleInfo->valueCache)
+        {
+            rbusProperty_t prop;
+            for(prop = *retProperties; prop; prop = rbusProperty_GetNext(prop))
+                rbusValueCache_Put(handleInfo->valueCache, rbusProperty_GetName(prop), rbusProperty_GetValue(prop), cacheGeneration);
+        }
+    }
+
+    /*an owner may have unregistered or moved since it was cached, so ask the broker again, once*/
+    if(ownersCached && !rediscovered && _is_stale_owner_error(errorcode))
+    {
+        RBUSLOG_DEBUG("%s retrying with rediscovered owners after error %d", __FUNCTION__, errorcode);
+        for(i = 0; i < paramCount; ++i)
+            rbusOwnerCache_Remove(pParamNames[i]);
+        if(*retProperties)
+        {
+            rbusProperty_Release(*retProperties);
+            *retProperties = NULL;
+        }
+        *numValues = 0;
+        rediscovered = true;
+        goto discover;
     }
     return errorcode;
 }
 
+rbusError_t rbus_getPage(
+    rbusHandle_t handle,
+    char const* query,
+    uint32_t pageSize,
+    uint32_t* cursor,
+    int* numValues,
+    rbusProperty_t* properties)
+{
+    rbusError_t errorcode = RBUS_ERROR_SUCCESS;
+    rbus_error_t err = RTMESSAGE_BUS_SUCCESS;
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    int numDestinations = 0;
+    char** destinations = NULL;
+    uint32_t dest, offset;
+    int i;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(query);
+    VERIFY_NULL(cursor);
+    VERIFY_NULL(numValues);
+    VERIFY_NULL(properties);
+    VERIFY_ZERO(pageSize);
+
+    *numValues = 0;
+    *properties = NULL;
+
+    if(!_is_wildcard_query(query))
+    {
+        RBUSLOG_WARN("%s %s is not a wildcard or partial path query", __FUNCTION__, query);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    if(pageSize > RBUS_GET_CURSOR_OFFSET_MASK / 2)
+        pageSize = RBUS_GET_CURSOR_OFFSET_MASK / 2;
+
+    err = rbus_discoverWildcardDestinations(query, &numDestinations, &destinations);
+    if(err != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_DEBUG("Query for expression %s was not successful.", query);
+        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+    }
+
+    /* a destination index past the cursor's top bits would wrap to 0, which ends the paging */
+    if((uint32_t)numDestinations > RBUS_GET_CURSOR_MAX_DESTS)
+    {
+        RBUSLOG_ERROR("%s %s has too many destinations (%d) to page through", __FUNCTION__, query, numDestinations);
+        for(i = 0; i < numDestinations; i++)
+            free(destinations[i]);
+        free(destinations);
+        return RBUS_ERROR_OUT_OF_RESOURCES;
+    }
+
+    /* The cursor holds the index of the destination in its top bits and the offset into its results in the rest.
+       Without destinations the query is a table of a single component, which is reached by the query name */
+    dest = *cursor >> RBUS_GET_CURSOR_DEST_SHIFT;
+    offset = *cursor & RBUS_GET_CURSOR_OFFSET_MASK;
+    *cursor = 0;
+
+    for(; dest < (uint32_t)(numDestinations ? numDestinations : 1); dest++, offset = 0)
+    {
+        rbusMessage request, response;
+        int32_t next = 0;
+        char const* objectName = numDestinations ? destinations[dest] : query;
+
+        rbusMessage_Init(&request);
+        rbusMessage_SetString(request, handleInfo->componentName);
+        rbusMessage_SetInt32(request, 1);
+        rbusMessage_SetString(request, query);
+        rbusMessage_SetInt32(request, RBUS_GET_PAGED_WIRE_VERSION);
+        rbusMessage_SetInt32(request, (int32_t)offset);
+        rbusMessage_SetInt32(request, (int32_t)pageSize);
+
+        RBUSLOG_DEBUG("%s %s page at %u from %s", __FUNCTION__, query, offset, objectName);
+
+        if((err = rbus_invokeRemoteMethod(objectName, METHOD_GETPARAMETERVALUES, request, rbusConfig_GetTimeoutFor(handle, query), &response)) != RTMESSAGE_BUS_SUCCESS)
+        {
+            RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, objectName);
+            errorcode = rbuscoreError_to_rbusError(err);
+            break;
+        }
+
+        if((errorcode = _getExt_response_parser(response, numValues, properties, &next)) != RBUS_ERROR_SUCCESS)
+        {
+            RBUSLOG_ERROR("%s error parsing response %d", __FUNCTION__, errorcode);
+            break;
+        }
+
+        if(next > 0)
+        {
+            if((uint32_t)next > RBUS_GET_CURSOR_OFFSET_MASK)
+            {
+                RBUSLOG_ERROR("%s %s has too many results to page through", __FUNCTION__, query);
+                rbusProperty_Release(*properties);
+                *properties = NULL;
+                errorcode = RBUS_ERROR_OUT_OF_RESOURCES;
+                break;
+            }
+            *cursor = (dest << RBUS_GET_CURSOR_DEST_SHIFT) | (uint32_t)next;
+            break;
+        }
+
+        /* this destination is done; an empty page moves straight on to the next one */
+        if(*numValues > 0)
+        {
+            if(dest + 1 < (uint32_t)numDestinations)
+                *cursor = (dest + 1) << RBUS_GET_CURSOR_DEST_SHIFT;
+            break;
+        }
+        if(*properties)
+        {
+            rbusProperty_Release(*properties);
+            *properties = NULL;
+        }
+    }
+
+    if(errorcode != RBUS_ERROR_SUCCESS)
+    {
+        *numValues = 0;
+        *cursor = 0;
+    }
+
+    for(i = 0; i < numDestinations; i++)
+        free(destinations[i]);
+    if(numDestinations)
+        free(destinations);
+
+    return errorcode;
+}
+
+rbusError_t rbus_getStream(
+    rbusHandle_t handle,
+    char const* query,
+    uint32_t pageSize,
+    rbusGetPageHandler_t handler,
+    void* userData)
+{
+    rbusError_t errorcode;
+    uint32_t cursor = 0;
+
+    VERIFY_NULL(handler);
+
+    do
+    {
+        int numValues = 0;
+        rbusProperty_t properties = NULL;
+        bool more;
+
+        errorcode = rbus_getPage(handle, query, pageSize, &cursor, &numValues, &properties);
+        if(errorcode != RBUS_ERROR_SUCCESS)
+            break;
+
+        more = handler(handle, query, numValues, properties, userData);
+
+        if(properties)
+            rbusProperty_Release(properties);
+
+        if(!more)
+            break;
+    } while(cursor != 0);
+
+    return errorcode;
+}
+
 static rbusError_t rbus_getByType(rbusHandle_t handle, char const* paramName, void* paramVal, rbusValueType_t type)
 {
     rbusError_t errorcode = RBUS_ERROR_INVALID_INPUT;
@@ -3096,7 +4795,7 @@ rbusError_t rbus_set(rbusHandle_t handle, char const* name,rbusValue_t value, rb
     /* Set the Commit value; FIXME: Should we use string? */
     rbusMessage_SetString(setRequest, (!opts || opts->commit) ? "TRUE" : "FALSE");
 
-    if((err = rbus_invokeRemoteMethod(name, METHOD_SETPARAMETERVALUES, setRequest, rbusConfig_ReadSetTimeout(), &setResponse)) != RTMESSAGE_BUS_SUCCESS)
+    if((err = rbus_invokeRemoteMethod(name, METHOD_SETPARAMETERVALUES, setRequest, rbusConfig_SetTimeoutFor(handle, name), &setResponse)) != RTMESSAGE_BUS_SUCCESS)
     {
         RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, name);
         errorcode = rbuscoreError_to_rbusError(err);
@@ -3130,6 +4829,11 @@ rbusError_t rbus_set(rbusHandle_t handle, char const* name,rbusValue_t value, rb
         /* Release the reponse message */
         rbusMessage_Release(setResponse);
     }
+
+    /*drop the cached value even if the set failed, since the provider may have changed it anyway*/
+    if(handleInfo->valueCache)
+        rbusValueCache_Invalidate(handleInfo->valueCache, name);
+
     return errorcode;
 }
 
@@ -3141,6 +4845,8 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
     struct _rbusHandle* handleInfo = (struct _rbusHandle*) handle;
     rbusValueType_t type = RBUS_NONE;
     rbusProperty_t current;
+    rbusRemoteCall_t* calls = NULL;
+    int numCalls = 0;
 
     VERIFY_NULL(handle);
 
@@ -3149,6 +4855,7 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
         char const** pParamNames;
         int numComponents;
         char** componentNames = NULL;
+        bool ownersCached = false;
         int i;
 
         /*create list of paramNames to pass to rbus_discoverComponentName*/
@@ -3180,7 +4887,7 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
         }
 
         /*discover which components have some ownership of the params*/
-        errorcode = rbus_discoverComponentName(handle, numProps, pParamNames, &numComponents, &componentNames);
+        errorcode = _discover_component_names(handle, numProps, pParamNames, &numComponents, &componentNames, &ownersCached);
         if(errorcode == RBUS_ERROR_SUCCESS && numProps == numComponents)
         {
 #if 0
@@ -3206,7 +4913,17 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
                 return RBUS_ERROR_INVALID_INPUT;
             }
 
-            for(;;)
+            /*there can't be more batches than properties*/
+            calls = rt_try_calloc(numProps, sizeof(rbusRemoteCall_t));
+            if(!calls)
+            {
+                RBUSLOG_WARN("Failed to malloc %d calls", numProps);
+                errorcode = RBUS_ERROR_OUT_OF_RESOURCES;
+                for(i = 0; i < numProps; ++i)
+                    free(componentNames[i]);
+            }
+
+            while(calls)
             {
                 char* componentName = NULL;
                 char const* firstParamName = NULL;
@@ -3266,47 +4983,66 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
                     /* Set the Commit value; FIXME: Should we use string? */
                     rbusMessage_SetString(setRequest, (!opts || opts->commit) ? "TRUE" : "FALSE");
 
-                    if((err = rbus_invokeRemoteMethod(firstParamName, METHOD_SETPARAMETERVALUES, setRequest, rbusConfig_ReadSetTimeout(), &setResponse)) != RTMESSAGE_BUS_SUCCESS)
+                    calls[numCalls].objectName = firstParamName;
+                    calls[numCalls].method = METHOD_SETPARAMETERVALUES;
+                    calls[numCalls].request = setRequest;
+                    calls[numCalls].timeout = rbusConfig_SetTimeoutFor(handle, firstParamName);
+                    numCalls++;
+                    free(componentName);
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            /*send every batch at once then check the responses in batch order, reporting the first failure*/
+            if(numCalls > 0)
+                _invoke_remote_calls(handle, calls, numCalls);
+
+            for(i = 0; i < numCalls; ++i)
+            {
+                rbusError_t batchError;
+
+                if((err = calls[i].err) != RTMESSAGE_BUS_SUCCESS)
+                {
+                    RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, calls[i].objectName);
+                    batchError = rbuscoreError_to_rbusError(err);
+                }
+                else
+                {
+                    char const* pErrorReason = NULL;
+                    rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
+                    int ret = -1;
+                    setResponse = calls[i].response;
+                    rbusMessage_GetInt32(setResponse, &ret);
+
+                    RBUSLOG_DEBUG("Response from the remote method is [%d]!", ret);
+                    batchError = (rbusError_t) ret;
+                    legacyRetCode = (rbusLegacyReturn_t) ret;
+
+                    if((batchError == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
                     {
-                        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, firstParamName);
-                        errorcode = rbuscoreError_to_rbusError(err);
+                        batchError = RBUS_ERROR_SUCCESS;
+                        RBUSLOG_DEBUG("Successfully Set the Value");
                     }
                     else
                     {
-                        char const* pErrorReason = NULL;
-                        rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
-                        int ret = -1;
-                        rbusMessage_GetInt32(setResponse, &ret);
-
-                        RBUSLOG_DEBUG("Response from the remote method is [%d]!", ret);
-                        errorcode = (rbusError_t) ret;
-                        legacyRetCode = (rbusLegacyReturn_t) ret;
-
-                        if((errorcode == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
+                        rbusMessage_GetString(setResponse, &pErrorReason);
+                        RBUSLOG_WARN("Failed to Set the Value for %s", pErrorReason);
+                        if(legacyRetCode > RBUS_LEGACY_ERR_SUCCESS)
                         {
-                            errorcode = RBUS_ERROR_SUCCESS;
-                            RBUSLOG_DEBUG("Successfully Set the Value");
-                        }
-                        else
-                        {
-                            rbusMessage_GetString(setResponse, &pErrorReason);
-                            RBUSLOG_WARN("Failed to Set the Value for %s", pErrorReason);
-                            if(legacyRetCode > RBUS_LEGACY_ERR_SUCCESS)
-                            {
-                                errorcode = CCSPError_to_rbusError(legacyRetCode);
-                            }
+                            batchError = CCSPError_to_rbusError(legacyRetCode);
                         }
-
-                        /* Release the reponse message */
-                        rbusMessage_Release(setResponse);
                     }
-                    free(componentName);
-                }
-                else
-                {
-                    break;
+
+                    /* Release the reponse message */
+                    rbusMessage_Release(setResponse);
                 }
+                if(errorcode == RBUS_ERROR_SUCCESS)
+                    errorcode = batchError;
             }
+            free(calls);
         }
         else
         {
@@ -3321,6 +5057,17 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
                 }
             }
         }
+        if(handleInfo->valueCache)
+        {
+            for(i = 0; i < numProps; ++i)
+                rbusValueCache_Invalidate(handleInfo->valueCache, pParamNames[i]);
+        }
+        /*a set isn't retried, but the next one shouldn't be batched by a stale owner*/
+        if(ownersCached && _is_stale_owner_error(errorcode))
+        {
+            for(i = 0; i < numProps; ++i)
+                rbusOwnerCache_Remove(pParamNames[i]);
+        }
         if(pParamNames)
             free(pParamNames);
         if(componentNames)
@@ -3329,6 +5076,222 @@ rbusError_t rbus_setMulti(rbusHandle_t handle, int numProps, rbusProperty_t prop
     return errorcode;
 }
 
+//************************* Asynchronous get and set ******************************//
+typedef struct _rbusGetAsyncRequest
+{
+    rbusHandle_t handle;
+    char* name;
+    rbusGetAsyncHandler_t callback;
+    void* userData;
+} rbusGetAsyncRequest_t;
+
+static void _get_async_run(void* p)
+{
+    rbusGetAsyncRequest_t* req = p;
+    rbusValue_t value = NULL;
+    rbusError_t err;
+
+    err = rbus_get(req->handle, req->name, &value);
+    req->callback(req->handle, req->name, err, err == RBUS_ERROR_SUCCESS ? value : NULL, req->userData);
+
+    if(err == RBUS_ERROR_SUCCESS && value)
+        rbusValue_Release(value);
+    free(req->name);
+    free(req);
+}
+
+static void _get_async_cancel(void* p, rbusError_t error)
+{
+    rbusGetAsyncRequest_t* req = p;
+    req->callback(req->handle, req->name, error, NULL, req->userData);
+    free(req->name);
+    free(req);
+}
+
+rbusError_t rbus_getAsync(
+    rbusHandle_t handle,
+    char const* name,
+    rbusGetAsyncHandler_t callback,
+    void* userData)
+{
+    rbusGetAsyncRequest_t* req;
+    rbusError_t err;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(name);
+    VERIFY_NULL(callback);
+
+    if(!_is_valid_get_query(name) || _is_wildcard_query(name))
+    {
+        RBUSLOG_WARN("%s %s is not a parameter name", __FUNCTION__, name);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    req = rt_malloc(sizeof(rbusGetAsyncRequest_t));
+    req->handle = handle;
+    req->name = strdup(name);
+    req->callback = callback;
+    req->userData = userData;
+
+    if((err = rbusAsyncRequest_Submit(handle, _get_async_run, _get_async_cancel, req)) != RBUS_ERROR_SUCCESS)
+    {
+        free(req->name);
+        free(req);
+    }
+    return err;
+}
+
+typedef struct _rbusGetExtAsyncRequest
+{
+    rbusHandle_t handle;
+    int paramCount;
+    char** paramNames;
+    rbusGetExtAsyncHandler_t callback;
+    void* userData;
+} rbusGetExtAsyncRequest_t;
+
+static void _getExt_async_free(rbusGetExtAsyncRequest_t* req)
+{
+    int i;
+    for(i = 0; i < req->paramCount; ++i)
+        free(req->paramNames[i]);
+    free(req->paramNames);
+    free(req);
+}
+
+static void _getExt_async_run(void* p)
+{
+    rbusGetExtAsyncRequest_t* req = p;
+    rbusProperty_t properties = NULL;
+    int numProps = 0;
+    rbusError_t err;
+
+    err = rbus_getExt(req->handle, req->paramCount, (char const**)req->paramNames, &numProps, &properties);
+    if(err != RBUS_ERROR_SUCCESS)
+    {
+        /*rbus_getExt can leave the results before the failure behind*/
+        if(properties)
+            rbusProperty_Release(properties);
+        properties = NULL;
+        numProps = 0;
+    }
+    req->callback(req->handle, err, numProps, properties, req->userData);
+
+    if(properties)
+        rbusProperty_Release(properties);
+    _getExt_async_free(req);
+}
+
+static void _getExt_async_cancel(void* p, rbusError_t error)
+{
+    rbusGetExtAsyncRequest_t* req = p;
+    req->callback(req->handle, error, 0, NULL, req->userData);
+    _getExt_async_free(req);
+}
+
+rbusError_t rbus_getExtAsync(
+    rbusHandle_t handle,
+    int paramCount,
+    char const** paramNames,
+    rbusGetExtAsyncHandler_t callback,
+    void* userData)
+{
+    rbusGetExtAsyncRequest_t* req;
+    rbusError_t err;
+    int i;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(paramNames);
+    VERIFY_NULL(callback);
+    VERIFY_ZERO(paramCount);
+
+    for(i = 0; i < paramCount; ++i)
+        VERIFY_NULL(paramNames[i]);
+
+    req = rt_malloc(sizeof(rbusGetExtAsyncRequest_t));
+    req->handle = handle;
+    req->paramCount = paramCount;
+    req->paramNames = rt_malloc(paramCount * sizeof(char*));
+    for(i = 0; i < paramCount; ++i)
+        req->paramNames[i] = strdup(paramNames[i]);
+    req->callback = callback;
+    req->userData = userData;
+
+    if((err = rbusAsyncRequest_Submit(handle, _getExt_async_run, _getExt_async_cancel, req)) != RBUS_ERROR_SUCCESS)
+        _getExt_async_free(req);
+    return err;
+}
+
+typedef struct _rbusSetAsyncRequest
+{
+    rbusHandle_t handle;
+    char* name;
+    rbusValue_t value;
+    bool hasOpts;
+    rbusSetOptions_t opts;
+    rbusSetAsyncHandler_t callback;
+    void* userData;
+} rbusSetAsyncRequest_t;
+
+static void _set_async_free(rbusSetAsyncRequest_t* req)
+{
+    rbusValue_Release(req->value);
+    free(req->name);
+    free(req);
+}
+
+static void _set_async_run(void* p)
+{
+    rbusSetAsyncRequest_t* req = p;
+    rbusError_t err;
+
+    err = rbus_set(req->handle, req->name, req->value, req->hasOpts ? &req->opts : NULL);
+    req->callback(req->handle, req->name, err, req->userData);
+    _set_async_free(req);
+}
+
+static void _set_async_cancel(void* p, rbusError_t error)
+{
+    rbusSetAsyncRequest_t* req = p;
+    req->callback(req->handle, req->name, error, req->userData);
+    _set_async_free(req);
+}
+
+rbusError_t rbus_setAsync(
+    rbusHandle_t handle,
+    char const* name,
+    rbusValue_t value,
+    rbusSetOptions_t* opts,
+    rbusSetAsyncHandler_t callback,
+    void* userData)
+{
+    rbusSetAsyncRequest_t* req;
+    rbusError_t err;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(name);
+    VERIFY_NULL(value);
+    VERIFY_NULL(callback);
+
+    if(RBUS_NONE == rbusValue_GetType(value))
+        return RBUS_ERROR_INVALID_INPUT;
+
+    req = rt_malloc(sizeof(rbusSetAsyncRequest_t));
+    req->handle = handle;
+    req->name = strdup(name);
+    rbusValue_Retain(value);
+    req->value = value;
+    req->hasOpts = opts != NULL;
+    if(opts)
+        req->opts = *opts;
+    req->callback = callback;
+    req->userData = userData;
+
+    if((err = rbusAsyncRequest_Submit(handle, _set_async_run, _set_async_cancel, req)) != RBUS_ERROR_SUCCESS)
+        _set_async_free(req);
+    return err;
+}
+
 #if 0
 rbusError_t rbus_setMulti(rbusHandle_t handle, int numValues,
         char const** valueNames, rbusValue_t* values, rbusSetOptions_t* opts)
@@ -3507,7 +5470,7 @@ rbusError_t rbusTable_addRow(
                      because the broker simlpy looks at the top level nodes that are owned by a component route.  maybe this breaks if the broker changes*/
         METHOD_ADDTBLROW, 
         request, 
-        rbusConfig_ReadSetTimeout(),
+        rbusConfig_SetTimeoutFor(handle, tableName),
         &response)) != RTMESSAGE_BUS_SUCCESS)
     {
         RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, tableName);
@@ -3536,64 +5499,291 @@ rbusError_t rbusTable_addRow(
                 returnCode = CCSPError_to_rbusError(legacyRetCode);
             }
         }
-        rbusMessage_Release(response);
+        rbusMessage_Release(response);
+    }
+
+    return returnCode;
+}
+
+rbusError_t rbusTable_removeRow(
+    rbusHandle_t handle,
+    char const* rowName)
+{
+    rbus_error_t err;
+    int returnCode = 0;
+    rbusMessage request, response;
+    (void)handle;
+    rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(rowName);
+
+    RBUSLOG_DEBUG("%s: %s", __FUNCTION__, rowName);
+
+    rbusMessage_Init(&request);
+    rbusMessage_SetInt32(request, 0);/*TODO: this should be the session ID*/
+    rbusMessage_SetString(request, rowName);/*TODO: do we need to append the name as well as pass the name as the 1st arg to rbus_invokeRemoteMethod ?*/
+
+    if((err = rbus_invokeRemoteMethod(
+        rowName,
+        METHOD_DELETETBLROW, 
+        request, 
+        rbusConfig_SetTimeoutFor(handle, rowName),
+        &response)) != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, rowName);
+        return rbuscoreError_to_rbusError(err);
+    }
+    else
+    {
+        rbusMessage_GetInt32(response, &returnCode);
+        legacyRetCode = (rbusLegacyReturn_t)returnCode;
+
+        RBUSLOG_INFO("%s rbus_invokeRemoteMethod success response returnCode:%d", __FUNCTION__, returnCode);
+        if((returnCode == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
+        {
+            returnCode = RBUS_ERROR_SUCCESS;
+            RBUSLOG_DEBUG("Successfully Set the Value");
+        }
+        else
+        {
+            RBUSLOG_WARN("Response from remote method indicates the call failed!!");
+            if(legacyRetCode > RBUS_LEGACY_ERR_SUCCESS)
+            {
+                returnCode = CCSPError_to_rbusError(legacyRetCode);
+            }
+        }
+        rbusMessage_Release(response);
+    }
+
+    return returnCode;
+}
+
+/*convert the result of a table row request the same way rbusTable_addRow does*/
+static rbusError_t _table_row_result(int returnCode)
+{
+    rbusLegacyReturn_t legacyRetCode = (rbusLegacyReturn_t)returnCode;
+
+    if((returnCode == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
+        return RBUS_ERROR_SUCCESS;
+    if(legacyRetCode > RBUS_LEGACY_ERR_SUCCESS)
+        return CCSPError_to_rbusError(legacyRetCode);
+    return (rbusError_t)returnCode;
+}
+
+rbusError_t rbusTable_addRows(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    char const* const* aliasNames,
+    uint32_t* instNums)
+{
+    rbus_error_t err;
+    rbusError_t result = RBUS_ERROR_SUCCESS;
+    int returnCode = 0;
+    int32_t instanceId = 0;
+    int version = 0;
+    int numReplied = 0;
+    int first = 1;
+    int i;
+    rbusMessage request, response;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(tableName);
+    VERIFY_NULL(instNums);
+
+    RBUSLOG_DEBUG("%s: %s %d", __FUNCTION__, tableName, numRows);
+
+    if(numRows <= 0 || tableName[strlen(tableName)-1] != '.')
+    {
+        RBUSLOG_WARN("%s invalid table name %s or numRows %d", __FUNCTION__, tableName, numRows);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    memset(instNums, 0, numRows * sizeof(uint32_t));
+
+    /*the first row goes where rbusTable_addRow puts it so older providers still add it*/
+    rbusMessage_Init(&request);
+    rbusMessage_SetInt32(request, 0);/*TODO: this should be the session ID*/
+    rbusMessage_SetString(request, tableName);
+    rbusMessage_SetString(request, (aliasNames && aliasNames[0]) ? aliasNames[0] : "");
+    rbusMessage_SetInt32(request, RBUS_TABLE_ROWS_WIRE_VERSION);
+    rbusMessage_SetInt32(request, numRows);
+    for(i = 0; i < numRows; ++i)
+        rbusMessage_SetString(request, (aliasNames && aliasNames[i]) ? aliasNames[i] : "");
+
+    if((err = rbus_invokeRemoteMethod(
+        tableName,
+        METHOD_ADDTBLROW, 
+        request, 
+        rbusConfig_SetTimeoutFor(handle, tableName),
+        &response)) != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, tableName);
+        return rbuscoreError_to_rbusError(err);
+    }
+
+    rbusMessage_GetInt32(response, &returnCode);
+    rbusMessage_GetInt32(response, &instanceId);
+    result = _table_row_result(returnCode);
+
+    if(rbusMessage_GetInt32(response, &version) == RT_OK && version >= RBUS_TABLE_ROWS_WIRE_VERSION &&
+       rbusMessage_GetInt32(response, &numReplied) == RT_OK && numReplied == numRows)
+    {
+        for(i = 0; i < numRows; ++i)
+        {
+            rbusMessage_GetInt32(response, &instanceId);
+            instNums[i] = (uint32_t)instanceId;
+        }
+        first = numRows;
+    }
+    else
+    {
+        /*older provider: only the first row was added*/
+        instNums[0] = result == RBUS_ERROR_SUCCESS ? (uint32_t)instanceId : 0;
+    }
+    rbusMessage_Release(response);
+
+    RBUSLOG_INFO("%s rbus_invokeRemoteMethod success response returnCode:%d rows handled:%d", __FUNCTION__, returnCode, first);
+
+    for(i = first; i < numRows; ++i)
+    {
+        rbusError_t rc = rbusTable_addRow(handle, tableName, aliasNames ? aliasNames[i] : NULL, &instNums[i]);
+        if(rc != RBUS_ERROR_SUCCESS)
+        {
+            instNums[i] = 0;
+            if(result == RBUS_ERROR_SUCCESS)
+                result = rc;
+        }
     }
+    return result;
+}
 
-    return returnCode;
+/*the length of a row name's table part, up to and including the dot before the row, which may end in a dot itself*/
+static size_t _table_name_length(char const* rowName)
+{
+    size_t len = strlen(rowName);
+
+    if(len && rowName[len-1] == '.')
+        len--;
+    while(len && rowName[len-1] != '.')
+        len--;
+    return len;
 }
 
-rbusError_t rbusTable_removeRow(
-    rbusHandle_t handle,
-    char const* rowName)
+/*send the rows of one table, rowNames[idx[0..numRows-1]], in one request*/
+static rbusError_t _table_remove_rows_request(rbusHandle_t handle, char const* const* rowNames, int const* idx, int numRows)
 {
     rbus_error_t err;
+    rbusError_t result;
     int returnCode = 0;
+    int version = 0;
+    int numReplied = 0;
+    int first = 1;
+    int i;
     rbusMessage request, response;
-    (void)handle;
-    rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
-
-    VERIFY_NULL(handle);
-    VERIFY_NULL(rowName);
-
-    RBUSLOG_DEBUG("%s: %s", __FUNCTION__, rowName);
 
     rbusMessage_Init(&request);
     rbusMessage_SetInt32(request, 0);/*TODO: this should be the session ID*/
-    rbusMessage_SetString(request, rowName);/*TODO: do we need to append the name as well as pass the name as the 1st arg to rbus_invokeRemoteMethod ?*/
+    rbusMessage_SetString(request, rowNames[idx[0]]);
+    rbusMessage_SetInt32(request, RBUS_TABLE_ROWS_WIRE_VERSION);
+    rbusMessage_SetInt32(request, numRows);
+    for(i = 0; i < numRows; ++i)
+        rbusMessage_SetString(request, rowNames[idx[i]]);
 
     if((err = rbus_invokeRemoteMethod(
-        rowName,
+        rowNames[idx[0]],
         METHOD_DELETETBLROW, 
         request, 
-        rbusConfig_ReadSetTimeout(),
+        rbusConfig_SetTimeoutFor(handle, rowNames[idx[0]]),
         &response)) != RTMESSAGE_BUS_SUCCESS)
     {
-        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, rowName);
+        RBUSLOG_ERROR("%s by %s failed; Received error %d from RBUS Daemon for the object %s", __FUNCTION__, handle->componentName, err, rowNames[idx[0]]);
         return rbuscoreError_to_rbusError(err);
     }
-    else
+
+    rbusMessage_GetInt32(response, &returnCode);
+    result = _table_row_result(returnCode);
+
+    if(rbusMessage_GetInt32(response, &version) == RT_OK && version >= RBUS_TABLE_ROWS_WIRE_VERSION &&
+       rbusMessage_GetInt32(response, &numReplied) == RT_OK && numReplied == numRows)
     {
-        rbusMessage_GetInt32(response, &returnCode);
-        legacyRetCode = (rbusLegacyReturn_t)returnCode;
+        first = numRows;
+    }
+    rbusMessage_Release(response);
 
-        RBUSLOG_INFO("%s rbus_invokeRemoteMethod success response returnCode:%d", __FUNCTION__, returnCode);
-        if((returnCode == RBUS_ERROR_SUCCESS) || (legacyRetCode == RBUS_LEGACY_ERR_SUCCESS))
+    /*older provider: only the first row was removed*/
+    for(i = first; i < numRows; ++i)
+    {
+        rbusError_t rc = rbusTable_removeRow(handle, rowNames[idx[i]]);
+        if(rc != RBUS_ERROR_SUCCESS && result == RBUS_ERROR_SUCCESS)
+            result = rc;
+    }
+    return result;
+}
+
+rbusError_t rbusTable_removeRows(
+    rbusHandle_t handle,
+    int numRows,
+    char const* const* rowNames)
+{
+    rbusError_t result = RBUS_ERROR_SUCCESS;
+    bool* sent;
+    int* idx;
+    int i, j;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(rowNames);
+
+    if(numRows <= 0)
+    {
+        RBUSLOG_WARN("%s invalid numRows %d", __FUNCTION__, numRows);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    for(i = 0; i < numRows; ++i)
+    {
+        if(!rowNames[i] || _table_name_length(rowNames[i]) == 0)
         {
-            returnCode = RBUS_ERROR_SUCCESS;
-            RBUSLOG_DEBUG("Successfully Set the Value");
+            RBUSLOG_WARN("%s invalid row name %s", __FUNCTION__, rowNames[i] ? rowNames[i] : "NULL");
+            return RBUS_ERROR_INVALID_INPUT;
         }
-        else
+    }
+
+    RBUSLOG_DEBUG("%s: %d rows", __FUNCTION__, numRows);
+
+    sent = rt_calloc(numRows, sizeof(bool));
+    idx = rt_malloc(numRows * sizeof(int));
+
+    /*one request per table, with the rows in the order given*/
+    for(i = 0; i < numRows; ++i)
+    {
+        size_t tableLen;
+        int count = 0;
+        rbusError_t rc;
+
+        if(sent[i])
+            continue;
+
+        tableLen = _table_name_length(rowNames[i]);
+
+        for(j = i; j < numRows; ++j)
         {
-            RBUSLOG_WARN("Response from remote method indicates the call failed!!");
-            if(legacyRetCode > RBUS_LEGACY_ERR_SUCCESS)
+            if(!sent[j] && _table_name_length(rowNames[j]) == tableLen && strncmp(rowNames[j], rowNames[i], tableLen) == 0)
             {
-                returnCode = CCSPError_to_rbusError(legacyRetCode);
+                sent[j] = true;
+                idx[count++] = j;
             }
         }
-        rbusMessage_Release(response);
+
+        rc = _table_remove_rows_request(handle, rowNames, idx, count);
+        if(rc != RBUS_ERROR_SUCCESS && result == RBUS_ERROR_SUCCESS)
+            result = rc;
     }
 
-    return returnCode;
+    free(sent);
+    free(idx);
+    return result;
 }
 
 rbusError_t rbusTable_registerRow(
@@ -3657,6 +5847,116 @@ rbusError_t rbusTable_unregisterRow(
     return RBUS_ERROR_SUCCESS;
 }
 
+rbusError_t rbusTable_registerRows(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    uint32_t const* instNums,
+    char const* const* aliasNames)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode** rows;
+    int count;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(tableName);
+    VERIFY_NULL(instNums);
+
+    if(numRows <= 0)
+    {
+        RBUSLOG_WARN("%s: invalid numRows %d", __FUNCTION__, numRows);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    elementNode* tableInstElem = retrieveInstanceElement(handleInfo->elementRoot, tableName);
+
+    if(!tableInstElem || tableInstElem->type != RBUS_ELEMENT_TYPE_TABLE)
+    {
+        RBUSLOG_WARN("%s: table does not exist %s", __FUNCTION__, tableName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    RBUSLOG_DEBUG("%s: register %d rows in table %s", __FUNCTION__, numRows, tableName);
+
+    rows = rt_malloc(numRows * sizeof(elementNode*));
+    count = registerTableRows(handle, tableInstElem, tableName, numRows, instNums, aliasNames, rows);
+    free(rows);
+
+    if(count != numRows)
+    {
+        RBUSLOG_WARN("%s: %d of %d rows already existed in %s", __FUNCTION__, numRows - count, numRows, tableName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t rbusTable_unregisterRows(
+    rbusHandle_t handle,
+    int numRows,
+    char const* const* rowNames)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    rbusError_t rc = RBUS_ERROR_SUCCESS;
+    elementNode** rows;
+    int i;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(rowNames);
+
+    if(numRows <= 0)
+    {
+        RBUSLOG_WARN("%s: invalid numRows %d", __FUNCTION__, numRows);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    rows = rt_malloc(numRows * sizeof(elementNode*));
+
+    for(i = 0; i < numRows; ++i)
+    {
+        rows[i] = rowNames[i] ? retrieveInstanceElement(handleInfo->elementRoot, rowNames[i]) : NULL;
+
+        if(!rows[i] || !rows[i]->parent || rows[i]->parent->type != RBUS_ELEMENT_TYPE_TABLE)
+        {
+            RBUSLOG_DEBUG("%s: row does not exists %s", __FUNCTION__, rowNames[i] ? rowNames[i] : "NULL");
+            rows[i] = NULL;
+            rc = RBUS_ERROR_INVALID_INPUT;
+        }
+    }
+
+    unregisterTableRows(handle, rows, numRows);
+    free(rows);
+    return rc;
+}
+
+rbusError_t rbusTable_setRowsHandlers(
+    rbusHandle_t handle,
+    char const* tableName,
+    rbusTableAddRowsHandler_t addRowsHandler,
+    rbusTableRemoveRowsHandler_t removeRowsHandler)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* tableRegElem;
+
+    VERIFY_NULL(handleInfo);
+    VERIFY_NULL(tableName);
+
+    tableRegElem = retrieveElement(handleInfo->elementRoot, tableName);
+
+    /*the name the table was registered with ends in the row template {i}*/
+    if(tableRegElem && tableRegElem->parent && tableRegElem->parent->type == RBUS_ELEMENT_TYPE_TABLE && strcmp(tableRegElem->name, "{i}") == 0)
+        tableRegElem = tableRegElem->parent;
+
+    if(!tableRegElem || tableRegElem->type != RBUS_ELEMENT_TYPE_TABLE)
+    {
+        RBUSLOG_WARN("%s: table not registered %s", __FUNCTION__, tableName);
+        return RBUS_ERROR_INVALID_INPUT;
+    }
+
+    tableRegElem->tableAddRowsHandler = addRowsHandler;
+    tableRegElem->tableRemoveRowsHandler = removeRowsHandler;
+    return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t rbusTable_getRowNames(
     rbusHandle_t handle,
     char const* tableName,
@@ -3677,7 +5977,7 @@ rbusError_t rbusTable_getRowNames(
 
     RBUSLOG_DEBUG("%s: %s", __FUNCTION__, tableName);
 
-    if((err = rbus_invokeRemoteMethod(tableName, METHOD_GETPARAMETERNAMES, request, rbusConfig_ReadGetTimeout(), &response)) == RTMESSAGE_BUS_SUCCESS)
+    if((err = rbus_invokeRemoteMethod(tableName, METHOD_GETPARAMETERNAMES, request, rbusConfig_GetTimeoutFor(handle, tableName), &response)) == RTMESSAGE_BUS_SUCCESS)
     {
         rbusLegacyReturn_t legacyRetCode = RBUS_LEGACY_ERR_FAILURE;
         int ret = -1;
@@ -3814,7 +6114,7 @@ rbusError_t rbusElementInfo_get(
         rbusMessage_SetInt32(request, depth);/*depth*/
         rbusMessage_SetInt32(request, 0);/*not row names*/
 
-        if((err = rbus_invokeRemoteMethod(destinations[d], METHOD_GETPARAMETERNAMES, request, rbusConfig_ReadGetTimeout(), &response)) != RTMESSAGE_BUS_SUCCESS)
+        if((err = rbus_invokeRemoteMethod(destinations[d], METHOD_GETPARAMETERNAMES, request, rbusConfig_GetTimeoutFor(handle, elemName), &response)) != RTMESSAGE_BUS_SUCCESS)
         {
             RBUSLOG_ERROR("%s rbus_invokeRemoteMethod %s destination=%s object=%s failed: err=%d", __FUNCTION__, METHOD_GETPARAMETERNAMES, destinations[d], elemName, err);
             errorcode = rbuscoreError_to_rbusError(err);
@@ -3922,6 +6222,8 @@ static rbusMessage rbusEvent_CreateSubscribePayload(rbusEventSubscription_t* sub
         rbusMessage_SetInt32(payload, 0);
     }
 
+    rbusMessage_SetInt32(payload, RBUS_SUBSCRIBE_WIRE_VERSION);
+
     return payload;
 }
 
@@ -3944,7 +6246,7 @@ static rbusError_t rbusEvent_SubscribeWithRetries(
     int destNotFoundTimeout;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
 
-    if( rbusEventSubscription_find(handleInfo->eventSubs, eventName, filter) ||
+    if( rbusEventSubscription_find(handleInfo, eventName, filter) ||
         rbusAsyncSubscribe_GetSubscription(handle, eventName, filter))
     {
         return RBUS_ERROR_SUBSCRIPTION_ALREADY_EXIST;
@@ -4025,7 +6327,7 @@ static rbusError_t rbusEvent_SubscribeWithRetries(
 
     if(coreerr == RTMESSAGE_BUS_SUCCESS)
     {
-        rtVector_PushBack(handleInfo->eventSubs, sub);
+        rbusEventSubscription_add(handleInfo, sub);
 
         RBUSLOG_INFO("%s: %s subscribe retries succeeded", __FUNCTION__, eventName);
         
@@ -4111,7 +6413,7 @@ rbusError_t rbusEvent_Unsubscribe(
 
     /*the use of rtVector is inefficient here.  I have to loop through the vector to find the sub by name, 
         then call RemoveItem, which loops through again to find the item by address to destroy */
-    sub = rbusEventSubscription_find(handleInfo->eventSubs, eventName, NULL);
+    sub = rbusEventSubscription_find(handleInfo, eventName, NULL);
 
     if(sub)
     {
@@ -4124,7 +6426,7 @@ rbusError_t rbusEvent_Unsubscribe(
             rbusMessage_Release(payload);
         }
 
-        rtVector_RemoveItem(handleInfo->eventSubs, sub, rbusEventSubscription_free);
+        rbusEventSubscription_remove(handleInfo, sub);
 
         if(coreerr == RTMESSAGE_BUS_SUCCESS)
         {
@@ -4151,6 +6453,35 @@ rbusError_t rbusEvent_Unsubscribe(
     }
 }
 
+/*the value cache's value-change subscriptions: made with the cache's componentId, so the provider
+  keeps them apart from the app's own subscriptions to the same events and their events are handed
+  to the cache, and kept out of eventSubs, so the app never finds them.  see rbus_valuecache.c*/
+void rbusEvent_SubscribeForValueCache(rbusEventSubscription_t* sub)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)sub->handle;
+    rbusMessage payload = rbusEvent_CreateSubscribePayload(sub, handleInfo->valueCacheComponentId);
+
+    rbusAsyncSubscribe_AddInternalSubscription(sub, payload);
+
+    rbusMessage_Release(payload);
+}
+
+rbusError_t rbusEvent_UnsubscribeForValueCache(rbusEventSubscription_t* sub)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)sub->handle;
+    rbusMessage payload = rbusEvent_CreateSubscribePayload(sub, handleInfo->valueCacheComponentId);
+    rbus_error_t coreerr = rbus_unsubscribeFromEvent(NULL, sub->eventName, payload);
+
+    rbusMessage_Release(payload);
+
+    if(coreerr != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_INFO("%s: %s failed with core err=%d", __FUNCTION__, sub->eventName, coreerr);
+        return RBUS_ERROR_BUS_ERROR;
+    }
+    return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t rbusEvent_SubscribeEx(
     rbusHandle_t                handle,
     rbusEventSubscription_t*    subscription,
@@ -4260,7 +6591,7 @@ rbusError_t rbusEvent_UnsubscribeEx(
 
         /*the use of rtVector is inefficient here.  I have to loop through the vector to find the sub by name, 
             then call RemoveItem, which loops through again to find the item by address to destroy */
-        sub = rbusEventSubscription_find(handleInfo->eventSubs, subscription[i].eventName, subscription[i].filter);
+        sub = rbusEventSubscription_find(handleInfo, subscription[i].eventName, subscription[i].filter);
         if(sub)
         {
             rbus_error_t coreerr;
@@ -4275,7 +6606,7 @@ rbusError_t rbusEvent_UnsubscribeEx(
                 rbusMessage_Release(payload);
             }
 
-            rtVector_RemoveItem(handleInfo->eventSubs, sub, rbusEventSubscription_free);
+            rbusEventSubscription_remove(handleInfo, sub);
 
             if(coreerr != RTMESSAGE_BUS_SUCCESS)
             {
@@ -4321,27 +6652,17 @@ rbusError_t  rbusEvent_Publish(
     rbusSubscription_t* subscription;
     rbusValue_t newVal = NULL;
     rbusValue_t oldVal = NULL;
+    /*the event body serialized once and shared by the subscribers, one per value of the 'filter' property:
+      [0] not set by this publish, [1] false, [2] true */
+    uint8_t* body[3] = {NULL, NULL, NULL};
+    uint32_t bodyLength[3] = {0, 0, 0};
+    int i;
 
     VERIFY_NULL(handle);
     VERIFY_NULL(eventData);
 
     RBUSLOG_DEBUG("%s: %s", __FUNCTION__, eventData->name);
 
-    /*get the node and walk its subscriber list, 
-      publishing event to each subscriber*/
-    elementNode* el = retrieveInstanceElement(handleInfo->elementRoot, eventData->name);
-
-    if(!el)
-    {
-        RBUSLOG_WARN("rbusEvent_Publish failed: retrieveElement return NULL for %s", eventData->name);
-        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
-    }
-
-    if(!el->subscriptions)/*nobody subscribed yet*/
-    {
-        return RBUS_ERROR_NOSUBSCRIBERS;
-    }
-
     if(eventData->type == RBUS_EVENT_VALUE_CHANGED)
     {
         if(eventData->data)
@@ -4356,11 +6677,33 @@ rbusError_t  rbusEvent_Publish(
         }
     }
 
+    /*subscriptions are removed, and rows deleted, with the registry locked (e.g. by the interval
+      thread expiring a subscription's duration), so keep it locked while walking them*/
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+
+    /*get the node and walk its subscriber list, 
+      publishing event to each subscriber*/
+    elementNode* el = lookupInstanceElement(handleInfo->elementRoot, eventData->name);
+
+    if(!el)
+    {
+        rbusSubscriptions_unlock(handleInfo->subscriptions);
+        RBUSLOG_WARN("rbusEvent_Publish failed: retrieveElement return NULL for %s", eventData->name);
+        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+    }
+
+    if(!el->subscriptions)/*nobody subscribed yet*/
+    {
+        rbusSubscriptions_unlock(handleInfo->subscriptions);
+        return RBUS_ERROR_NOSUBSCRIBERS;
+    }
+
     /*Loop through element's subscriptions*/
     rtList_GetFront(el->subscriptions, &listItem);
     while(listItem)
     {
         bool publish = true;
+        int bodyIndex = 0;
 
         rtListItem_GetData(listItem, (void**)&subscription);
         if(!subscription || !subscription->eventName || !subscription->listener)
@@ -4369,6 +6712,7 @@ rbusError_t  rbusEvent_Publish(
             if(errOut == RTMESSAGE_BUS_SUCCESS)
                 errOut = RTMESSAGE_BUS_ERROR_GENERAL;
             rtListItem_GetNext(listItem, &listItem);
+            continue;
         }
 
         if(eventData->type == RBUS_EVENT_VALUE_CHANGED)
@@ -4396,6 +6740,7 @@ rbusError_t  rbusEvent_Publish(
                     rbusValue_SetBoolean(filterResult, newResult != 0);
                     rbusObject_SetValue(eventData->data, "filter", filterResult);
                     rbusValue_Release(filterResult);                    
+                    bodyIndex = newResult != 0 ? 2 : 1;
                 }
                 else
                 {
@@ -4404,12 +6749,36 @@ rbusError_t  rbusEvent_Publish(
             }
         }
 
-        if(publish)
+        /*with batching on, the event is queued and sent later along with others to the same listener*/
+        if(publish && handleInfo->eventBatch && rbusEventBatch_Add(handleInfo->eventBatch, subscription, eventData))
         {
-            rbusMessage msg;
-            rbusMessage_Init(&msg);
+            RBUSLOG_DEBUG("rbusEvent_Publish: queued event %s for listener %s", subscription->eventName, subscription->listener);
+        }
+        else if(publish)
+        {
+            rbusMessage msg = NULL;
+            uint8_t* bytes = NULL;
+
+            /*copy the shared body and the subscription's cached trailer into the message
+              instead of serializing the whole event again for each subscriber*/
+            if(subscription->trailer)
+            {
+                if(!body[bodyIndex])
+                    rbusEventData_encode(eventData, NULL, 0, &body[bodyIndex], &bodyLength[bodyIndex]);
 
-            rbusEventData_appendToMessage(eventData, subscription->filter, subscription->componentId, msg);
+                bytes = rt_malloc(bodyLength[bodyIndex] + subscription->trailerLength);
+                memcpy(bytes, body[bodyIndex], bodyLength[bodyIndex]);
+                memcpy(bytes + bodyLength[bodyIndex], subscription->trailer, subscription->trailerLength);
+
+                if(rbusMessage_FromBytes(&msg, bytes, bodyLength[bodyIndex] + subscription->trailerLength) != RT_OK)
+                    msg = NULL;
+            }
+
+            if(!msg)
+            {
+                rbusMessage_Init(&msg);
+                rbusEventData_appendToMessage(eventData, subscription->filter, subscription->componentId, msg);
+            }
 
             RBUSLOG_DEBUG("rbusEvent_Publish: publishing event %s to listener %s", subscription->eventName, subscription->listener);
 
@@ -4420,6 +6789,7 @@ rbusError_t  rbusEvent_Publish(
                 msg);
 
             rbusMessage_Release(msg);
+            free(bytes);
 
             if(err != RTMESSAGE_BUS_SUCCESS)
             {
@@ -4432,9 +6802,119 @@ rbusError_t  rbusEvent_Publish(
         rtListItem_GetNext(listItem, &listItem);
     }
 
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+    for(i = 0; i < 3; ++i)
+        free(body[i]);
+
     return errOut == RTMESSAGE_BUS_SUCCESS ? RBUS_ERROR_SUCCESS: RBUS_ERROR_BUS_ERROR;
 }
 
+rbusError_t  rbusEvent_NotifyValueChanged(
+    rbusHandle_t handle,
+    char const* propertyName)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* el;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(propertyName);
+
+    RBUSLOG_DEBUG("%s: %s", __FUNCTION__, propertyName);
+
+    /*don't materialize virtual rows, a provider notifying for every row would materialize the whole table*/
+    el = lookupInstanceElement(handleInfo->elementRoot, propertyName);
+
+    if(!el || el->type != RBUS_ELEMENT_TYPE_PROPERTY)
+    {
+        RBUSLOG_WARN("%s: property %s not found", __FUNCTION__, propertyName);
+        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+    }
+
+    /*a virtual row has no value-change subscribers, subscribing would have materialized it*/
+    if(isRowTemplateElement(el))
+        return RBUS_ERROR_SUCCESS;
+
+    rbusValueChange_NotifyPropertyNode(handle, el);
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t  rbusEvent_SetValueChangePolling(
+    rbusHandle_t handle,
+    char const* propertyName,
+    bool enable)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+    elementNode* el;
+
+    VERIFY_NULL(handle);
+    VERIFY_NULL(propertyName);
+
+    RBUSLOG_DEBUG("%s: %s %d", __FUNCTION__, propertyName, enable);
+
+    el = lookupInstanceElement(handleInfo->elementRoot, propertyName);
+
+    if(!el || el->type != RBUS_ELEMENT_TYPE_PROPERTY)
+    {
+        RBUSLOG_WARN("%s: property %s not found", __FUNCTION__, propertyName);
+        return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+    }
+
+    /*a virtual row's property has its template's setting, so only a different one needs the row materialized.
+      a name with {i} sets the template itself*/
+    if(isRowTemplateElement(el) && !strstr(propertyName, "{i}"))
+    {
+        if(el->valueChangeNotify == !enable)
+            return RBUS_ERROR_SUCCESS;
+
+        el = retrieveInstanceElement(handleInfo->elementRoot, propertyName);
+        if(!el || el->type != RBUS_ELEMENT_TYPE_PROPERTY)
+            return RBUS_ERROR_ELEMENT_DOES_NOT_EXIST;
+    }
+
+    el->valueChangeNotify = !enable;
+
+    /*check it now, which also puts it back on the polling schedule if enabling*/
+    if(enable)
+        rbusValueChange_NotifyPropertyNode(handle, el);
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t  rbusEvent_SetPublishBatching(
+    rbusHandle_t handle,
+    uint32_t flushInterval,
+    uint32_t maxBatchSize,
+    bool coalesce)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handle);
+
+    RBUSLOG_INFO("%s: flushInterval=%u maxBatchSize=%u coalesce=%d", __FUNCTION__, flushInterval, maxBatchSize, coalesce);
+
+    if(!handleInfo->eventBatch)
+    {
+        if(flushInterval == 0)
+            return RBUS_ERROR_SUCCESS;
+        rbusEventBatch_Create(&handleInfo->eventBatch, handle);
+    }
+
+    rbusEventBatch_SetOptions(handleInfo->eventBatch, flushInterval, maxBatchSize, coalesce);
+    return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t  rbusEvent_FlushPublishBatch(
+    rbusHandle_t handle)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
+
+    VERIFY_NULL(handle);
+
+    if(handleInfo->eventBatch)
+        rbusEventBatch_Flush(handleInfo->eventBatch);
+    return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t rbusMethod_InvokeInternal(
     rbusHandle_t handle, 
     char const* methodName, 
@@ -4495,7 +6975,7 @@ rbusError_t rbusMethod_Invoke(
 {
     VERIFY_NULL(handle);
     VERIFY_NULL(methodName);
-    return rbusMethod_InvokeInternal(handle, methodName, inParams, outParams, rbusConfig_ReadSetTimeout());
+    return rbusMethod_InvokeInternal(handle, methodName, inParams, outParams, rbusConfig_SetTimeoutFor(handle, methodName));
 }
 
 typedef struct _rbusMethodInvokeAsyncData_t
@@ -4554,7 +7034,7 @@ rbusError_t rbusMethod_InvokeAsync(
     data->methodName = strdup(methodName);
     data->inParams = inParams;
     data->callback = callback;
-    data->timeout = timeout > 0 ? (timeout * 1000) : rbusConfig_ReadSetTimeout(); /* convert seconds to milliseconds */
+    data->timeout = timeout > 0 ? (timeout * 1000) : rbusConfig_SetTimeoutFor(handle, methodName); /* convert seconds to milliseconds */
 
     if((err = pthread_create(&pid, NULL, rbusMethod_InvokeAsyncThreadFunc, data)) != 0)
     {
@@ -0,0 +1,249 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Async Requests:
+    The completion threads behind rbus_getAsync, rbus_getExtAsync and rbus_setAsync.
+    Requests are queued in order and run by up to RBUS_ASYNC_MAX_THREADS threads,
+    each making the blocking request and then calling the consumer's callback, so that
+    many requests can be in flight on the connection without the consumer making threads.
+    They also run the helpers that send a request's messages to several components at once.
+    Threads are started as requests queue up and run until the last handle is closed.
+*/
+
+#include "rbus_asyncrequest.h"
+#include "rbus_log.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <rtMemory.h>
+
+#define RBUS_ASYNC_MAX_THREADS 8
+
+typedef struct _rbusAsyncRequest
+{
+    rbusHandle_t                handle;
+    rbusAsyncRequestRun_t       run;
+    rbusAsyncRequestCancel_t    cancel;
+    void*                       data;
+    struct _rbusAsyncRequest*   next;
+} rbusAsyncRequest_t;
+
+static pthread_mutex_t gAsyncMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gAsyncQueued = PTHREAD_COND_INITIALIZER;     /* a request was queued or shutdown began */
+static pthread_cond_t gAsyncDone = PTHREAD_COND_INITIALIZER;       /* a running request completed */
+static rbusAsyncRequest_t* gQueueHead = NULL;
+static rbusAsyncRequest_t* gQueueTail = NULL;
+static pthread_t gThreads[RBUS_ASYNC_MAX_THREADS];
+static rbusAsyncRequest_t* gRunning[RBUS_ASYNC_MAX_THREADS];   /* the request each thread is running */
+static int gNumThreads = 0;
+static int gNumIdle = 0;
+static int gQueueLength = 0;
+static uint32_t gGeneration = 0;    /* bumped by rbusAsyncRequest_Shutdown to stop the threads */
+
+#define THREAD_ARG(gen, slot) ((void*)(intptr_t)(((gen) << 8) | (uint32_t)(slot)))
+#define THREAD_GEN(arg) ((uint32_t)((intptr_t)(arg) >> 8))
+#define THREAD_SLOT(arg) ((int)((intptr_t)(arg) & 0xff))
+
+static void* rbusAsyncRequest_threadFunc(void* p)
+{
+    uint32_t generation = THREAD_GEN(p);
+    int slot = THREAD_SLOT(p);
+
+    pthread_mutex_lock(&gAsyncMutex);
+    while(generation == gGeneration)
+    {
+        rbusAsyncRequest_t* req = gQueueHead;
+        if(!req)
+        {
+            gNumIdle++;
+            pthread_cond_wait(&gAsyncQueued, &gAsyncMutex);
+            if(generation == gGeneration)
+                gNumIdle--;
+            continue;
+        }
+
+        gQueueHead = req->next;
+        if(!gQueueHead)
+            gQueueTail = NULL;
+        gQueueLength--;
+        gRunning[slot] = req;
+        pthread_mutex_unlock(&gAsyncMutex);
+
+        req->run(req->data);
+
+        pthread_mutex_lock(&gAsyncMutex);
+        /*if the callback closed the last handle, the slot may already belong to a new thread*/
+        if(generation == gGeneration)
+            gRunning[slot] = NULL;
+        free(req);
+        pthread_cond_broadcast(&gAsyncDone);
+    }
+    pthread_mutex_unlock(&gAsyncMutex);
+    return NULL;
+}
+
+rbusError_t rbusAsyncRequest_Submit(rbusHandle_t handle, rbusAsyncRequestRun_t run, rbusAsyncRequestCancel_t cancel, void* data)
+{
+    rbusAsyncRequest_t* req;
+    int err;
+
+    req = rt_try_malloc(sizeof(rbusAsyncRequest_t));
+    if(!req)
+        return RBUS_ERROR_OUT_OF_RESOURCES;
+    req->handle = handle;
+    req->run = run;
+    req->cancel = cancel;
+    req->data = data;
+    req->next = NULL;
+
+    pthread_mutex_lock(&gAsyncMutex);
+
+    /*start another thread when more requests are queued than threads are free to run them, up to the limit*/
+    if(gQueueLength >= gNumIdle && gNumThreads < RBUS_ASYNC_MAX_THREADS)
+    {
+        if((err = pthread_create(&gThreads[gNumThreads], NULL, rbusAsyncRequest_threadFunc, THREAD_ARG(gGeneration, gNumThreads))) != 0)
+        {
+            RBUSLOG_ERROR("%s pthread_create failed: err=%d", __FUNCTION__, err);
+            if(gNumThreads == 0)
+            {
+                pthread_mutex_unlock(&gAsyncMutex);
+                free(req);
+                return RBUS_ERROR_BUS_ERROR;
+            }
+        }
+        else
+        {
+            gNumThreads++;
+        }
+    }
+
+    if(gQueueTail)
+        gQueueTail->next = req;
+    else
+        gQueueHead = req;
+    gQueueTail = req;
+    gQueueLength++;
+    pthread_cond_signal(&gAsyncQueued);
+
+    pthread_mutex_unlock(&gAsyncMutex);
+    return RBUS_ERROR_SUCCESS;
+}
+
+static bool rbusAsyncRequest_isRunning(rbusHandle_t handle)
+{
+    int i;
+    for(i = 0; i < gNumThreads; ++i)
+    {
+        /*a callback closing its own handle can't wait for itself*/
+        if(gRunning[i] && gRunning[i]->handle == handle && !pthread_equal(gThreads[i], pthread_self()))
+            return true;
+    }
+    return false;
+}
+
+void rbusAsyncRequest_CloseHandle(rbusHandle_t handle)
+{
+    rbusAsyncRequest_t* canceled = NULL;
+    rbusAsyncRequest_t** link;
+
+    pthread_mutex_lock(&gAsyncMutex);
+
+    /*take the handle's queued requests out, keeping their order*/
+    gQueueTail = NULL;
+    for(link = &gQueueHead; *link;)
+    {
+        rbusAsyncRequest_t* req = *link;
+        if(req->handle == handle)
+        {
+            *link = req->next;
+            req->next = canceled;
+            canceled = req;
+            gQueueLength--;
+        }
+        else
+        {
+            gQueueTail = req;
+            link = &req->next;
+        }
+    }
+
+    while(rbusAsyncRequest_isRunning(handle))
+        pthread_cond_wait(&gAsyncDone, &gAsyncMutex);
+
+    pthread_mutex_unlock(&gAsyncMutex);
+
+    /*canceled is in reverse order, so put it back in order before calling back*/
+    {
+        rbusAsyncRequest_t* ordered = NULL;
+        while(canceled)
+        {
+            rbusAsyncRequest_t* next = canceled->next;
+            canceled->next = ordered;
+            ordered = canceled;
+            canceled = next;
+        }
+        while(ordered)
+        {
+            rbusAsyncRequest_t* next = ordered->next;
+            ordered->cancel(ordered->data, RBUS_ERROR_INVALID_HANDLE);
+            free(ordered);
+            ordered = next;
+        }
+    }
+}
+
+void rbusAsyncRequest_Shutdown(void)
+{
+    int i, numThreads;
+    pthread_t threads[RBUS_ASYNC_MAX_THREADS];
+
+    pthread_mutex_lock(&gAsyncMutex);
+
+    /*a handle opened since the caller checked may already be using them*/
+    for(i = 0; i < gNumThreads; ++i)
+    {
+        if(gRunning[i] && !pthread_equal(gThreads[i], pthread_self()))
+            break;
+    }
+    if(gQueueHead || i < gNumThreads)
+    {
+        pthread_mutex_unlock(&gAsyncMutex);
+        return;
+    }
+
+    gGeneration++;
+    pthread_cond_broadcast(&gAsyncQueued);
+    numThreads = gNumThreads;
+    memcpy(threads, gThreads, sizeof(threads));
+    gNumThreads = 0;
+    gNumIdle = 0;
+    memset(gRunning, 0, sizeof(gRunning));
+    pthread_mutex_unlock(&gAsyncMutex);
+
+    for(i = 0; i < numThreads; ++i)
+    {
+        /*the last handle can be closed from a callback, on one of these threads*/
+        if(pthread_equal(threads[i], pthread_self()))
+            pthread_detach(threads[i]);
+        else
+            pthread_join(threads[i], NULL);
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef RBUS_ASYNCREQUEST_H
+#define RBUS_ASYNCREQUEST_H
+
+#include <rbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*runs a request and calls its completion callback, then frees data*/
+typedef void (*rbusAsyncRequestRun_t)(void* data);
+
+/*calls a request's completion callback with error, without running it, then frees data*/
+typedef void (*rbusAsyncRequestCancel_t)(void* data, rbusError_t error);
+
+/*queue a request made with handle to run on a completion thread*/
+rbusError_t rbusAsyncRequest_Submit(rbusHandle_t handle, rbusAsyncRequestRun_t run, rbusAsyncRequestCancel_t cancel, void* data);
+
+/*cancel the handle's queued requests and wait for its running ones to complete*/
+void rbusAsyncRequest_CloseHandle(rbusHandle_t handle);
+
+/*stop the completion threads, once no handles are open*/
+void rbusAsyncRequest_Shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -44,6 +44,7 @@ typedef struct AsyncSubscription_t
     int nextWaitTime;
     rtTime_t startTime;
     rtTime_t nextRetryTime;
+    bool internal;
 } AsyncSubscription_t;
 
 static AsyncSubscribeRetrier_t* gRetrier = NULL;
@@ -77,7 +78,8 @@ static int rbusAsyncSubscribeRetrier_CompareSubscription(const void *pitem, cons
     if((!item)||(!sub))
         return 1;
 
-    if( item->subscription->handle == sub->handle &&
+    if( !item->internal &&
+        item->subscription->handle == sub->handle &&
         strcmp(item->subscription->eventName, sub->eventName) == 0 && 
         rbusFilter_Compare(item->subscription->filter, sub->filter) == 0)
         return 0;
@@ -231,7 +233,10 @@ static void rbusAsyncSubscribeRetrier_SendSubscriptionRequests()
                     }
                 }
 
-                _subscribe_async_callback_handler(item->subscription->handle, item->subscription, responseErr);
+                if(item->internal)
+                    item->subscription->asyncHandler(item->subscription->handle, item->subscription, responseErr);
+                else
+                    _subscribe_async_callback_handler(item->subscription->handle, item->subscription, responseErr);
 
                 item->subscription = NULL;/*ownership no longer ours*/
 
@@ -338,7 +343,7 @@ static void rbusAsyncSubscribeRetrier_Destroy()
     RBUSLOG_INFO("%s exit", __FUNCTION__);
 }
 
-void rbusAsyncSubscribe_AddSubscription(rbusEventSubscription_t* subscription, rbusMessage payload)
+static void rbusAsyncSubscribe_Add(rbusEventSubscription_t* subscription, rbusMessage payload, bool internal)
 {
     int rc;
     char tbuff[50];
@@ -356,6 +361,7 @@ void rbusAsyncSubscribe_AddSubscription(rbusEventSubscription_t* subscription, r
     item->subscription = subscription;
     item->payload = payload;
     item->nextWaitTime = 0;
+    item->internal = internal;
 
     rtTime_Now(&item->startTime);
     item->nextRetryTime = item->startTime; /*set to now also so we do our first sub immediately*/
@@ -371,6 +377,16 @@ void rbusAsyncSubscribe_AddSubscription(rbusEventSubscription_t* subscription, r
     (void)rc;
 }
 
+void rbusAsyncSubscribe_AddSubscription(rbusEventSubscription_t* subscription, rbusMessage payload)
+{
+    rbusAsyncSubscribe_Add(subscription, payload, false);
+}
+
+void rbusAsyncSubscribe_AddInternalSubscription(rbusEventSubscription_t* subscription, rbusMessage payload)
+{
+    rbusAsyncSubscribe_Add(subscription, payload, true);
+}
+
 void rbusAsyncSubscribe_RemoveSubscription(rbusEventSubscription_t* subscription)
 {
     if(!gRetrier)
@@ -28,6 +28,9 @@ extern "C" {
 #endif
 
 void rbusAsyncSubscribe_AddSubscription(rbusEventSubscription_t* subscription, rbusMessage payload);
+/*the same for a subscription the library makes for itself, such as the value cache's.  it's kept out of
+  GetSubscription and RemoveSubscription, and once done it's handed to its asyncHandler instead of the handle*/
+void rbusAsyncSubscribe_AddInternalSubscription(rbusEventSubscription_t* subscription, rbusMessage payload);
 void rbusAsyncSubscribe_RemoveSubscription(rbusEventSubscription_t* subscription);
 rbusEventSubscription_t* rbusAsyncSubscribe_GetSubscription(rbusHandle_t handle, char const* eventName, rbusFilter_t filter);
 void rbusAsyncSubscribe_CloseHandle(rbusHandle_t handle);
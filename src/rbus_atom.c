@@ -0,0 +1,116 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+    Atom Table:
+    Element, token and event names repeat heavily -- every table row copies the
+    names of its row template and every subscription to a property repeats its
+    name -- so they are interned here and shared.  Atoms are hashed by their text
+    (see rbus_hash.h).
+    An atom is the text member of its entry, so releasing one finds the entry
+    without a lookup.
+*/
+
+#include "rbus_atom.h"
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include <rtMemory.h>
+
+#define ATOM_TABLE_MIN_BUCKETS 256
+
+typedef struct _rbusAtomEntry
+{
+    rbusHashLink            link;
+    uint32_t                refs;
+    size_t                  len;
+    char                    text[];
+} rbusAtomEntry;
+
+static rbusHashTable gAtoms = RBUS_HASH_TABLE_INITIALIZER(ATOM_TABLE_MIN_BUCKETS);
+
+static pthread_mutex_t gAtomsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static rbusAtomEntry* rbusAtom_Entry(char const* atom)
+{
+    return (rbusAtomEntry*)(atom - offsetof(rbusAtomEntry, text));
+}
+
+char const* rbusAtom_Intern(char const* s, size_t len)
+{
+    uint32_t hash = rbusHash_Bytes(RBUS_HASH_INIT, s, len);
+    rbusAtomEntry* entry;
+    rbusHashLink* link;
+
+    pthread_mutex_lock(&gAtomsMutex);
+
+    for(link = rbusHashTable_Find(&gAtoms, hash); link; link = rbusHashTable_FindNext(link))
+    {
+        entry = rbusHashTable_Entry(link, rbusAtomEntry, link);
+        if(entry->len == len && memcmp(entry->text, s, len) == 0)
+        {
+            entry->refs++;
+            pthread_mutex_unlock(&gAtomsMutex);
+            return entry->text;
+        }
+    }
+
+    entry = rt_malloc(sizeof(rbusAtomEntry) + len + 1);
+    entry->refs = 1;
+    entry->len = len;
+    memcpy(entry->text, s, len);
+    entry->text[len] = 0;
+    rbusHashTable_Insert(&gAtoms, &entry->link, hash);
+
+    pthread_mutex_unlock(&gAtomsMutex);
+    return entry->text;
+}
+
+char const* rbusAtom_Retain(char const* atom)
+{
+    if(atom)
+    {
+        pthread_mutex_lock(&gAtomsMutex);
+        rbusAtom_Entry(atom)->refs++;
+        pthread_mutex_unlock(&gAtomsMutex);
+    }
+    return atom;
+}
+
+void rbusAtom_Release(char const* atom)
+{
+    rbusAtomEntry* entry;
+
+    if(!atom)
+        return;
+
+    entry = rbusAtom_Entry(atom);
+
+    pthread_mutex_lock(&gAtomsMutex);
+
+    if(--entry->refs == 0)
+    {
+        rbusHashTable_Remove(&gAtoms, &entry->link);
+        free(entry);
+    }
+
+    pthread_mutex_unlock(&gAtomsMutex);
+}
@@ -0,0 +1,46 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_ATOM_H
+#define RBUS_ATOM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*an atom is a shared, reference counted copy of a string.  equal strings interned
+  at the same time are the same atom, so atoms compare equal by pointer.
+  atoms must not be modified or freed except through rbusAtom_Release*/
+
+/*get the atom for the first len chars of s, adding a reference*/
+char const* rbusAtom_Intern(char const* s, size_t len);
+
+/*add a reference to an existing atom and return it*/
+char const* rbusAtom_Retain(char const* atom);
+
+/*drop a reference to atom, freeing it when it was the last one. NULL is ignored*/
+void rbusAtom_Release(char const* atom);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -91,6 +91,7 @@ void rbusBuffer_Create(rbusBuffer_t* buff)
     (*buff)->posWrite = 0;
     (*buff)->posRead = 0;
     (*buff)->data = (*buff)->block1;
+    (*buff)->owner = NULL;
 }
 
 void rbusBuffer_Destroy(rbusBuffer_t buff)
@@ -257,7 +258,7 @@ int rbusBuffer_Read(rbusBuffer_t const buff, void* data, int len)
 {
     if((!buff) || (!data))
         return -1;
-    if(!(buff->posRead + len < buff->lenAlloc))
+    if(!(buff->posRead + len <= buff->lenAlloc))
     {
         RBUSLOG_WARN("rbusBuffer_Read failed");
         return -1;
@@ -397,3 +398,16 @@ int rbusBuffer_ReadBytes(rbusBuffer_t const buff, uint8_t** bytes, int* len)
     *bytes = rt_malloc(buff->posWrite);
     return rbusBuffer_Read(buff, bytes, buff->posWrite);
 }
+
+int rbusBuffer_ReadInt32TLV(rbusBuffer_t const buff, int32_t* i32)
+{
+    uint16_t type;
+    uint16_t length;
+    if(rbusBuffer_ReadUInt16(buff, &type) < 0)
+        return -1;
+    if(rbusBuffer_ReadUInt16(buff, &length) < 0)
+        return -1;
+    if(!(type == RBUS_INT32 && length == sizeof(int32_t)))
+        return -1;
+    return rbusBuffer_ReadInt32(buff, i32);
+}
@@ -26,6 +26,16 @@
 extern "C" {
 #endif
 
+/*Memory that decoded string and bytes values can reference instead of copying.
+    retain is called once for each value that references the memory
+    and release is called when that value no longer references it.*/
+typedef struct _rbusBufferOwner
+{
+    void*           owner;
+    void            (*retain)(void* owner);
+    void            (*release)(void* owner);
+} rbusBufferOwner_t;
+
 typedef struct _rbusBuffer
 {
     int             lenAlloc;
@@ -33,6 +43,7 @@ typedef struct _rbusBuffer
     int             posRead;
     uint8_t*        data;
     uint8_t         block1[64];
+    rbusBufferOwner_t const* owner;/*set on read-only views whose data is kept alive by owner*/
 } *rbusBuffer_t;
 
 char const* rbusValueType_ToDebugString(rbusValueType_t type);
@@ -42,13 +53,30 @@ uint8_t const* rbusValue_GetV(rbusValue_t v);
 uint32_t rbusValue_GetL(rbusValue_t v);
 void rbusValue_SetTLV(rbusValue_t v, rbusValueType_t type, uint32_t length, void const* value);
 
+/*Creates a string or bytes value which references data rather than copying it.
+    Returns NULL if data can't be referenced, such as a string missing its null terminator,
+    in which case the caller should copy it with rbusValue_SetTLV.
+    Setting the value again releases the owner and copies as usual.*/
+rbusValue_t rbusValue_InitView(rbusValueType_t type, uint8_t const* data, uint32_t length, rbusBufferOwner_t const* owner);
+
 /*Decode/Encode can be used once we disable message pack and change ccsp
     Currently we push/pop name, type, value separately with rtMessage.
     This will change where we pass the rbusBuffer_t raw binary to the socket
     and that will require changes in ccsp_base_api/message_bus I imagine
 */
 int rbusValue_Decode(rbusValue_t* value, rbusBuffer_t const buff);
-void rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff);
+int rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff);
+
+/*Encode returns -1 if a string or bytes value is too long for the 16 bit TLV length,
+    in which case the caller should fall back to rbusMessage serialization.
+    The property list encodes its count followed by each property's name and value.
+    The object encodes its name, type, property list, child count and children.*/
+int rbusProperty_Encode(rbusProperty_t property, rbusBuffer_t buff);
+int rbusProperty_Decode(rbusProperty_t* property, rbusBuffer_t const buff);
+int rbusPropertyList_Encode(rbusProperty_t first, rbusBuffer_t buff);
+int rbusPropertyList_Decode(rbusProperty_t* first, rbusBuffer_t const buff);
+int rbusObject_Encode(rbusObject_t object, rbusBuffer_t buff);
+int rbusObject_Decode(rbusObject_t* object, rbusBuffer_t const buff);
 
 void rbusFilter_Encode(rbusFilter_t filter, rbusBuffer_t buff);
 int rbusFilter_Decode(rbusFilter_t* filter, rbusBuffer_t const buff);
@@ -92,6 +120,7 @@ int rbusBuffer_ReadDouble(rbusBuffer_t const buff, double* f64);
 int rbusBuffer_ReadString(rbusBuffer_t const buff, char** s, int* len);/* caller must free *s */
 int rbusBuffer_ReadDateTime(rbusBuffer_t const buff, rbusDateTime_t* tv);
 int rbusBuffer_ReadBytes(rbusBuffer_t const buff, uint8_t** bytes, int* len);/* caller must free *bytes */
+int rbusBuffer_ReadInt32TLV(rbusBuffer_t const buff, int32_t* i32);/* reads the type and length header too */
 
 #ifdef __cplusplus
 }
@@ -1,9 +1,15 @@
 #include "rbus_config.h"
 #include "rbus_log.h"
+#include "rbus_handle.h"
 #include <rtMemory.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
 
 /* These RBUS_* defines are the list of config settings with their default values
  * Each can be overridden using an environment variable of the same name
@@ -16,6 +22,7 @@
 #define RBUS_SET_DEFAULT_TIMEOUT 60000      /* default timeout in miliseconds for SET API */
 #define RBUS_GET_TIMEOUT_OVERRIDE "/tmp/rbus_timeout_get"
 #define RBUS_SET_TIMEOUT_OVERRIDE "/tmp/rbus_timeout_set"
+#define RBUS_CONFIG_REFRESH_PERIOD 1000     /* how often in miliseconds the override files are checked for changes */
 
 #define initStr(P,N) \
 { \
@@ -31,7 +38,145 @@
     RBUSLOG_DEBUG(#N"=%d",P); \
 }
 
+typedef struct _rbusOverrideFile
+{
+    char const*     path;
+    int*            value;      /* where the timeout read from the file is cached, in miliseconds */
+    bool            exists;
+    ino_t           ino;        /* the ino, size and mtime of the file when last read */
+    off_t           size;
+    struct timespec mtime;
+} rbusOverrideFile_t;
+
+typedef struct _rbusElementTimeout
+{
+    char*           name;
+    size_t          len;
+    int             getTimeout;
+    int             setTimeout;
+} rbusElementTimeout_t;
+
+struct _rbusElementTimeouts
+{
+    pthread_mutex_t mutex;
+    size_t          count;      /* read without the lock, so handles without overrides skip the search */
+    rtVector        list;
+};
+
 static rbusConfig_t* gConfig = NULL;
+static rbusOverrideFile_t gOverrideFiles[2];
+static pthread_mutex_t gRefreshMutex = PTHREAD_MUTEX_INITIALIZER;
+static int64_t gNextRefresh = 0;
+
+static int64_t monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void readOverrideFile(rbusOverrideFile_t* file)
+{
+    struct stat st;
+    FILE* fp;
+    char buf[25] = {0};
+    int timeout = 0;
+
+    if(stat(file->path, &st) != 0)
+    {
+        if(file->exists)
+        {
+            RBUSLOG_INFO("%s removed", file->path);
+            file->exists = false;
+            __atomic_store_n(file->value, 0, __ATOMIC_RELAXED);
+        }
+        return;
+    }
+
+    if(file->exists &&
+       file->ino == st.st_ino &&
+       file->size == st.st_size &&
+       file->mtime.tv_sec == st.st_mtim.tv_sec &&
+       file->mtime.tv_nsec == st.st_mtim.tv_nsec)
+        return;
+
+    file->exists = true;
+    file->ino = st.st_ino;
+    file->size = st.st_size;
+    file->mtime = st.st_mtim;
+
+    fp = fopen(file->path, "r");
+    if(fp != NULL)
+    {
+        if(fread(buf, 1, sizeof(buf)-1, fp) > 0)
+            timeout = atoi(buf);
+        fclose(fp);
+    }
+
+    RBUSLOG_INFO("%s set to %d seconds", file->path, timeout);
+    __atomic_store_n(file->value, timeout > 0 ? timeout * 1000 : 0, __ATOMIC_RELAXED);
+}
+
+/* Re-read the override files if they changed, at most once per RBUS_CONFIG_REFRESH_PERIOD.
+   Whichever thread gets there first does the check; the others use the cached values. */
+static void refreshOverrideFiles()
+{
+    int64_t now = monotonicMs();
+
+    if(now < __atomic_load_n(&gNextRefresh, __ATOMIC_RELAXED))
+        return;
+
+    if(pthread_mutex_trylock(&gRefreshMutex) != 0)
+        return;
+
+    if(now >= gNextRefresh)
+    {
+        readOverrideFile(&gOverrideFiles[0]);
+        readOverrideFile(&gOverrideFiles[1]);
+        __atomic_store_n(&gNextRefresh, now + RBUS_CONFIG_REFRESH_PERIOD, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&gRefreshMutex);
+}
+
+static void elementTimeoutDestroy(void* p)
+{
+    rbusElementTimeout_t* et = p;
+    free(et->name);
+    free(et);
+}
+
+/* Find the longest element override whose name is a prefix of name, ending at a '.' or at the end of name */
+static int getElementTimeout(rbusElementTimeouts_t timeouts, char const* name, bool get)
+{
+    size_t i, n;
+    size_t bestLen = 0;
+    int timeout = 0;
+
+    if(!timeouts || !name || __atomic_load_n(&timeouts->count, __ATOMIC_RELAXED) == 0)
+        return 0;
+
+    pthread_mutex_lock(&timeouts->mutex);
+    n = rtVector_Size(timeouts->list);
+    for(i = 0; i < n; ++i)
+    {
+        rbusElementTimeout_t* et = rtVector_At(timeouts->list, i);
+        int value = get ? et->getTimeout : et->setTimeout;
+
+        if(value <= 0 || et->len <= bestLen || strncmp(name, et->name, et->len) != 0)
+            continue;
+
+        if(et->name[et->len-1] == '.' || name[et->len] == '\0' || name[et->len] == '.')
+        {
+            bestLen = et->len;
+            timeout = value;
+        }
+    }
+    pthread_mutex_unlock(&timeouts->mutex);
+
+    return timeout;
+}
+
 
 void rbusConfig_CreateOnce()
 {
@@ -48,6 +193,16 @@ void rbusConfig_CreateOnce()
     initInt(gConfig->valueChangePeriod,     RBUS_VALUECHANGE_PERIOD);
     initInt(gConfig->getTimeout,            RBUS_GET_DEFAULT_TIMEOUT);
     initInt(gConfig->setTimeout,            RBUS_SET_DEFAULT_TIMEOUT);
+
+    gConfig->getTimeoutOverride = 0;
+    gConfig->setTimeoutOverride = 0;
+
+    memset(gOverrideFiles, 0, sizeof(gOverrideFiles));
+    gOverrideFiles[0].path = RBUS_GET_TIMEOUT_OVERRIDE;
+    gOverrideFiles[0].value = &gConfig->getTimeoutOverride;
+    gOverrideFiles[1].path = RBUS_SET_TIMEOUT_OVERRIDE;
+    gOverrideFiles[1].value = &gConfig->setTimeoutOverride;
+    __atomic_store_n(&gNextRefresh, 0, __ATOMIC_RELAXED);
 }
 
 void rbusConfig_Destroy()
@@ -67,44 +222,100 @@ rbusConfig_t* rbusConfig_Get()
     return gConfig;
 }
 
-int rbusConfig_ReadGetTimeout()
+int rbusConfig_GetTimeoutFor(rbusHandle_t handle, char const* name)
 {
-    int timeout = 0;
-    FILE *fp = NULL;
-    char buf[25] = {0};
+    int timeout;
 
-    if (access(RBUS_GET_TIMEOUT_OVERRIDE, F_OK) == 0)
-    {
-        fp = fopen(RBUS_GET_TIMEOUT_OVERRIDE, "r");
-        if(fp != NULL) {
-            fread(buf, 1, sizeof(buf), fp);
-            timeout = atoi(buf);
-            fclose(fp);
-        }
-        if (timeout > 0)
-            return timeout * 1000;
-    }
+    refreshOverrideFiles();
 
+    if((timeout = __atomic_load_n(&gConfig->getTimeoutOverride, __ATOMIC_RELAXED)) > 0)
+        return timeout;
+    if(handle && (timeout = getElementTimeout(handle->elementTimeouts, name, true)) > 0)
+        return timeout;
+    if(handle && handle->getTimeout > 0)
+        return handle->getTimeout;
     return gConfig->getTimeout;
 }
 
+int rbusConfig_SetTimeoutFor(rbusHandle_t handle, char const* name)
+{
+    int timeout;
+
+    refreshOverrideFiles();
+
+    if((timeout = __atomic_load_n(&gConfig->setTimeoutOverride, __ATOMIC_RELAXED)) > 0)
+        return timeout;
+    if(handle && (timeout = getElementTimeout(handle->elementTimeouts, name, false)) > 0)
+        return timeout;
+    if(handle && handle->setTimeout > 0)
+        return handle->setTimeout;
+    return gConfig->setTimeout;
+}
+
+int rbusConfig_ReadGetTimeout()
+{
+    return rbusConfig_GetTimeoutFor(NULL, NULL);
+}
+
 int rbusConfig_ReadSetTimeout()
 {
-    int timeout = 0;
-    FILE *fp = NULL;
-    char buf[25] = {0};
+    return rbusConfig_SetTimeoutFor(NULL, NULL);
+}
+
+void rbusElementTimeouts_Create(rbusElementTimeouts_t* timeouts)
+{
+    (*timeouts) = rt_calloc(1, sizeof(struct _rbusElementTimeouts));
+    pthread_mutex_init(&(*timeouts)->mutex, NULL);
+    rtVector_Create(&(*timeouts)->list);
+}
+
+void rbusElementTimeouts_Destroy(rbusElementTimeouts_t timeouts)
+{
+    if(!timeouts)
+        return;
+    rtVector_Destroy(timeouts->list, elementTimeoutDestroy);
+    pthread_mutex_destroy(&timeouts->mutex);
+    free(timeouts);
+}
 
-    if (access(RBUS_SET_TIMEOUT_OVERRIDE, F_OK) == 0)
+void rbusElementTimeouts_Set(rbusElementTimeouts_t timeouts, char const* name, int getTimeout, int setTimeout)
+{
+    size_t i, n;
+    size_t len = strlen(name);
+    rbusElementTimeout_t* et = NULL;
+
+    pthread_mutex_lock(&timeouts->mutex);
+
+    n = rtVector_Size(timeouts->list);
+    for(i = 0; i < n; ++i)
     {
-        fp = fopen(RBUS_SET_TIMEOUT_OVERRIDE, "r");
-        if(fp != NULL) {
-            fread(buf, 1, sizeof(buf), fp);
-            timeout = atoi(buf);
-            fclose(fp);
+        rbusElementTimeout_t* it = rtVector_At(timeouts->list, i);
+        if(it->len == len && strcmp(it->name, name) == 0)
+        {
+            et = it;
+            break;
         }
-        if (timeout > 0)
-            return timeout * 1000;
     }
 
-    return gConfig->setTimeout;
+    if(getTimeout <= 0 && setTimeout <= 0)
+    {
+        if(et)
+            rtVector_RemoveItem(timeouts->list, et, elementTimeoutDestroy);
+    }
+    else
+    {
+        if(!et)
+        {
+            et = rt_malloc(sizeof(rbusElementTimeout_t));
+            et->name = strdup(name);
+            et->len = len;
+            rtVector_PushBack(timeouts->list, et);
+        }
+        et->getTimeout = getTimeout > 0 ? getTimeout : 0;
+        et->setTimeout = setTimeout > 0 ? setTimeout : 0;
+    }
+
+    __atomic_store_n(&timeouts->count, rtVector_Size(timeouts->list), __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&timeouts->mutex);
 }
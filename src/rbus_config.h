@@ -21,6 +21,7 @@
 #define RBUS_CONFIG_H
 
 #include "rbus.h"
+#include <rtVector.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +35,8 @@ typedef struct _rbusConfig_t
     int             valueChangePeriod;  /* polling period for valuechange detector in miliseconds*/
     int             getTimeout;         /* default timeout in miliseconds for GET API*/
     int             setTimeout;         /* default timeout in miliseconds for SET API*/
+    int             getTimeoutOverride; /* GET timeout in miliseconds from the RBUS_GET_TIMEOUT_OVERRIDE file, 0 if not set*/
+    int             setTimeoutOverride; /* SET timeout in miliseconds from the RBUS_SET_TIMEOUT_OVERRIDE file, 0 if not set*/
 } rbusConfig_t;
 
 void rbusConfig_CreateOnce();
@@ -42,6 +45,22 @@ rbusConfig_t* rbusConfig_Get();
 int rbusConfig_ReadGetTimeout();
 int rbusConfig_ReadSetTimeout();
 
+/* A handle's per-element timeout overrides, matched by longest element name prefix */
+typedef struct _rbusElementTimeouts* rbusElementTimeouts_t;
+
+void rbusElementTimeouts_Create(rbusElementTimeouts_t* timeouts);
+void rbusElementTimeouts_Destroy(rbusElementTimeouts_t timeouts);
+
+/* Override the timeouts in miliseconds for every element whose name starts with name.
+ * A timeout of 0 leaves that timeout unset; setting both to 0 removes the override */
+void rbusElementTimeouts_Set(rbusElementTimeouts_t timeouts, char const* name, int getTimeout, int setTimeout);
+
+/* The timeout to use for a GET/SET request on the named element made through handle.
+ * The first set of: the override file, the handle's element override, the handle override, the default.
+ * handle and name can be NULL */
+int rbusConfig_GetTimeoutFor(rbusHandle_t handle, char const* name);
+int rbusConfig_SetTimeoutFor(rbusHandle_t handle, char const* name);
+
 #ifdef __cplusplus
 }
 #endif
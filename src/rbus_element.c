@@ -23,6 +23,7 @@
 #include <rbus.h>
 #include <assert.h>
 #include "rbus_element.h"
+#include "rbus_atom.h"
 #include "rbus_subscriptions.h"
 #include <rtMemory.h>
 #include <pthread.h>
@@ -38,12 +39,21 @@
     RBUSLOG_ERROR("Error %d:%s running command " #CMD, err, strerror(err)); \
   } \
 }
-#define LOCK() ERROR_CHECK(pthread_mutex_lock(&element_mutex))
-#define UNLOCK() ERROR_CHECK(pthread_mutex_unlock(&element_mutex))
+/* The tree is read far more often (every get, set, publish and subscribe does a lookup)
+   than it is changed (registration and table row add/remove) so lookups only take the
+   read side and can run in parallel. Only functions which change the tree take LOCK(). */
+#define LOCK() ERROR_CHECK(pthread_rwlock_wrlock(&element_lock))
+#define READ_LOCK() ERROR_CHECK(pthread_rwlock_rdlock(&element_lock))
+#define UNLOCK() ERROR_CHECK(pthread_rwlock_unlock(&element_lock))
 
 elementNode* pruneNode = NULL;
-pthread_mutex_t element_mutex;
-static int mutex_init = 0;
+/*statically initialized, so handles opening and closing never re-init or destroy it under other handles' readers.
+  don't let a steady stream of lookups starve row add/remove*/
+#if defined(__GLIBC__) && defined(PTHREAD_RWLOCK_WRITER_NONRECURSIVE_INITIALIZER_NP)
+static pthread_rwlock_t element_lock = PTHREAD_RWLOCK_WRITER_NONRECURSIVE_INITIALIZER_NP;
+#else
+static pthread_rwlock_t element_lock = PTHREAD_RWLOCK_INITIALIZER;
+#endif
 
 //****************************** UTILITY FUNCTIONS ***************************//
 char const* getTypeString(rbusElementType_t type)
@@ -60,6 +70,132 @@ char const* getTypeString(rbusElementType_t type)
 //****************************************************************************//
 
 
+//********************************* NAME INDEX *******************************//
+/*
+    Each tree keeps a hash index on its root node so lookups don't have to walk the
+    sibling lists.  A node's hash is the FNV-1a hash of its full path (built from the
+    names of its ancestors, not from the fullName string) and lookups resolve one path
+    segment at a time by (parent, name) so table row mapping to {i} still works.
+    Table rows with an alias are also indexed by their "[alias]" segment.
+ */
+#define ELEMENT_INDEX_MIN_BUCKETS 64
+
+struct _elementIndex
+{
+    rbusHashTable   names;          /* all nodes by full name */
+    rbusHashTable   aliases;        /* table rows by their [alias] name */
+};
+
+static uint32_t childHash(elementNode* parent, char const* name, size_t len)
+{
+    uint32_t hash = RBUS_HASH_INIT;
+    if(parent->parent)
+        hash = rbusHash_Bytes(parent->nameLink.hash, ".", 1);
+    return rbusHash_Bytes(hash, name, len);
+}
+
+static uint32_t aliasHash(elementNode* row)
+{
+    uint32_t hash = childHash(row->parent, "[", 1);
+    hash = rbusHash_Bytes(hash, row->alias, strlen(row->alias));
+    return rbusHash_Bytes(hash, "]", 1);
+}
+
+static elementIndex* elementIndex_create(void)
+{
+    elementIndex* index = rt_malloc(sizeof(elementIndex));
+    rbusHashTable_Init(&index->names, ELEMENT_INDEX_MIN_BUCKETS);
+    rbusHashTable_Init(&index->aliases, ELEMENT_INDEX_MIN_BUCKETS);
+    return index;
+}
+
+static void elementIndex_destroy(elementIndex* index)
+{
+    VERIFY_NULL(index);
+    rbusHashTable_Clear(&index->names);
+    rbusHashTable_Clear(&index->aliases);
+    free(index);
+}
+
+static elementIndex* elementIndex_get(elementNode* node)
+{
+    while(node->parent)
+        node = node->parent;
+    return node->index;
+}
+
+/*call once the node's name and parent are set*/
+static void elementIndex_add(elementIndex* index, elementNode* node)
+{
+    VERIFY_NULL(index);
+    rbusHashTable_Insert(&index->names, &node->nameLink, childHash(node->parent, node->name, strlen(node->name)));
+}
+
+static void elementIndex_addAlias(elementIndex* index, elementNode* row)
+{
+    VERIFY_NULL(index);
+    rbusHashTable_Insert(&index->aliases, &row->aliasLink, aliasHash(row));
+}
+
+static void elementIndex_remove(elementIndex* index, elementNode* node)
+{
+    VERIFY_NULL(index);
+    rbusHashTable_Remove(&index->names, &node->nameLink);
+    if(node->alias && node->parent)
+        rbusHashTable_Remove(&index->aliases, &node->aliasLink);
+}
+
+static elementNode* elementIndex_findChild(elementIndex* index, elementNode* parent, char const* name, size_t len)
+{
+    rbusHashLink* link;
+
+    if(!index)
+        return NULL;
+    for(link = rbusHashTable_Find(&index->names, childHash(parent, name, len)); link; link = rbusHashTable_FindNext(link))
+    {
+        elementNode* node = rbusHashTable_Entry(link, elementNode, nameLink);
+        if(node->parent == parent && strncmp(node->name, name, len) == 0 && node->name[len] == 0)
+            return node;
+    }
+    return NULL;
+}
+
+/*token is the full "[alias]" path segment*/
+static elementNode* elementIndex_findAlias(elementIndex* index, elementNode* table, char const* token, size_t len)
+{
+    rbusHashLink* link;
+
+    if(!index)
+        return NULL;
+    for(link = rbusHashTable_Find(&index->aliases, childHash(table, token, len)); link; link = rbusHashTable_FindNext(link))
+    {
+        elementNode* node = rbusHashTable_Entry(link, elementNode, aliasLink);
+        if(node->parent == table && strlen(node->alias) == len-2 && strncmp(node->alias, token+1, len-2) == 0)
+            return node;
+    }
+    return NULL;
+}
+
+/*returns the next dot separated segment in *path and advances *path past it, or NULL at the end*/
+static char const* nextPathToken(char const** path, size_t* len)
+{
+    char const* token = *path;
+    char const* end;
+
+    while(*token == '.')
+        token++;
+    if(*token == 0)
+        return NULL;
+    end = strchr(token, '.');
+    if(!end)
+        end = token + strlen(token);
+    *len = end - token;
+    *path = end;
+    return token;
+}
+//****************************************************************************//
+
+
 //********************************* FUNCTIONS ********************************//
 elementNode* getEmptyElementNode(void)
 {
@@ -70,7 +206,7 @@ elementNode* getEmptyElementNode(void)
     return node;
 }
 
-static void freeElementRecurse(elementNode* node)
+static void freeElementRecurse(elementNode* node, elementIndex* index)
 {
     VERIFY_NULL(node);
     elementNode* child = node->child;
@@ -79,21 +215,17 @@ static void freeElementRecurse(elementNode* node)
     {
         elementNode* tmp = child;
         child = child->nextSibling;
-        freeElementRecurse(tmp);
+        freeElementRecurse(tmp, index);
     }
 
-    if (node->name)
-    {
-        free(node->name);
-    }
+    elementIndex_remove(index, node);
+
+    rbusAtom_Release(node->name);
     if (node->fullName)
     {
         free(node->fullName);
     }
-    if (node->alias)
-    {
-        free(node->alias);
-    }
+    rbusAtom_Release(node->alias);
     if (node->subscriptions)
     {
         rtList_Destroy(node->subscriptions, NULL);
@@ -112,12 +244,20 @@ void freeElementNode(elementNode* node)
     VERIFY_NULL(node);
     elementNode* parent = node->parent;
     elementNode* child = node->child;
+    /*when freeing the root the whole index goes away so there's no need to unindex each node*/
+    elementIndex* index = parent ? elementIndex_get(node) : NULL;
 
     while(child)
     {
         elementNode* tmp = child;
         child = child->nextSibling;
-        freeElementRecurse(tmp);
+        freeElementRecurse(tmp, index);
+    }
+
+    elementIndex_remove(index, node);
+    if (node->index)
+    {
+        elementIndex_destroy(node->index);
     }
 
     if(parent)
@@ -141,18 +281,20 @@ void freeElementNode(elementNode* node)
         }
     }
 
-    if (node->name)
+    /*the root's name is set by whoever created the tree, all other names are atoms*/
+    if (!parent)
     {
-        free(node->name);
+        free((char*)node->name);
     }
-    if (node->fullName)
+    else
     {
-        free(node->fullName);
+        rbusAtom_Release(node->name);
     }
-    if (node->alias)
+    if (node->fullName)
     {
-        free(node->alias);
+        free(node->fullName);
     }
+    rbusAtom_Release(node->alias);
     if (node->subscriptions)
     {
         rtList_Destroy(node->subscriptions, NULL);
@@ -216,6 +358,7 @@ static void createElementChain(elementNode* node, elementNode*** chainOut, int*
 }
 
 static void replicateAcrossTableRowInstances(elementNode* newNode);
+static void materializeTableRowByName(elementNode* root, char const* rowName);
 
 elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
 {
@@ -227,21 +370,17 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
     elementNode* nextNode = NULL;
     int ret = 0, createChild = 0;
     char buff[RBUS_MAX_NAME_LENGTH];
-    pthread_mutexattr_t attrib;
-
-    if(!mutex_init)
-    {
-       ERROR_CHECK(pthread_mutexattr_init(&attrib));
-       ERROR_CHECK(pthread_mutexattr_settype(&attrib, PTHREAD_MUTEX_ERRORCHECK));
-       ERROR_CHECK(pthread_mutex_init(&element_mutex, &attrib));
-       mutex_init = 1;
-    }
 
     LOCK();
     if(currentNode == NULL || elem == NULL)
     {
+        UNLOCK();
         return NULL;
     }
+    if(!root->index)
+    {
+        root->index = elementIndex_create();
+    }
     nextNode = currentNode->child;
     createChild = 1;
 
@@ -294,7 +433,8 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
                     snprintf(buff, RBUS_MAX_NAME_LENGTH, "%s.%s", currentNode->fullName, token);
                     tempNode->fullName = strdup(buff);
                 }
-                tempNode->name = strdup(token);
+                tempNode->name = rbusAtom_Intern(token, strlen(token));
+                elementIndex_add(root->index, tempNode);
                 currentNode->child = tempNode;
                 currentNode = tempNode;
                 nextNode = currentNode->child;
@@ -327,7 +467,8 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
                         snprintf(buff, RBUS_MAX_NAME_LENGTH, "%s", token);
                     RBUSLOG_DEBUG("Full name [%s]", buff);
                     tempNode->fullName = strdup(buff);
-                    tempNode->name = strdup(token);
+                    tempNode->name = rbusAtom_Intern(token, strlen(token));
+                    elementIndex_add(root->index, tempNode);
                     currentNode->nextSibling = tempNode;
                     currentNode = tempNode;
                     createChild = 1;
@@ -351,9 +492,10 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
         {
             elementNode* rowTemplate = getEmptyElementNode();
             rowTemplate->parent = currentNode;
-            rowTemplate->name = strdup("{i}");
+            rowTemplate->name = rbusAtom_Intern("{i}", 3);
             snprintf(buff, RBUS_MAX_NAME_LENGTH, "%s.%s", currentNode->fullName, rowTemplate->name);
             rowTemplate->fullName = strdup(buff);
+            elementIndex_add(root->index, rowTemplate);
             currentNode->child = rowTemplate;
         }
     }
@@ -374,86 +516,36 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem)
 
 elementNode* retrieveElement(elementNode* root, const char* elmentName)
 {
-    char* token = NULL;
-    char* name = NULL;
-    char* saveptr = NULL;
+    char const* path = elmentName;
+    char const* token = NULL;
+    size_t len = 0;
     elementNode* currentNode = root;
-    elementNode* nextNode = NULL;
     int tokenFound = 0;
 
-    LOCK();
     RBUSLOG_DEBUG("<%s>: Request to retrieve element [%s]", __FUNCTION__, elmentName);
-    if(currentNode == NULL)
+    if(currentNode == NULL || elmentName == NULL)
     {
         return NULL;
     }
 
-    name = strdup(elmentName);
-
-    nextNode = currentNode->child;
-
+    READ_LOCK();
     /*TODO if name is a table row with an alias containing a dot, this will break (e.g. "Foo.[alias.1]")*/
-    token = strtok_r(name, ".", &saveptr);
-    while( token != NULL)
+    while((token = nextPathToken(&path, &len)) != NULL)
     {
-        RBUSLOG_DEBUG("Token = [%s]", token);
-        tokenFound = 0;
-        if(nextNode == NULL)
-        {
-            break;
-        }
-
-        RBUSLOG_DEBUG("child name=[%s], Token = [%s]", nextNode->name, token);
-        /*
-        if(nextNode->type == RBUS_ELEMENT_TYPE_TABLE)
-        {
-            assert(strcmp(nextNode->name, "{i}") == 0);
-            tokenFound = 1;
-            currentNode = nextNode;
-            nextNode = currentNode->child;
-        }
-        else*/
-        if(strcmp(nextNode->name, token) == 0)
-        {
-            RBUSLOG_DEBUG("tokenFound!");
-            tokenFound = 1;
-            currentNode = nextNode;
-            nextNode = currentNode->child;
-        }
-        else
+        if(currentNode->type == RBUS_ELEMENT_TYPE_TABLE)
         {
-            currentNode = nextNode;
-            nextNode = currentNode->nextSibling;
-
-            while(nextNode != NULL)
-            {
-                RBUSLOG_DEBUG("child name=[%s], Token = [%s]", nextNode->name, token);
-                if(strcmp(nextNode->name, token) == 0)
-                {
-                    RBUSLOG_DEBUG("tokenFound!");
-                    tokenFound = 1;
-                    currentNode = nextNode;
-                    nextNode = currentNode->child;
-                    break;
-                }
-                else
-                {
-                    currentNode = nextNode;
-                    nextNode = currentNode->nextSibling;
-                }
-            }
+            /* retrieveElement should only return regististration elements, not table row instantiated elements */
+            token = "{i}";
+            len = 3;
         }
 
-        token = strtok_r(NULL, ".", &saveptr);
-
-        if(token && nextNode && nextNode->parent && nextNode->parent->type == RBUS_ELEMENT_TYPE_TABLE)
+        currentNode = elementIndex_findChild(root->index, currentNode, token, len);
+        tokenFound = currentNode != NULL;
+        if(!tokenFound)
         {
-            /* retrieveElement should only return regististration elements, not table row instantiated elements */
-            token = "{i}";
+            break;
         }
     }
-
-    free(name);
     UNLOCK();
 
     if(tokenFound)
@@ -467,109 +559,99 @@ elementNode* retrieveElement(elementNode* root, const char* elmentName)
     }
 }
 
-elementNode* retrieveInstanceElement(elementNode* root, const char* elmentName)
+/*
+    Table rows are created virtual: only the row node itself is instantiated and its children
+    stay in the row template until something needs them as instance nodes (a subscription that
+    matches in the row, a set, a nested row, or a lookup with materialize set).
+    Without materialize, names under a virtual row resolve to the registration nodes of the
+    row template, which have the same type and callbacks, so gets don't copy the row.
+ */
+static elementNode* retrieveInstanceElementInternal(elementNode* root, const char* elmentName, bool materialize)
 {
-    char* token = NULL;
-    char* name = NULL;
-    char* saveptr = NULL;
-    elementNode* currentNode = root;
+    char const* path;
+    char const* token = NULL;
+    size_t len = 0;
+    elementNode* currentNode;
     elementNode* nextNode = NULL;
-    int tokenFound = 0;
-    bool isWildcard = false;
+    int tokenFound;
+    bool isWildcard;
+    bool inTemplate;
 
     RBUSLOG_DEBUG("<%s>: Request to retrieve element [%s]", __FUNCTION__, elmentName);
-    LOCK();
-    if(currentNode == NULL)
+    if(root == NULL || elmentName == NULL)
     {
         return NULL;
     }
 
-    name = strdup(elmentName);
-
-    nextNode = currentNode->child;
+retry:
+    path = elmentName;
+    currentNode = root;
+    tokenFound = 0;
+    isWildcard = false;
+    inTemplate = false;
 
+    READ_LOCK();
     /*TODO if name is a table row with an alias containing a dot, this will break (e.g. "Foo.[alias.1]")*/
-    token = strtok_r(name, ".", &saveptr);
-    while( token != NULL)
+    while((token = nextPathToken(&path, &len)) != NULL)
     {
-        RBUSLOG_DEBUG("Token = [%s]", token);
-        tokenFound = 0;
-
-        if(nextNode == NULL)
-        {
-            break;
-        }
+        bool isTable = currentNode->type == RBUS_ELEMENT_TYPE_TABLE;
 
-        RBUSLOG_DEBUG("child name=[%s], Token = [%s]", nextNode->name, token);
-
-        if(strcmp(nextNode->name, token) == 0)
-        {
-            RBUSLOG_DEBUG("tokenFound!");
-            tokenFound = 1;
-            currentNode = nextNode;
-            nextNode = currentNode->child;
-        }
-        else
+        if(currentNode->virtualRow)
         {
-            currentNode = nextNode;
-            nextNode = currentNode->nextSibling;
-
-            while(nextNode != NULL)
+            if(materialize)
             {
-                RBUSLOG_DEBUG("child name=[%s], Token = [%s]", nextNode->name, token);
-                if(strcmp(nextNode->name, token) == 0)
-                {
-                    RBUSLOG_DEBUG("tokenFound!");
-                    tokenFound = 1;
-                    currentNode = nextNode;
-                    nextNode = currentNode->child;
-                    break;
-                }
-                else
-                {
-                    /*check the alias if its a table row*/
-                    if(nextNode->parent->type == RBUS_ELEMENT_TYPE_TABLE)
-                    {
-                        if(nextNode->alias)
-                        {
-                            size_t tlen = strlen(token);
-                            if(tlen > 2 && token[0] == '[' && token[tlen-1] == ']')
-                            {
-                                if(strlen(nextNode->alias) == tlen-2 && strncmp(nextNode->alias, token+1, tlen-2) == 0)
-                                {
-                                    RBUSLOG_DEBUG("tokenFound by alias %s!", nextNode->alias);
-                                    tokenFound = 1;
-                                    currentNode = nextNode;
-                                    nextNode = currentNode->child;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
-                    currentNode = nextNode;
-                    nextNode = currentNode->nextSibling;
-                }
+                /*materializing needs the write lock, and the tree may change once we let go of the read lock,
+                  so only the row's name, everything before the current token, is carried over*/
+                size_t rowNameLen = token - elmentName;
+                char* rowName = rt_malloc(rowNameLen + 1);
+                memcpy(rowName, elmentName, rowNameLen);
+                rowName[rowNameLen] = 0;
+                UNLOCK();
+                materializeTableRowByName(root, rowName);
+                free(rowName);
+                goto retry;
             }
+            currentNode = currentNode->regNode;
+            inTemplate = true;
         }
 
-        token = strtok_r(NULL, ".", &saveptr);
+        /*a virtual row has no nested rows, so under its template only * or {i} can name a nested row*/
+        if(isTable && inTemplate && !isWildcard && !currentNode->cbTable.getHandler &&
+           !(len == 1 && token[0] == '*') && !(len == 3 && strncmp(token, "{i}", 3) == 0))
+        {
+            tokenFound = 0;
+            break;
+        }
 
-        if(token && nextNode && nextNode->parent && nextNode->parent->type == RBUS_ELEMENT_TYPE_TABLE) 
+        if(isTable)
         {
-            if(!isWildcard && !strcmp(token,"*"))
+            if(!isWildcard && len == 1 && token[0] == '*')
                 isWildcard = true;
-            
+
             /* retrieveInstanceElement should return only the registration element if the table has a getHandler installed (used by MtaAgent/TR104)
                 of if wildcard query */
-            if(isWildcard || nextNode->parent->cbTable.getHandler)
+            if(isWildcard || currentNode->cbTable.getHandler)
             {
                 token = "{i}";
+                len = 3;
             }
-        }        
-    }
+        }
 
-    free(name);
+        nextNode = elementIndex_findChild(root->index, currentNode, token, len);
+
+        /*check the alias if its a table row*/
+        if(!nextNode && isTable && len > 2 && token[0] == '[' && token[len-1] == ']')
+        {
+            nextNode = elementIndex_findAlias(root->index, currentNode, token, len);
+        }
+
+        currentNode = nextNode;
+        tokenFound = currentNode != NULL;
+        if(!tokenFound)
+        {
+            break;
+        }
+    }
     UNLOCK();
 
     if(tokenFound)
@@ -583,11 +665,43 @@ elementNode* retrieveInstanceElement(elementNode* root, const char* elmentName)
     }
 }
 
+elementNode* retrieveInstanceElement(elementNode* root, const char* elmentName)
+{
+    return retrieveInstanceElementInternal(root, elmentName, true);
+}
+
+elementNode* lookupInstanceElement(elementNode* root, const char* elmentName)
+{
+    return retrieveInstanceElementInternal(root, elmentName, false);
+}
+
+/*whether node is in a table's row template, as lookupInstanceElement returns for the elements of a virtual row*/
+bool isRowTemplateElement(elementNode* node)
+{
+    for(; node; node = node->parent)
+    {
+        if(node->name && strcmp(node->name, "{i}") == 0)
+            return true;
+    }
+    return false;
+}
+
+/*returns the registration node that node was instantiated from, or node itself if it was registered*/
+elementNode* getRegistrationElement(elementNode* node)
+{
+    if(node && node->regNode)
+        return node->regNode;
+    return node;
+}
+
 static void removeElementInternal(elementNode* rowNode, elementNode** chain, int numChain)
 {
     VERIFY_NULL(rowNode);
     elementNode* currentNode = rowNode;
     int i = 0;
+    /*nothing to remove from a virtual row, which only has the nodes of its template*/
+    if(rowNode->virtualRow)
+        return;
 #if DEBUG_ELEMENTS
     printf("\n\nremoveElementInternal %s\n", rowNode->fullName);
     for(i = 0; i < numChain; ++i){
@@ -632,7 +746,7 @@ static void removeElementInternal(elementNode* rowNode, elementNode** chain, int
             
             while(childNode)
             {
-                if(strcmp(childNode->name, chainNode->name) == 0)
+                if(childNode->name == chainNode->name)
                 {
                     if(numChain-i-1 > 0)
                     {
@@ -655,7 +769,7 @@ static void removeElementInternal(elementNode* rowNode, elementNode** chain, int
 
             while(childNode)
             {
-                if(strcmp(childNode->name, chainNode->name) == 0)
+                if(childNode->name == chainNode->name)
                 {
                     if(i == numChain-1)
                     {
@@ -749,30 +863,41 @@ static void fprintElement(FILE* f, elementNode* node, int level)
         node->alias ? node->alias : "");
 }
 
+/*print the nodes a virtual row would have once materialized, named under the row*/
+static void fprintVirtualRowElements(FILE* f, elementNode* row, elementNode* node, int level)
+{
+    while(node)
+    {
+        char fullName[RBUS_MAX_NAME_LENGTH];
+        snprintf(fullName, RBUS_MAX_NAME_LENGTH, "%s%s", row->fullName, node->fullName + strlen(row->regNode->fullName));
+        fprintf(f, "%*s%s:%s %s \n", 
+            level*2, level ? " " : "",
+            node->name, 
+            getTypeString(node->type),
+            fullName);
+        fprintVirtualRowElements(f, row, node->child, level+1);
+        node = node->nextSibling;
+    }
+}
+
 void fprintRegisteredElements(FILE* f, elementNode* root, int level)
 {
     VERIFY_NULL(f);
     elementNode* child = root;
-    elementNode* sibling = NULL;
     VERIFY_NULL(child);
 
-    if(child)
+    while(child)
     {
         fprintElement(f, child, level);
         if(child->child)
         {
             fprintRegisteredElements(f, child->child, level+1);
         }
-        sibling = child->nextSibling;
-        while(sibling)
+        else if(child->virtualRow)
         {
-            fprintElement(f, sibling, level);
-            if(sibling->child)
-            {
-                fprintRegisteredElements(f, sibling->child, level+1);
-            }
-            sibling = sibling->nextSibling;
+            fprintVirtualRowElements(f, child, child->regNode->child, level+1);
         }
+        child = child->nextSibling;
     }
 }
 
@@ -848,7 +973,8 @@ bool elementHasAutoPubSubscriptions(elementNode* node, rbusSubscription_t* exclu
             rtListItem_GetData(item, (void**)&sub);
             if(!sub)
                 return false;
-            if(sub->autoPublish)
+            /*interval subscriptions without a filter get periodic samples instead of value-change*/
+            if(sub->autoPublish && !(sub->interval > 0 && !sub->filter))
             {
                 if(excluding != sub)
                 {
@@ -862,6 +988,34 @@ bool elementHasAutoPubSubscriptions(elementNode* node, rbusSubscription_t* exclu
     return false;
 }
 
+int32_t elementGetAutoPubInterval(elementNode* node, rbusSubscription_t* excluding)
+{
+    int32_t interval = 0;
+
+    if(!node)
+        return 0;
+    if(node->subscriptions)
+    {
+        rtListItem item;
+        rbusSubscription_t* sub;
+
+        rtList_GetFront(node->subscriptions, &item);
+
+        while(item)
+        {
+            rtListItem_GetData(item, (void**)&sub);
+            if(sub && sub->autoPublish && sub != excluding && sub->interval > 0 && sub->filter)
+            {
+                if(interval == 0 || sub->interval < interval)
+                    interval = sub->interval;
+            }
+
+            rtListItem_GetNext(item, &item);
+        }
+    }
+    return interval;
+}
+
 /*
     Example tree:
 
@@ -889,38 +1043,62 @@ bool elementHasAutoPubSubscriptions(elementNode* node, rbusSubscription_t* exclu
     Device.WiFi.AccessPoint.1.AssociatedDevice.{i}.SignalStrength
 
  */
-static elementNode* duplicateNode(elementNode* sourceNode, elementNode* parentNode, char const* name )
+/*copy sourceNode, but not its children, as a child of parentNode without linking it into parentNode's child list*/
+static elementNode* copySingleNode(elementIndex* index, elementNode* sourceNode, elementNode* parentNode, char const* name )
 {
     elementNode* node;
-    elementNode* child;
     char fullName[RBUS_MAX_NAME_LENGTH];
     node = getEmptyElementNode();
 
     snprintf(fullName, RBUS_MAX_NAME_LENGTH, "%s.%s", parentNode->fullName, name);
     node->fullName = strdup(fullName);
-    node->name = strdup(name);
+    node->name = rbusAtom_Intern(name, strlen(name));
     node->type = sourceNode->type;
     node->cbTable = sourceNode->cbTable;
+    node->valueChangeNotify = sourceNode->valueChangeNotify;
+    node->regNode = getRegistrationElement(sourceNode);
     node->parent = parentNode;
+    elementIndex_add(index, node);
+
+    return node;
+}
+
+/*add a list of new nodes, linked by nextSibling, to the end of parentNode's child list*/
+static void appendChildNodes(elementNode* parentNode, elementNode* nodes)
+{
+    elementNode* child;
 
-    /*add new node to the parent's child list*/
     if(parentNode->child)
     {
         child = parentNode->child;
         while(child->nextSibling)
             child = child->nextSibling;
-        child->nextSibling = node;
+        child->nextSibling = nodes;
     }
     else
     {
-        parentNode->child = node;
+        parentNode->child = nodes;
     }
+}
+
+/*copy sourceNode, but not its children, and add the copy to the end of parentNode's child list*/
+static elementNode* duplicateSingleNode(elementIndex* index, elementNode* sourceNode, elementNode* parentNode, char const* name )
+{
+    elementNode* node = copySingleNode(index, sourceNode, parentNode, name);
+    appendChildNodes(parentNode, node);
+    return node;
+}
+
+static elementNode* duplicateNode(elementIndex* index, elementNode* sourceNode, elementNode* parentNode, char const* name )
+{
+    elementNode* node = duplicateSingleNode(index, sourceNode, parentNode, name);
+    elementNode* child;
 
     /*duplicate children of sourceNode*/
     child = sourceNode->child;
     while(child)
     {
-        duplicateNode(child, node, child->name);
+        duplicateNode(index, child, node, child->name);
         child = child->nextSibling;
     }
 
@@ -952,15 +1130,49 @@ static elementNode* duplicateNode(elementNode* sourceNode, elementNode* parentNo
         Duplicate the entire node tree under Device.WiFi.AccessPoint.{i}.
         Set the parent of the duplicated node tree to Device.WiFi.AccessPoint.1.
 
+    Only the first step is done here.  The row is left virtual and the other two
+    are done by materializeTableRow when the row's children are first needed.
+
     @param tableNode        The node with name {i} of type RBUS_ELEMENT_TYPE_TABLE
     @param instNum          The new row's instance number
     @param alias            The new row's instance alias (Optional)
 */
 
+static elementNode* findRowTemplate(elementNode* tableNode)
+{
+    elementNode* rowTemplate = tableNode->child;
+    while(rowTemplate)
+    {
+        if(strcmp(rowTemplate->name, "{i}") == 0)
+            break;
+        rowTemplate = rowTemplate->nextSibling;
+    }
+    return rowTemplate;
+}
+
+/*create a virtual row from rowTemplate without linking it into tableNode's child list*/
+static elementNode* copyTableRow(elementIndex* index, elementNode* tableNode, elementNode* rowTemplate, uint32_t instNum, char const* alias)
+{
+    elementNode* row;
+    char name[32];
+
+    snprintf(name, 32, "%u", instNum);
+
+    row = copySingleNode(index, rowTemplate, tableNode, name);
+    row->virtualRow = getRegistrationElement(rowTemplate)->child != NULL;
+
+    if(alias)
+    {
+        row->alias = rbusAtom_Intern(alias, strlen(alias));
+        elementIndex_addAlias(index, row);
+    }
+    return row;
+}
+
 elementNode* instantiateTableRow(elementNode* tableNode, uint32_t instNum, char const* alias)
 {
     elementNode* rowTemplate;
-    char name[32];
+    elementNode* row;
     if(!tableNode)
         return NULL;
 
@@ -982,30 +1194,18 @@ elementNode* instantiateTableRow(elementNode* tableNode, uint32_t instNum, char
 #endif
 
     /*find the row template which has name="{i}"*/
-
-    rowTemplate = tableNode->child;
-    while(rowTemplate)
-    {
-        if(strcmp(rowTemplate->name, "{i}") == 0)
-            break;
-        rowTemplate = rowTemplate->nextSibling;
-    }
+    rowTemplate = findRowTemplate(tableNode);
 
     if(!rowTemplate)
     {
         assert(false);
         RBUSLOG_ERROR("%s ERROR: row template not found for table %s", __FUNCTION__, tableNode->fullName);
+        UNLOCK();
         return NULL;
     }
 
-    snprintf(name, 32, "%u", instNum);
-
-    elementNode* row = duplicateNode(rowTemplate, tableNode, name);
-
-    if(alias)
-    {
-        row->alias = strdup(alias);
-    }
+    row = copyTableRow(elementIndex_get(tableNode), tableNode, rowTemplate, instNum, alias);
+    appendChildNodes(tableNode, row);
 
 #if DEBUG_ELEMENTS
     {
@@ -1022,6 +1222,155 @@ elementNode* instantiateTableRow(elementNode* tableNode, uint32_t instNum, char
     return row;
 }
 
+/*
+    Instantiate numRows rows in one pass over the tree, the same as calling
+    instantiateTableRow for each.  The new rows are linked into the table together.
+    A row whose instance number or alias is already in the table, including one earlier
+    in the same batch, is skipped and its rows[] entry is set to NULL.
+
+    @param tableNode        The table node
+    @param numRows          Number of rows
+    @param instNums         The new rows' instance numbers
+    @param aliases          The new rows' aliases.  Either the array or any entry can be NULL
+    @param rows             Output, the new rows
+    @return the number of rows instantiated
+*/
+int instantiateTableRows(elementNode* tableNode, int numRows, uint32_t const* instNums, char const* const* aliases, elementNode** rows)
+{
+    elementNode* rowTemplate;
+    elementNode* first = NULL;
+    elementNode* last = NULL;
+    elementIndex* index;
+    char name[32];
+    int count = 0;
+    int i;
+
+    if(!tableNode || numRows <= 0)
+        return 0;
+
+    LOCK();
+    rowTemplate = findRowTemplate(tableNode);
+
+    if(!rowTemplate)
+    {
+        RBUSLOG_ERROR("%s ERROR: row template not found for table %s", __FUNCTION__, tableNode->fullName);
+        UNLOCK();
+        for(i = 0; i < numRows; ++i)
+            rows[i] = NULL;
+        return 0;
+    }
+
+    index = elementIndex_get(tableNode);
+
+    for(i = 0; i < numRows; ++i)
+    {
+        char const* alias = aliases ? aliases[i] : NULL;
+        size_t len = (size_t)snprintf(name, 32, "%u", instNums[i]);
+
+        rows[i] = NULL;
+
+        if(elementIndex_findChild(index, tableNode, name, len))
+        {
+            RBUSLOG_WARN("%s: row %s.%s already exists", __FUNCTION__, tableNode->fullName, name);
+            continue;
+        }
+
+        if(alias)
+        {
+            char aliasToken[RBUS_MAX_NAME_LENGTH];
+            int aliasLen = snprintf(aliasToken, RBUS_MAX_NAME_LENGTH, "[%s]", alias);
+
+            if(aliasLen < RBUS_MAX_NAME_LENGTH && elementIndex_findAlias(index, tableNode, aliasToken, (size_t)aliasLen))
+            {
+                RBUSLOG_WARN("%s: row %s.[%s] already exists", __FUNCTION__, tableNode->fullName, alias);
+                continue;
+            }
+        }
+
+        rows[i] = copyTableRow(index, tableNode, rowTemplate, instNums[i], alias);
+
+        if(last)
+            last->nextSibling = rows[i];
+        else
+            first = rows[i];
+        last = rows[i];
+        count++;
+    }
+
+    if(first)
+        appendChildNodes(tableNode, first);
+
+    UNLOCK();
+    return count;
+}
+
+/*copy the row template's children into a virtual row*/
+/*must be called with the write lock held*/
+static void materializeRow(elementNode* rowNode)
+{
+    elementIndex* index;
+    elementNode* child;
+
+    if(rowNode->virtualRow)
+    {
+        index = elementIndex_get(rowNode);
+        child = rowNode->regNode->child;
+        while(child)
+        {
+            duplicateNode(index, child, rowNode, child->name);
+            child = child->nextSibling;
+        }
+        rowNode->virtualRow = false;
+    }
+}
+
+void materializeTableRow(elementNode* rowNode)
+{
+    VERIFY_NULL(rowNode);
+    LOCK();
+    materializeRow(rowNode);
+    UNLOCK();
+}
+
+/*  materialize the row named rowName, for callers that found it under the read lock and had to let go
+    of it to take the write lock, in which time the row may have been deleted.  a virtual row is only
+    reached through instance nodes, so it's looked up again without templates or wildcards */
+static void materializeTableRowByName(elementNode* root, char const* rowName)
+{
+    char const* path = rowName;
+    char const* token;
+    size_t len = 0;
+    elementNode* node = root;
+
+    LOCK();
+    while(node && (token = nextPathToken(&path, &len)) != NULL)
+    {
+        elementNode* next = elementIndex_findChild(root->index, node, token, len);
+
+        if(!next && node->type == RBUS_ELEMENT_TYPE_TABLE && len > 2 && token[0] == '[' && token[len-1] == ']')
+            next = elementIndex_findAlias(root->index, node, token, len);
+        node = next;
+    }
+    if(node)
+        materializeRow(node);
+    UNLOCK();
+}
+
+/*delete numRows rows in one pass over the tree, the same as calling deleteTableRow for each*/
+void deleteTableRows(elementNode** rows, int numRows)
+{
+    int i;
+
+    VERIFY_NULL(rows);
+    LOCK();
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i])
+            freeElementNode(rows[i]);
+    }
+    UNLOCK();
+}
+
 void deleteTableRow(elementNode* rowNode)
 {
     VERIFY_NULL(rowNode);
@@ -1060,11 +1409,15 @@ void deleteTableRow(elementNode* rowNode)
     UNLOCK();
 }
 
-void replicateAcrossTableRowInstancesInternal(elementNode* rowNode, elementNode* chain[], int numChain)
+void replicateAcrossTableRowInstancesInternal(elementIndex* index, elementNode* rowNode, elementNode* chain[], int numChain)
 {
     elementNode* currentNode;
     int i;
 
+    /*a virtual row gets the new node from its template when it's materialized*/
+    if(rowNode->virtualRow)
+        return;
+
 #if DEBUG_ELEMENTS
     printf("replicateAcrossTableRowInstancesInternal %s\n", rowNode->fullName);
     for(i = 0; i < numChain; ++i)
@@ -1085,7 +1438,7 @@ void replicateAcrossTableRowInstancesInternal(elementNode* rowNode, elementNode*
             while(childNode)
             {
                 //replicate for instance and template (this is internal table)
-                replicateAcrossTableRowInstancesInternal(childNode, &chain[i+1], numChain-i-1);
+                replicateAcrossTableRowInstancesInternal(index, childNode, &chain[i+1], numChain-i-1);
                 childNode = childNode->nextSibling;
             }
 
@@ -1098,7 +1451,7 @@ void replicateAcrossTableRowInstancesInternal(elementNode* rowNode, elementNode*
 
             while(childNode)
             {
-                if(strcmp(childNode->name, chain[i]->name) == 0)
+                if(childNode->name == chain[i]->name)
                 {
                     break;
                 }
@@ -1116,7 +1469,7 @@ void replicateAcrossTableRowInstancesInternal(elementNode* rowNode, elementNode*
             }
             else
             {
-                duplicateNode(chain[i], currentNode, chain[i]->name);
+                duplicateNode(index, chain[i], currentNode, chain[i]->name);
                 break;
             }
         }
@@ -1145,7 +1498,7 @@ void replicateAcrossTableRowInstances(elementNode* newNode)
                 /*if row*/
                 if(childNode->type == 0 && strcmp(childNode->name, "{i}") != 0)
                 {
-                    replicateAcrossTableRowInstancesInternal(childNode, &chain[i+1], numChain-i-1);
+                    replicateAcrossTableRowInstancesInternal(chain[0]->index, childNode, &chain[i+1], numChain-i-1);
                 }
 
                 childNode = childNode->nextSibling;
@@ -1169,11 +1522,3 @@ void setPropertyChangeComponent(elementNode* node, char const* componentName)
 
 }
 
-void rbusElement_mutex_destroy(void)
-{
-    if(mutex_init)
-    {
-      ERROR_CHECK(pthread_mutex_destroy(&element_mutex));
-      mutex_init = 0;
-    }
-}
@@ -27,6 +27,7 @@
 #include <rtVector.h>
 #include <rtTime.h>
 #include "rbus_log.h"
+#include "rbus_hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +36,11 @@ extern "C" {
 /******************************** STRUCTURES **********************************/
 typedef struct elementNode elementNode;
 typedef struct _rbusSubscription rbusSubscription_t;
+typedef struct _elementIndex elementIndex;
 
 typedef struct elementNode 
 {
-    char*                   name;           /* relative name of element */
+    char const*             name;           /* relative name of element, an atom (see rbus_atom.h) except on the root */
     char*                   fullName;       /* full name/path of element */
     elementNode*            parent;         /* Up */
     elementNode*            child;          /* Downward */
@@ -47,9 +49,19 @@ typedef struct elementNode
     rbusElementType_t       type;           /* Type w/ Object=0 */
     rbusCallbackTable_t     cbTable;        /* Callback table for the element */
     rtList                  subscriptions;  /* The list of rbusSubscription_t to this element */
-    char*                   alias;          /* For table rows */
+    char const*             alias;          /* For table rows, an atom */
     char*                   changeComp;     /* For properties, the last component to set the value */
     rtTime_t                changeTime;     /* For properties, the time the value was last set*/
+    bool                    valueChangeNotify; /* For properties, the provider notifies value-changes so polling is off */
+    rbusHashLink            nameLink;       /* in the name index, hashed by full name */
+    rbusHashLink            aliasLink;      /* for table rows with an alias, in the alias index */
+    elementIndex*           index;          /* root only: name index of the whole tree */
+    elementNode*            regNode;        /* for nodes instantiated under table rows, the registration node copied */
+    bool                    virtualRow;     /* table row whose children haven't been copied from its row template (regNode) yet */
+    rbusTableAddRowsHandler_t    tableAddRowsHandler;    /* For registered tables, optional multi-row handlers */
+    rbusTableRemoveRowsHandler_t tableRemoveRowsHandler;
+    rbusGetMultiHandler_t   getMultiHandler; /* Optional multi-property get handler for the element and all below it */
+    rbusSetMultiHandler_t   setMultiHandler; /* Optional multi-property set handler for the element and all below it */
 } elementNode;
 
 
@@ -60,17 +72,23 @@ elementNode* insertElement(elementNode* root, rbusDataElement_t* elem);
 void removeElement(elementNode* element);
 elementNode* retrieveElement(elementNode* root, const char* name);
 elementNode* retrieveInstanceElement(elementNode* root, const char* name);
+elementNode* lookupInstanceElement(elementNode* root, const char* name);
+elementNode* getRegistrationElement(elementNode* node);
+bool isRowTemplateElement(elementNode* node);
 void printRegisteredElements(elementNode* root, int level);
 void fprintRegisteredElements(FILE* f, elementNode* root, int level);
 void addElementSubscription(elementNode* node, rbusSubscription_t* sub, bool checkIfExists);
 void removeElementSubscription(elementNode* node, rbusSubscription_t* sub);
 bool elementHasAutoPubSubscriptions(elementNode* node, rbusSubscription_t* excluding);
+int32_t elementGetAutoPubInterval(elementNode* node, rbusSubscription_t* excluding);
 void addInstanceToElement(elementNode* node, uint32_t instNum, char const* alias);
 elementNode* instantiateTableRow(elementNode* tableNode, uint32_t instNum, char const* alias);
+int instantiateTableRows(elementNode* tableNode, int numRows, uint32_t const* instNums, char const* const* aliases, elementNode** rows);
+void materializeTableRow(elementNode* rowNode);
 void deleteTableRow(elementNode* rowNode);
+void deleteTableRows(elementNode** rows, int numRows);
 void getPropertyInstanceNames(elementNode* root, char const* query, rtVector propNameList);
 void setPropertyChangeComponent(elementNode* node, char const* componentName);
-void rbusElement_mutex_destroy(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,516 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Publish Batching:
+    When a provider turns on batching, events published to a listener are queued instead of sent
+    right away.  All the events queued for a listener are sent together in one message, published
+    with the event name RBUS_EVENT_BATCH_NAME, when either the first of them has waited flushInterval
+    milliseconds or maxBatchSize of them are queued.  The consumer unpacks the message and calls its
+    handlers once per event, in order.  Only subscribers which sent RBUS_EVENT_BATCH_WIRE_VERSION or
+    later with their subscribe request are batched; older ones are still sent each event on its own.
+    A handle's listener batches are hashed by listener name (see rbus_hash.h).
+    If coalescing is on, a value-change of a property which already has a value-change queued for the
+    same subscriber (without a filter) replaces the queued one, keeping the queued event's oldValue.
+    Uses a single thread across all rbus handles, started when batching is first turned on.
+*/
+
+#define _GNU_SOURCE 1 //needed for pthread_mutexattr_settype
+
+#include "rbus_eventbatch.h"
+#include "rbus_handle.h"
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+#include <rtVector.h>
+#include <rtTime.h>
+#include <rtMemory.h>
+
+#define ERROR_CHECK(CMD) \
+{ \
+  int err; \
+  if((err=CMD) != 0) \
+  { \
+    RBUSLOG_ERROR("Error %d:%s running command " #CMD, err, strerror(err)); \
+  } \
+}
+#define VERIFY_NULL(T)      if(NULL == T){ return; }
+#define LOCK() ERROR_CHECK(pthread_mutex_lock(&gEB->mutex))
+#define UNLOCK() ERROR_CHECK(pthread_mutex_unlock(&gEB->mutex))
+#define LISTENER_INDEX_MIN_BUCKETS 16
+
+void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int32_t componentId, rbusMessage msg);
+
+typedef struct EventBatcher_t
+{
+    int              running;
+    rtVector         batches;       //the rbusEventBatch_t of every handle with batching
+    pthread_mutex_t  mutex;
+    pthread_mutex_t  sendMutex;     //held while taking and sending queued events so a listener gets them in order
+    pthread_t        thread;
+    pthread_cond_t   cond;
+} EventBatcher_t;
+
+typedef struct EventBatchEntry
+{
+    char* eventName;            //the event name the subscriber subscribed with
+    char* instanceName;         //the name of the event published
+    int32_t componentId;
+    rbusValue_t oldValue;       //for coalescing value-changes, the oldValue of the first one queued
+    rbusMessage msg;            //the event data
+} EventBatchEntry;
+
+typedef struct ListenerBatch
+{
+    rbusHashLink link;          //hashed by listener, in listenerIndex
+    char* listener;
+    rtVector entries;           //EventBatchEntry queued for the listener
+    rtTime_t deadline;          //when to send the entries
+} ListenerBatch;
+
+struct _rbusEventBatch
+{
+    rbusHandle_t handle;
+    uint32_t flushInterval;     //milliseconds, or 0 if batching is off
+    uint32_t maxBatchSize;      //0 for no limit
+    bool coalesce;
+    rtVector listeners;         //ListenerBatch with queued events
+    rbusHashTable listenerIndex;//the same ListenerBatch, by listener
+};
+
+static EventBatcher_t* gEB = NULL;
+
+static void* rbusEventBatch_threadFunc(void *userData);
+
+static void rbusEventBatch_Init()
+{
+    pthread_mutexattr_t attrib;
+    pthread_condattr_t cattrib;
+
+    RBUSLOG_DEBUG("%s", __FUNCTION__);
+
+    if(gEB)
+        return;
+
+    gEB = rt_malloc(sizeof(struct EventBatcher_t));
+
+    gEB->running = 0;
+    rtVector_Create(&gEB->batches);
+
+    ERROR_CHECK(pthread_mutexattr_init(&attrib));
+    ERROR_CHECK(pthread_mutexattr_settype(&attrib, PTHREAD_MUTEX_ERRORCHECK));
+    ERROR_CHECK(pthread_mutex_init(&gEB->mutex, &attrib));
+    ERROR_CHECK(pthread_mutex_init(&gEB->sendMutex, &attrib));
+
+    ERROR_CHECK(pthread_condattr_init(&cattrib));
+    ERROR_CHECK(pthread_condattr_setclock(&cattrib, CLOCK_MONOTONIC));
+    ERROR_CHECK(pthread_cond_init(&gEB->cond, &cattrib));
+    ERROR_CHECK(pthread_condattr_destroy(&cattrib));
+}
+
+static void eventBatchEntry_Free(void* p)
+{
+    EventBatchEntry* entry = (EventBatchEntry*)p;
+    free(entry->eventName);
+    free(entry->instanceName);
+    if(entry->oldValue)
+        rbusValue_Release(entry->oldValue);
+    rbusMessage_Release(entry->msg);
+    free(entry);
+}
+
+static void listenerBatch_Free(void* p)
+{
+    ListenerBatch* lb = (ListenerBatch*)p;
+    free(lb->listener);
+    rtVector_Destroy(lb->entries, eventBatchEntry_Free);
+    free(lb);
+}
+
+static ListenerBatch* listenerBatch_Find(rbusEventBatch_t batch, char const* listener)
+{
+    rbusHashLink* link;
+    for(link = rbusHashTable_Find(&batch->listenerIndex, rbusHash_String(listener)); link; link = rbusHashTable_FindNext(link))
+    {
+        ListenerBatch* lb = rbusHashTable_Entry(link, ListenerBatch, link);
+        if(strcmp(lb->listener, listener) == 0)
+            return lb;
+    }
+    return NULL;
+}
+
+/*serialize event with oldValue, if not NULL, in place of its own oldValue*/
+static rbusMessage eventBatchEntry_Serialize(rbusSubscription_t* sub, rbusEvent_t* event, rbusValue_t oldValue)
+{
+    rbusMessage msg;
+    rbusEvent_t copy = *event;
+    rbusObject_t data = NULL;
+
+    if(oldValue && event->data)
+    {
+        rbusProperty_t prop;
+
+        rbusObject_Init(&data, rbusObject_GetName(event->data));
+        for(prop = rbusObject_GetProperties(event->data); prop; prop = rbusProperty_GetNext(prop))
+        {
+            char const* name = rbusProperty_GetName(prop);
+            rbusObject_SetValue(data, name, strcmp(name, "oldValue") == 0 ? oldValue : rbusProperty_GetValue(prop));
+        }
+        copy.data = data;
+    }
+
+    rbusMessage_Init(&msg);
+    rbusEventData_appendToMessage(&copy, sub->filter, sub->componentId, msg);
+
+    if(data)
+        rbusObject_Release(data);
+    return msg;
+}
+
+/*send the entries of one listener in a single message.  called without gEB->mutex held*/
+static void listenerBatch_Send(rbusEventBatch_t batch, ListenerBatch* lb)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)batch->handle;
+    rbusMessage msg;
+    size_t i;
+    rbus_error_t err;
+
+    rbusMessage_Init(&msg);
+    rbusMessage_SetInt32(msg, (int32_t)rtVector_Size(lb->entries));
+    for(i=0; i < rtVector_Size(lb->entries); ++i)
+    {
+        EventBatchEntry* entry = (EventBatchEntry*)rtVector_At(lb->entries, i);
+        rbusMessage_SetString(msg, entry->eventName);
+        rbusMessage_SetMessage(msg, entry->msg);
+    }
+
+    RBUSLOG_DEBUG("%s: publishing %zu events to listener %s", __FUNCTION__, rtVector_Size(lb->entries), lb->listener);
+
+    err = rbus_publishSubscriberEvent(handleInfo->componentName, RBUS_EVENT_BATCH_NAME, lb->listener, msg);
+    if(err != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_WARN("%s: rbus_publishSubscriberEvent to %s failed with error %d", __FUNCTION__, lb->listener, err);
+    }
+
+    rbusMessage_Release(msg);
+}
+
+/*take the listener batches which are due, or all of them if all is true, off batch into taken.
+  called with gEB->mutex held*/
+static void rbusEventBatch_TakeDue(rbusEventBatch_t batch, rtTime_t* now, bool all, rtVector taken)
+{
+    size_t i = 0;
+    while(i < rtVector_Size(batch->listeners))
+    {
+        ListenerBatch* lb = (ListenerBatch*)rtVector_At(batch->listeners, i);
+        if(all || rtTime_Compare(&lb->deadline, now) <= 0 ||
+           (batch->maxBatchSize && rtVector_Size(lb->entries) >= batch->maxBatchSize))
+        {
+            rtVector_RemoveItem(batch->listeners, lb, NULL);
+            rbusHashTable_Remove(&batch->listenerIndex, &lb->link);
+            rtVector_PushBack(taken, lb);
+        }
+        else
+        {
+            //only i++ here because rtVector_RemoveItem does a right shift on all the elements after remove index
+            i++;
+        }
+    }
+}
+
+static void rbusEventBatch_SendTaken(rbusEventBatch_t batch, rtVector taken)
+{
+    size_t i;
+    for(i=0; i < rtVector_Size(taken); ++i)
+        listenerBatch_Send(batch, (ListenerBatch*)rtVector_At(taken, i));
+}
+
+static void* rbusEventBatch_threadFunc(void *userData)
+{
+    (void)(userData);
+    RBUSLOG_DEBUG("%s: start", __FUNCTION__);
+    LOCK();
+    while(gEB->running)
+    {
+        size_t i, j;
+        int err;
+        bool haveTimeout = false;
+        rtTime_t timeout, now;
+        rtTimespec_t ts;
+
+        /*sleep until the first listener batch is due, or until woken because one was added*/
+        for(i=0; i < rtVector_Size(gEB->batches); ++i)
+        {
+            rbusEventBatch_t batch = (rbusEventBatch_t)rtVector_At(gEB->batches, i);
+            for(j=0; j < rtVector_Size(batch->listeners); ++j)
+            {
+                ListenerBatch* lb = (ListenerBatch*)rtVector_At(batch->listeners, j);
+                if(!haveTimeout || rtTime_Compare(&lb->deadline, &timeout) < 0)
+                {
+                    timeout = lb->deadline;
+                    haveTimeout = true;
+                }
+            }
+        }
+
+        rtTime_Now(&now);
+        if(!haveTimeout)
+        {
+            ERROR_CHECK(pthread_cond_wait(&gEB->cond, &gEB->mutex));
+        }
+        else if(rtTime_Compare(&now, &timeout) < 0)
+        {
+            err = pthread_cond_timedwait(&gEB->cond, 
+                                        &gEB->mutex, 
+                                        rtTime_ToTimespec(&timeout, &ts));
+
+            if(err != 0 && err != ETIMEDOUT)
+            {
+                RBUSLOG_ERROR("Error %d:%s running command pthread_cond_timedwait", err, strerror(err));
+            }
+        }
+
+        if(!gEB->running)
+        {
+            break;
+        }
+
+        /*send outside gEB->mutex so publishers aren't blocked.
+          sendMutex must be taken before gEB->mutex so drop gEB->mutex first*/
+        UNLOCK();
+        ERROR_CHECK(pthread_mutex_lock(&gEB->sendMutex));
+        LOCK();
+        rtTime_Now(&now);
+        for(i=0; i < rtVector_Size(gEB->batches); ++i)
+        {
+            rbusEventBatch_t batch = (rbusEventBatch_t)rtVector_At(gEB->batches, i);
+            rtVector taken;
+
+            rtVector_Create(&taken);
+            rbusEventBatch_TakeDue(batch, &now, false, taken);
+            if(rtVector_Size(taken))
+            {
+                /*batch can't be destroyed while sendMutex is held*/
+                UNLOCK();
+                rbusEventBatch_SendTaken(batch, taken);
+                LOCK();
+            }
+            rtVector_Destroy(taken, listenerBatch_Free);
+        }
+        ERROR_CHECK(pthread_mutex_unlock(&gEB->sendMutex));
+    }
+    UNLOCK();
+    RBUSLOG_DEBUG("%s: stop", __FUNCTION__);
+    return NULL;
+}
+
+void rbusEventBatch_Create(rbusEventBatch_t* batch, rbusHandle_t handle)
+{
+    rbusEventBatch_t b;
+
+    if(!gEB)
+    {
+        rbusEventBatch_Init();
+    }
+
+    b = rt_calloc(1, sizeof(struct _rbusEventBatch));
+    b->handle = handle;
+    rtVector_Create(&b->listeners);
+    rbusHashTable_Init(&b->listenerIndex, LISTENER_INDEX_MIN_BUCKETS);
+
+    LOCK();//############ LOCK ############
+    rtVector_PushBack(gEB->batches, b);
+    if(!gEB->running)
+    {
+        gEB->running = 1;
+        pthread_create(&gEB->thread, NULL, rbusEventBatch_threadFunc, NULL);
+    }
+    UNLOCK();//############ UNLOCK ############
+
+    *batch = b;
+}
+
+void rbusEventBatch_Destroy(rbusEventBatch_t batch)
+{
+    bool stopThread = false;
+
+    VERIFY_NULL(batch);
+
+    RBUSLOG_DEBUG("%s", __FUNCTION__);
+
+    rbusEventBatch_Flush(batch);
+
+    ERROR_CHECK(pthread_mutex_lock(&gEB->sendMutex));
+    LOCK();//############ LOCK ############
+    rtVector_RemoveItem(gEB->batches, batch, NULL);
+    if(rtVector_Size(gEB->batches) == 0)
+    {
+        stopThread = true;
+        gEB->running = 0;
+    }
+    UNLOCK();//############ UNLOCK ############
+    ERROR_CHECK(pthread_mutex_unlock(&gEB->sendMutex));
+
+    rtVector_Destroy(batch->listeners, listenerBatch_Free);
+    rbusHashTable_Clear(&batch->listenerIndex);
+    free(batch);
+
+    //clean up everything once the last batch is destroyed
+    if(stopThread)
+    {
+        ERROR_CHECK(pthread_cond_signal(&gEB->cond));
+        ERROR_CHECK(pthread_join(gEB->thread, NULL));
+        ERROR_CHECK(pthread_mutex_destroy(&gEB->mutex));
+        ERROR_CHECK(pthread_mutex_destroy(&gEB->sendMutex));
+        ERROR_CHECK(pthread_cond_destroy(&gEB->cond));
+        rtVector_Destroy(gEB->batches, NULL);
+        free(gEB);
+        gEB = NULL;
+    }
+}
+
+void rbusEventBatch_SetOptions(rbusEventBatch_t batch, uint32_t flushInterval, uint32_t maxBatchSize, bool coalesce)
+{
+    VERIFY_NULL(batch);
+
+    RBUSLOG_DEBUG("%s: flushInterval=%u maxBatchSize=%u coalesce=%d", __FUNCTION__, flushInterval, maxBatchSize, coalesce);
+
+    LOCK();//############ LOCK ############
+    batch->flushInterval = flushInterval;
+    batch->maxBatchSize = maxBatchSize;
+    batch->coalesce = coalesce;
+    UNLOCK();//############ UNLOCK ############
+
+    /*send what's queued so the new options apply from here*/
+    rbusEventBatch_Flush(batch);
+}
+
+bool rbusEventBatch_Add(rbusEventBatch_t batch, rbusSubscription_t* sub, rbusEvent_t* event)
+{
+    ListenerBatch* lb;
+    EventBatchEntry* entry = NULL;
+    bool full;
+
+    if(!batch || !sub || !event || sub->version < RBUS_EVENT_BATCH_WIRE_VERSION)
+        return false;
+
+    LOCK();//############ LOCK ############
+
+    if(batch->flushInterval == 0)
+    {
+        UNLOCK();//############ UNLOCK ############
+        return false;
+    }
+
+    lb = listenerBatch_Find(batch, sub->listener);
+    if(!lb)
+    {
+        lb = rt_malloc(sizeof(ListenerBatch));
+        lb->listener = strdup(sub->listener);
+        rtVector_Create(&lb->entries);
+        rtTime_Later(NULL, batch->flushInterval, &lb->deadline);
+        rtVector_PushBack(batch->listeners, lb);
+        rbusHashTable_Insert(&batch->listenerIndex, &lb->link, rbusHash_String(lb->listener));
+        ERROR_CHECK(pthread_cond_signal(&gEB->cond));
+    }
+
+    /*find a value-change of the same property queued for this subscriber to coalesce with*/
+    if(batch->coalesce && event->type == RBUS_EVENT_VALUE_CHANGED && !sub->filter)
+    {
+        size_t i;
+        for(i=0; i < rtVector_Size(lb->entries); ++i)
+        {
+            EventBatchEntry* e = (EventBatchEntry*)rtVector_At(lb->entries, i);
+            if(e->oldValue &&
+               e->componentId == sub->componentId &&
+               strcmp(e->instanceName, event->name) == 0 &&
+               strcmp(e->eventName, sub->eventName) == 0)
+            {
+                entry = e;
+                break;
+            }
+        }
+    }
+
+    if(entry)
+    {
+        RBUSLOG_DEBUG("%s: coalescing value-change %s for listener %s", __FUNCTION__, event->name, sub->listener);
+        rbusMessage_Release(entry->msg);
+        entry->msg = eventBatchEntry_Serialize(sub, event, entry->oldValue);
+    }
+    else
+    {
+        entry = rt_calloc(1, sizeof(EventBatchEntry));
+        entry->eventName = strdup(sub->eventName);
+        entry->instanceName = strdup(event->name);
+        entry->componentId = sub->componentId;
+        /*keep a copy of the oldValue as the publisher may change the value after publishing*/
+        if(batch->coalesce && event->type == RBUS_EVENT_VALUE_CHANGED && !sub->filter && event->data)
+        {
+            rbusValue_t oldValue = rbusObject_GetValue(event->data, "oldValue");
+            if(oldValue)
+            {
+                rbusValue_Init(&entry->oldValue);
+                rbusValue_Copy(entry->oldValue, oldValue);
+            }
+        }
+        entry->msg = eventBatchEntry_Serialize(sub, event, NULL);
+        rtVector_PushBack(lb->entries, entry);
+    }
+
+    full = batch->maxBatchSize && rtVector_Size(lb->entries) >= batch->maxBatchSize;
+
+    UNLOCK();//############ UNLOCK ############
+
+    /*send right away on the publisher's thread once a listener's batch is full*/
+    if(full)
+    {
+        rtVector taken;
+        rtTime_t now;
+
+        rtVector_Create(&taken);
+        rtTime_Now(&now);
+        ERROR_CHECK(pthread_mutex_lock(&gEB->sendMutex));
+        LOCK();//############ LOCK ############
+        rbusEventBatch_TakeDue(batch, &now, false, taken);
+        UNLOCK();//############ UNLOCK ############
+        rbusEventBatch_SendTaken(batch, taken);
+        ERROR_CHECK(pthread_mutex_unlock(&gEB->sendMutex));
+        rtVector_Destroy(taken, listenerBatch_Free);
+    }
+    return true;
+}
+
+void rbusEventBatch_Flush(rbusEventBatch_t batch)
+{
+    rtVector taken;
+
+    VERIFY_NULL(batch);
+
+    rtVector_Create(&taken);
+    ERROR_CHECK(pthread_mutex_lock(&gEB->sendMutex));
+    LOCK();//############ LOCK ############
+    rbusEventBatch_TakeDue(batch, NULL, true, taken);
+    UNLOCK();//############ UNLOCK ############
+    rbusEventBatch_SendTaken(batch, taken);
+    ERROR_CHECK(pthread_mutex_unlock(&gEB->sendMutex));
+    rtVector_Destroy(taken, listenerBatch_Free);
+}
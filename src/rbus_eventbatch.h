@@ -0,0 +1,57 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_EVENTBATCH_H
+#define RBUS_EVENTBATCH_H
+
+#include "rbus_subscriptions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*the event name a batch of events is published with*/
+#define RBUS_EVENT_BATCH_NAME "_rbus.event.batch"
+
+/*the subscribe wire version (see rbus_subscriptions.h) from which a subscriber can unpack a batch*/
+#define RBUS_EVENT_BATCH_WIRE_VERSION 1
+
+typedef struct _rbusEventBatch *rbusEventBatch_t;
+
+/*create the publish batching for an rbus handle*/
+void rbusEventBatch_Create(rbusEventBatch_t* batch, rbusHandle_t handle);
+
+/*send anything pending and destroy the publish batching of an rbus handle*/
+void rbusEventBatch_Destroy(rbusEventBatch_t batch);
+
+/*change the options.  a flushInterval of 0 turns batching off after sending anything pending*/
+void rbusEventBatch_SetOptions(rbusEventBatch_t batch, uint32_t flushInterval, uint32_t maxBatchSize, bool coalesce);
+
+/*queue an event for a subscriber.  returns false if batching is off, or the subscriber is too old
+  to unpack a batch, and the caller must send it*/
+bool rbusEventBatch_Add(rbusEventBatch_t batch, rbusSubscription_t* sub, rbusEvent_t* event);
+
+/*send everything pending*/
+void rbusEventBatch_Flush(rbusEventBatch_t batch);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,114 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Event Subscription Index:
+    Each event a consumer receives is matched to one of its subscriptions by event name
+    and filter.  Subscriptions are hashed by their event name (see rbus_hash.h), so
+    finding one only compares the filters of the subscriptions to that same event.
+*/
+
+#include "rbus_eventsubindex.h"
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <rtMemory.h>
+
+#define EVENTSUB_INDEX_MIN_BUCKETS 64
+
+typedef struct _rbusEventSubEntry
+{
+    rbusHashLink                link;
+    rbusEventSubscription_t*    sub;
+} rbusEventSubEntry;
+
+struct _rbusEventSubIndex
+{
+    rbusHashTable   entries;
+};
+
+void rbusEventSubIndex_Create(rbusEventSubIndex_t* index)
+{
+    (*index) = rt_malloc(sizeof(struct _rbusEventSubIndex));
+    rbusHashTable_Init(&(*index)->entries, EVENTSUB_INDEX_MIN_BUCKETS);
+}
+
+void rbusEventSubIndex_Destroy(rbusEventSubIndex_t index)
+{
+    uint32_t i;
+    if(!index)
+        return;
+    for(i = 0; i < index->entries.numBuckets; ++i)
+    {
+        rbusHashLink* link = index->entries.buckets[i];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            free(rbusHashTable_Entry(link, rbusEventSubEntry, link));
+            link = next;
+        }
+    }
+    rbusHashTable_Clear(&index->entries);
+    free(index);
+}
+
+void rbusEventSubIndex_Add(rbusEventSubIndex_t index, rbusEventSubscription_t* sub)
+{
+    rbusEventSubEntry* entry;
+
+    if(!index || !sub || !sub->eventName)
+        return;
+    entry = rt_malloc(sizeof(rbusEventSubEntry));
+    entry->sub = sub;
+    rbusHashTable_Insert(&index->entries, &entry->link, rbusHash_String(sub->eventName));
+}
+
+void rbusEventSubIndex_Remove(rbusEventSubIndex_t index, rbusEventSubscription_t* sub)
+{
+    rbusHashLink* link;
+
+    if(!index || !sub || !sub->eventName)
+        return;
+    for(link = rbusHashTable_Find(&index->entries, rbusHash_String(sub->eventName)); link; link = rbusHashTable_FindNext(link))
+    {
+        rbusEventSubEntry* entry = rbusHashTable_Entry(link, rbusEventSubEntry, link);
+        if(entry->sub == sub)
+        {
+            rbusHashTable_Remove(&index->entries, link);
+            free(entry);
+            return;
+        }
+    }
+}
+
+rbusEventSubscription_t* rbusEventSubIndex_Find(rbusEventSubIndex_t index, char const* eventName, rbusFilter_t filter)
+{
+    rbusHashLink* link;
+
+    if(!index || !eventName)
+        return NULL;
+    for(link = rbusHashTable_Find(&index->entries, rbusHash_String(eventName)); link; link = rbusHashTable_FindNext(link))
+    {
+        rbusEventSubEntry* entry = rbusHashTable_Entry(link, rbusEventSubEntry, link);
+        if(!strcmp(entry->sub->eventName, eventName) &&
+           !rbusFilter_Compare(entry->sub->filter, filter))
+            return entry->sub;
+    }
+    return NULL;
+}
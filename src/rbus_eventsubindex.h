@@ -0,0 +1,47 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_EVENTSUBINDEX_H
+#define RBUS_EVENTSUBINDEX_H
+
+#include <rbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*a consumer's event subscriptions hashed by event name*/
+typedef struct _rbusEventSubIndex *rbusEventSubIndex_t;
+
+void rbusEventSubIndex_Create(rbusEventSubIndex_t* index);
+
+/*destroy the index only.  the subscriptions are not freed*/
+void rbusEventSubIndex_Destroy(rbusEventSubIndex_t index);
+
+void rbusEventSubIndex_Add(rbusEventSubIndex_t index, rbusEventSubscription_t* sub);
+void rbusEventSubIndex_Remove(rbusEventSubIndex_t index, rbusEventSubscription_t* sub);
+
+/*find the subscription to eventName with a filter equal to filter (both may be NULL)*/
+rbusEventSubscription_t* rbusEventSubIndex_Find(rbusEventSubIndex_t index, char const* eventName, rbusFilter_t filter);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -70,7 +70,7 @@ struct _rbusHandle* rbusHandleList_GetByComponentID(int32_t componentId)
         for(i = 0; i < len; i++)
         {
             handle = (struct _rbusHandle*)rtVector_At(gHandleList, i);
-            if(handle->componentId == componentId)
+            if(handle->componentId == componentId || handle->valueCacheComponentId == componentId)
             {
                 break;
             }
@@ -3,6 +3,10 @@
 
 #include "rbus_element.h"
 #include "rbus_subscriptions.h"
+#include "rbus_eventbatch.h"
+#include "rbus_eventsubindex.h"
+#include "rbus_valuecache.h"
+#include "rbus_config.h"
 #include <rtConnection.h>
 #include <rtVector.h>
 
@@ -28,13 +32,31 @@ struct _rbusHandle
   int32_t               componentId;
   elementNode*          elementRoot;
 
-  /* consumer side subscriptions FIXME - 
-    this needs to be an associative map instead of list/vector*/
+  /* consumer side subscriptions, in the order subscribed */
   rtVector              eventSubs; 
 
+  /* consumer side subscriptions hashed by event name, for matching received events */
+  rbusEventSubIndex_t   eventSubIndex;
+
   /* provider side subscriptions */
   rbusSubscriptions_t   subscriptions; 
 
+  /* provider side publish batching, NULL until turned on */
+  rbusEventBatch_t      eventBatch;
+
+  /* GET and SET timeouts in miliseconds for requests made with this handle, 0 to use the default */
+  int                   getTimeout;
+  int                   setTimeout;
+
+  /* GET and SET timeouts for requests on some elements made with this handle, overriding the ones above */
+  rbusElementTimeouts_t elementTimeouts;
+
+  /* consumer side cache of got values, NULL until turned on */
+  rbusValueCache_t      valueCache;
+
+  /* the componentId the cache's value-change subscriptions are made with, so their events come back to the cache */
+  int32_t               valueCacheComponentId;
+
   rtVector              messageCallbacks;
   rtConnection          connection;
 };
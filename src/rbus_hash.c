@@ -0,0 +1,144 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Hash:
+    FNV-1a, and the chained bucket table behind the atom table, the element name
+    index, the subscription indexes and the value and owner caches.  Entries are
+    linked through an rbusHashLink embedded in them, which also keeps their hash, so
+    growing the table never rehashes a key and removing an entry needs no lookup.
+*/
+
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <rtMemory.h>
+
+#define FNV_PRIME 16777619u
+
+uint32_t rbusHash_Bytes(uint32_t hash, void const* data, size_t len)
+{
+    uint8_t const* p = data;
+    size_t i;
+    for(i = 0; i < len; ++i)
+    {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t rbusHash_Byte(uint32_t hash, uint8_t c)
+{
+    return (hash ^ c) * FNV_PRIME;
+}
+
+uint32_t rbusHash_String(char const* s)
+{
+    uint32_t hash = RBUS_HASH_INIT;
+    for(; *s; ++s)
+        hash = rbusHash_Byte(hash, (uint8_t)*s);
+    return hash;
+}
+
+static void rbusHashTable_Grow(rbusHashTable* table)
+{
+    uint32_t numBuckets = table->numBuckets ? table->numBuckets * 2 : table->minBuckets;
+    rbusHashLink** buckets = rt_calloc(numBuckets, sizeof(rbusHashLink*));
+    uint32_t i;
+
+    for(i = 0; i < table->numBuckets; ++i)
+    {
+        rbusHashLink* link = table->buckets[i];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            uint32_t b = link->hash & (numBuckets - 1);
+            link->next = buckets[b];
+            buckets[b] = link;
+            link = next;
+        }
+    }
+    free(table->buckets);
+    table->buckets = buckets;
+    table->numBuckets = numBuckets;
+}
+
+void rbusHashTable_Init(rbusHashTable* table, uint32_t minBuckets)
+{
+    table->numBuckets = 0;
+    table->numEntries = 0;
+    table->minBuckets = minBuckets;
+    table->buckets = NULL;
+}
+
+void rbusHashTable_Clear(rbusHashTable* table)
+{
+    free(table->buckets);
+    table->buckets = NULL;
+    table->numBuckets = 0;
+    table->numEntries = 0;
+}
+
+void rbusHashTable_Insert(rbusHashTable* table, rbusHashLink* link, uint32_t hash)
+{
+    uint32_t b;
+    if(table->numEntries >= table->numBuckets)
+        rbusHashTable_Grow(table);
+    b = hash & (table->numBuckets - 1);
+    link->hash = hash;
+    link->next = table->buckets[b];
+    table->buckets[b] = link;
+    table->numEntries++;
+}
+
+bool rbusHashTable_Remove(rbusHashTable* table, rbusHashLink* link)
+{
+    rbusHashLink** prev;
+    if(!table->numBuckets)
+        return false;
+    for(prev = &table->buckets[link->hash & (table->numBuckets - 1)]; *prev; prev = &(*prev)->next)
+    {
+        if(*prev == link)
+        {
+            *prev = link->next;
+            link->next = NULL;
+            table->numEntries--;
+            return true;
+        }
+    }
+    return false;
+}
+
+rbusHashLink* rbusHashTable_Find(rbusHashTable const* table, uint32_t hash)
+{
+    rbusHashLink* link;
+    if(!table->numBuckets)
+        return NULL;
+    for(link = table->buckets[hash & (table->numBuckets - 1)]; link && link->hash != hash; link = link->next)
+        ;
+    return link;
+}
+
+rbusHashLink* rbusHashTable_FindNext(rbusHashLink const* link)
+{
+    uint32_t hash = link->hash;
+    for(link = link->next; link && link->hash != hash; link = link->next)
+        ;
+    return (rbusHashLink*)link;
+}
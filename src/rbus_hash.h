@@ -0,0 +1,80 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_HASH_H
+#define RBUS_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*the FNV-1a hash every index in rbus uses.  start with RBUS_HASH_INIT and feed
+  the bytes of a key through rbusHash_Bytes, in as many pieces as it takes*/
+#define RBUS_HASH_INIT 2166136261u
+
+uint32_t rbusHash_Bytes(uint32_t hash, void const* data, size_t len);
+uint32_t rbusHash_Byte(uint32_t hash, uint8_t c);
+uint32_t rbusHash_String(char const* s);
+
+/*a chained hash table whose entries embed an rbusHashLink, so the table allocates
+  nothing but its buckets.  the table doubles when it holds more entries than buckets.
+  it has no lock; the owner of the table serializes access to it*/
+typedef struct _rbusHashLink
+{
+    struct _rbusHashLink*   next;
+    uint32_t                hash;
+} rbusHashLink;
+
+typedef struct _rbusHashTable
+{
+    uint32_t        numBuckets;     /* always zero or a power of two */
+    uint32_t        numEntries;
+    uint32_t        minBuckets;     /* allocated on the first insert */
+    rbusHashLink**  buckets;
+} rbusHashTable;
+
+/*for static tables, in place of rbusHashTable_Init*/
+#define RBUS_HASH_TABLE_INITIALIZER(minBuckets) { 0, 0, (minBuckets), NULL }
+
+/*the entry of type which embeds link as member*/
+#define rbusHashTable_Entry(link, type, member) ((type*)((char*)(link) - offsetof(type, member)))
+
+void rbusHashTable_Init(rbusHashTable* table, uint32_t minBuckets);
+
+/*free the buckets only, leaving the table empty and ready for reuse.  the entries are not freed*/
+void rbusHashTable_Clear(rbusHashTable* table);
+
+void rbusHashTable_Insert(rbusHashTable* table, rbusHashLink* link, uint32_t hash);
+
+/*returns false if link isn't in the table*/
+bool rbusHashTable_Remove(rbusHashTable* table, rbusHashLink* link);
+
+/*the first, and then the next, entry with this hash.  callers still compare their keys*/
+rbusHashLink* rbusHashTable_Find(rbusHashTable const* table, uint32_t hash);
+rbusHashLink* rbusHashTable_FindNext(rbusHashLink const* link);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,139 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Heap:
+    The schedule of the value-change polling thread and the interval subscription thread.
+    Each link is kept at links[link->index], so a record can be removed or rescheduled
+    without searching for it.
+*/
+
+#include "rbus_heap.h"
+#include <stdlib.h>
+#include <rtMemory.h>
+
+static bool rbusHeap_Less(rbusHeap const* heap, size_t a, size_t b)
+{
+    return rtTime_Compare(&heap->links[a]->due, &heap->links[b]->due) < 0;
+}
+
+static void rbusHeap_Place(rbusHeap* heap, size_t i, rbusHeapLink* link)
+{
+    heap->links[i] = link;
+    link->index = i;
+}
+
+static void rbusHeap_SiftUp(rbusHeap* heap, size_t i)
+{
+    rbusHeapLink* link = heap->links[i];
+    while(i > 0)
+    {
+        size_t parent = (i - 1) / 2;
+        if(rtTime_Compare(&link->due, &heap->links[parent]->due) >= 0)
+            break;
+        rbusHeap_Place(heap, i, heap->links[parent]);
+        i = parent;
+    }
+    rbusHeap_Place(heap, i, link);
+}
+
+static void rbusHeap_SiftDown(rbusHeap* heap, size_t i)
+{
+    for(;;)
+    {
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        size_t smallest = i;
+        rbusHeapLink* tmp;
+
+        if(left < heap->size && rbusHeap_Less(heap, left, smallest))
+            smallest = left;
+        if(right < heap->size && rbusHeap_Less(heap, right, smallest))
+            smallest = right;
+        if(smallest == i)
+            break;
+        tmp = heap->links[i];
+        rbusHeap_Place(heap, i, heap->links[smallest]);
+        rbusHeap_Place(heap, smallest, tmp);
+        i = smallest;
+    }
+}
+
+void rbusHeap_Init(rbusHeap* heap)
+{
+    heap->links = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+void rbusHeap_Clear(rbusHeap* heap)
+{
+    size_t i;
+    for(i = 0; i < heap->size; ++i)
+        heap->links[i]->index = RBUS_HEAP_NOT_SCHEDULED;
+    free(heap->links);
+    rbusHeap_Init(heap);
+}
+
+void rbusHeapLink_Init(rbusHeapLink* link)
+{
+    link->index = RBUS_HEAP_NOT_SCHEDULED;
+}
+
+bool rbusHeapLink_IsScheduled(rbusHeapLink const* link)
+{
+    return link->index != RBUS_HEAP_NOT_SCHEDULED;
+}
+
+void rbusHeap_Schedule(rbusHeap* heap, rbusHeapLink* link)
+{
+    if(link->index == RBUS_HEAP_NOT_SCHEDULED)
+    {
+        if(heap->size == heap->capacity)
+        {
+            heap->capacity = heap->capacity ? heap->capacity * 2 : 16;
+            heap->links = rt_realloc(heap->links, heap->capacity * sizeof(rbusHeapLink*));
+        }
+        rbusHeap_Place(heap, heap->size++, link);
+    }
+    rbusHeap_SiftUp(heap, link->index);
+    rbusHeap_SiftDown(heap, link->index);
+}
+
+void rbusHeap_Remove(rbusHeap* heap, rbusHeapLink* link)
+{
+    size_t i = link->index;
+    rbusHeapLink* moved;
+
+    if(i == RBUS_HEAP_NOT_SCHEDULED)
+        return;
+    link->index = RBUS_HEAP_NOT_SCHEDULED;
+    if(--heap->size == i)
+        return;
+    moved = heap->links[heap->size];
+    rbusHeap_Place(heap, i, moved);
+    rbusHeap_SiftUp(heap, i);
+    if(moved->index == i)
+        rbusHeap_SiftDown(heap, i);
+}
+
+rbusHeapLink* rbusHeap_Top(rbusHeap const* heap)
+{
+    return heap->size ? heap->links[0] : NULL;
+}
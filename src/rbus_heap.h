@@ -0,0 +1,76 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_HEAP_H
+#define RBUS_HEAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <rtTime.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*a binary min-heap of timers ordered by when they are due, for the threads which sleep
+  until the next of many records is due.  records embed an rbusHeapLink, which knows its
+  position, so adding, removing or rescheduling one is O(log n) and finding the next is O(1).
+  it has no lock; the owner of the heap serializes access to it*/
+typedef struct _rbusHeapLink
+{
+    rtTime_t    due;
+    size_t      index;      /* position in the heap or RBUS_HEAP_NOT_SCHEDULED */
+} rbusHeapLink;
+
+typedef struct _rbusHeap
+{
+    rbusHeapLink**  links;
+    size_t          size;
+    size_t          capacity;
+} rbusHeap;
+
+#define RBUS_HEAP_NOT_SCHEDULED ((size_t)-1)
+
+/*the entry of type which embeds link as member*/
+#define rbusHeap_Entry(link, type, member) ((type*)((char*)(link) - offsetof(type, member)))
+
+void rbusHeap_Init(rbusHeap* heap);
+
+/*free the array only, leaving the heap empty.  the entries are not freed*/
+void rbusHeap_Clear(rbusHeap* heap);
+
+/*must be called on a link before it's first scheduled*/
+void rbusHeapLink_Init(rbusHeapLink* link);
+
+bool rbusHeapLink_IsScheduled(rbusHeapLink const* link);
+
+/*add link or, if already in the heap, move it to match a changed due time*/
+void rbusHeap_Schedule(rbusHeap* heap, rbusHeapLink* link);
+
+/*does nothing if link isn't in the heap*/
+void rbusHeap_Remove(rbusHeap* heap, rbusHeapLink* link);
+
+/*the link due first, or NULL if the heap is empty*/
+rbusHeapLink* rbusHeap_Top(rbusHeap const* heap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
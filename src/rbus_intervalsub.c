@@ -0,0 +1,550 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Interval Subscriptions:
+    Handles the time based parts of provider side subscriptions.
+    1) A subscription to a property with an interval and no filter is sampled: every 'interval' seconds
+       the subscribed property instances are got and published, all together, in a single
+       RBUS_EVENT_INTERVAL event sent only to that subscriber.
+       (An interval with a filter only sets how often value-change checks the filter. See rbus_valuechange.c)
+    2) A subscription with a duration is unsubscribed automatically once 'duration' seconds have passed.
+    Uses a single thread across all rbus handles, started on first subscription added and stopped when the
+    last handle with subscriptions closes.  Records are kept in a min-heap (see rbus_heap.h) ordered by
+    when their next sample or expiration is due, so the thread only wakes up when one is due and only
+    looks at the ones which are due.
+    Records are found by their subscription's address but the thread only follows rec->sub while holding
+    the handle's subscriptions registry lock and after checking the record wasn't removed.  Subscriptions
+    are only removed with that lock held and removal always removes the record first (see
+    rbusSubscriptions_removeSubscription), so removing never has to wait for the thread.
+    Lock order is the registry lock then the lock here.
+*/
+
+#define _GNU_SOURCE 1 //needed for pthread_mutexattr_settype
+
+#include "rbus_intervalsub.h"
+#include "rbus_handle.h"
+#include "rbus_heap.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+#include <rtVector.h>
+#include <rtTime.h>
+#include <rtMemory.h>
+
+#define ERROR_CHECK(CMD) \
+{ \
+  int err; \
+  if((err=CMD) != 0) \
+  { \
+    RBUSLOG_ERROR("Error %d:%s running command " #CMD, err, strerror(err)); \
+  } \
+}
+#define VERIFY_NULL(T)      if(NULL == T){ return; }
+#define LOCK() ERROR_CHECK(pthread_mutex_lock(&gIS->mutex))
+#define UNLOCK() ERROR_CHECK(pthread_mutex_unlock(&gIS->mutex))
+
+int subscribeHandlerImpl(rbusHandle_t handle, bool added, elementNode* el, char const* eventName, char const* listener, int32_t componentId, int32_t interval, int32_t duration, rbusFilter_t filter, int32_t version);
+void rbusEventData_appendToMessage(rbusEvent_t* event, rbusFilter_t filter, int32_t componentId, rbusMessage msg);
+
+typedef struct IntervalSubscriptions_t
+{
+    int              running;
+    rtVector         subs;
+    rbusHeap         schedule;      //records which aren't busy, ordered by when they are next due
+    unsigned int     runCount;      //incremented each time the thread finishes handling due subscriptions
+    pthread_mutex_t  mutex;
+    pthread_t        thread;
+    pthread_cond_t   cond;
+    pthread_cond_t   doneCond;      //signaled each time the thread finishes handling due subscriptions
+} IntervalSubscriptions_t;
+
+typedef struct IntervalRecord
+{
+    rbusHandle_t handle;        //needed when calling the getHandlers and publishing
+    rbusSubscription_t* sub;    //only followed with the handle's registry locked and the record not removed
+    int32_t interval;           //sampling interval in seconds or 0 if not sampled
+    rtTime_t nextSample;        //when the next sample is due
+    bool expires;               //whether the subscription has a duration
+    rtTime_t expireTime;        //when the subscription's duration runs out
+    rbusHeapLink schedule;      //the sooner of nextSample and expireTime
+    bool busy;                  //the thread is sampling or expiring it outside the lock
+    bool removed;               //removed while busy, the thread will free it
+    bool expire;                //the thread is expiring it (set only while busy)
+} IntervalRecord;
+
+static IntervalSubscriptions_t* gIS = NULL;
+
+static void rbusIntervalSub_Init()
+{
+    pthread_mutexattr_t attrib;
+    pthread_condattr_t cattrib;
+
+    RBUSLOG_DEBUG("%s", __FUNCTION__);
+
+    if(gIS)
+        return;
+
+    gIS = rt_malloc(sizeof(struct IntervalSubscriptions_t));
+
+    gIS->running = 0;
+    gIS->runCount = 0;
+    rtVector_Create(&gIS->subs);
+    rbusHeap_Init(&gIS->schedule);
+
+    ERROR_CHECK(pthread_mutexattr_init(&attrib));
+    ERROR_CHECK(pthread_mutexattr_settype(&attrib, PTHREAD_MUTEX_ERRORCHECK));
+    ERROR_CHECK(pthread_mutex_init(&gIS->mutex, &attrib));
+
+    ERROR_CHECK(pthread_condattr_init(&cattrib));
+    ERROR_CHECK(pthread_condattr_setclock(&cattrib, CLOCK_MONOTONIC));
+    ERROR_CHECK(pthread_cond_init(&gIS->cond, &cattrib));
+    ERROR_CHECK(pthread_cond_init(&gIS->doneCond, &cattrib));
+    ERROR_CHECK(pthread_condattr_destroy(&cattrib));
+}
+
+/*put rec in the schedule at the sooner of its next sample and its expiration.
+  must be called with the lock held*/
+static void intervalRecord_Schedule(IntervalRecord* rec)
+{
+    if(rec->interval > 0)
+        rec->schedule.due = rec->nextSample;
+    if(rec->expires && (rec->interval == 0 || rtTime_Compare(&rec->expireTime, &rec->schedule.due) < 0))
+        rec->schedule.due = rec->expireTime;
+    rbusHeap_Schedule(&gIS->schedule, &rec->schedule);
+}
+
+static IntervalRecord* intervalRecord_Find(rbusSubscription_t const* sub)
+{
+    size_t i;
+    for(i=0; i < rtVector_Size(gIS->subs); ++i)
+    {
+        IntervalRecord* rec = (IntervalRecord*)rtVector_At(gIS->subs, i);
+        if(rec && rec->sub == sub)
+            return rec;
+    }
+    return NULL;
+}
+
+/*unlink rec and free it, or if the thread is using it, have the thread free it.
+  wait is for closing a handle, whose registry is destroyed once this returns.
+  must be called with the lock held*/
+static void intervalRecord_Remove(IntervalRecord* rec, bool wait)
+{
+    rtVector_RemoveItem(gIS->subs, rec, NULL);
+    rbusHeap_Remove(&gIS->schedule, &rec->schedule);
+    if(rec->busy)
+    {
+        rec->removed = true;
+        /*unless called from the thread itself, wait for it to be done with the handle.
+          rec is freed by then so don't touch it*/
+        if(wait && !pthread_equal(pthread_self(), gIS->thread))
+        {
+            unsigned int runCount = gIS->runCount;
+            while(gIS->runCount == runCount)
+                ERROR_CHECK(pthread_cond_wait(&gIS->doneCond, &gIS->mutex));
+        }
+    }
+    else
+    {
+        free(rec);
+    }
+}
+
+/*lock the registry of rec's handle and return whether rec's subscription is still there.
+  the registry is left locked either way*/
+static bool intervalRecord_Lock(IntervalRecord* rec)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)rec->handle;
+    bool removed;
+
+    rbusSubscriptions_lock(handleInfo->subscriptions);
+    LOCK();
+    removed = rec->removed;
+    UNLOCK();
+    return !removed;
+}
+
+/*get all the instances of the subscribed property and publish them in one event to the subscriber.
+  called without the lock held*/
+static void intervalRecord_Sample(IntervalRecord* rec)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)rec->handle;
+    rbusSubscription_t* sub;
+    char* eventName;
+    char* listener;
+    int32_t componentId;
+    rtVector names;
+    rtListItem item;
+    rbusObject_t data;
+    rbusEvent_t event = {0};
+    rbusMessage msg;
+    size_t i;
+    rbus_error_t err;
+
+    if(!intervalRecord_Lock(rec))
+    {
+        rbusSubscriptions_unlock(handleInfo->subscriptions);
+        return;
+    }
+
+    /*copy what's needed from sub while it can't be removed, rows can be added or removed while the getHandlers run*/
+    sub = rec->sub;
+    eventName = strdup(sub->eventName);
+    listener = strdup(sub->listener);
+    componentId = sub->componentId;
+    rtVector_Create(&names);
+    rtList_GetFront(sub->instances, &item);
+    while(item)
+    {
+        elementNode* node;
+        rtListItem_GetData(item, (void**)&node);
+        if(node)
+            rtVector_PushBack(names, strdup(node->fullName));
+        rtListItem_GetNext(item, &item);
+    }
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+    rbusObject_Init(&data, NULL);
+
+    for(i = 0; i < rtVector_Size(names); ++i)
+    {
+        char const* name = (char const*)rtVector_At(names, i);
+        elementNode* node;
+        rbusGetHandler_t getHandler = NULL;
+        rbusProperty_t property;
+        rbusGetHandlerOptions_t opts;
+
+        /*rows are deleted with the registry locked, so hold it while the node is used*/
+        rbusSubscriptions_lock(handleInfo->subscriptions);
+        node = retrieveInstanceElement(handleInfo->elementRoot, name);
+        if(node)
+            getHandler = node->cbTable.getHandler;
+        rbusSubscriptions_unlock(handleInfo->subscriptions);
+
+        if(!getHandler)
+            continue;
+
+        memset(&opts, 0, sizeof(rbusGetHandlerOptions_t));
+        opts.requestingComponent = "intervalSubscriptionThread";
+
+        rbusProperty_Init(&property, name, NULL);
+        if(getHandler(rec->handle, property, &opts) == RBUS_ERROR_SUCCESS)
+            rbusObject_SetValue(data, name, rbusProperty_GetValue(property));
+        else
+            RBUSLOG_WARN("%s: failed to get current value of %s", __FUNCTION__, name);
+        rbusProperty_Release(property);
+    }
+
+    rtVector_Destroy(names, free);
+
+    event.name = eventName;
+    event.type = RBUS_EVENT_INTERVAL;
+    event.data = data;
+
+    rbusMessage_Init(&msg);
+    rbusEventData_appendToMessage(&event, NULL, componentId, msg);
+
+    RBUSLOG_DEBUG("%s: publishing interval event %s to listener %s", __FUNCTION__, eventName, listener);
+
+    err = rbus_publishSubscriberEvent(handleInfo->componentName, eventName, listener, msg);
+    if(err != RTMESSAGE_BUS_SUCCESS)
+    {
+        RBUSLOG_WARN("%s: rbus_publishSubscriberEvent %s failed with error %d", __FUNCTION__, eventName, err);
+    }
+
+    rbusMessage_Release(msg);
+    rbusObject_Release(data);
+    free(eventName);
+    free(listener);
+}
+
+/*unsubscribe a subscription whose duration ran out.  called without the lock held*/
+static void intervalRecord_Expire(IntervalRecord* rec)
+{
+    struct _rbusHandle* handleInfo = (struct _rbusHandle*)rec->handle;
+    rbusSubscription_t* sub;
+    char* eventName;
+    char* listener;
+    rbusFilter_t filter;
+
+    /*keep the registry locked so the sub can't be unsubscribed or deleted with its row in the meantime*/
+    if(intervalRecord_Lock(rec))
+    {
+        sub = rec->sub;
+        eventName = strdup(sub->eventName);
+        listener = strdup(sub->listener);
+        filter = sub->filter;
+
+        RBUSLOG_INFO("%s: subscription duration ended event=%s listener=%s", __FUNCTION__, eventName, listener);
+
+        /*subscribeHandlerImpl frees sub so use copies of its key*/
+        if(filter)
+            rbusFilter_Retain(filter);
+        subscribeHandlerImpl(rec->handle, false, sub->element, eventName, listener, sub->componentId, 0, 0, filter, sub->version);
+        if(filter)
+            rbusFilter_Release(filter);
+        free(eventName);
+        free(listener);
+    }
+    rbusSubscriptions_unlock(handleInfo->subscriptions);
+}
+
+static void* rbusIntervalSub_threadFunc(void *userData)
+{
+    IntervalRecord** due = NULL;
+    size_t dueCapacity = 0;
+
+    (void)(userData);
+    RBUSLOG_DEBUG("%s: start", __FUNCTION__);
+    LOCK();
+    while(gIS->running)
+    {
+        size_t i, numDue = 0;
+        int err;
+        rtTime_t now;
+        rtTimespec_t ts;
+        rbusHeapLink* top;
+
+        /*sleep until the next sample or expiration is due, or until woken because the subscriptions changed*/
+        top = rbusHeap_Top(&gIS->schedule);
+
+        rtTime_Now(&now);
+        if(!top)
+        {
+            ERROR_CHECK(pthread_cond_wait(&gIS->cond, &gIS->mutex));
+        }
+        else if(rtTime_Compare(&now, &top->due) < 0)
+        {
+            err = pthread_cond_timedwait(&gIS->cond, 
+                                        &gIS->mutex, 
+                                        rtTime_ToTimespec(&top->due, &ts));
+
+            if(err != 0 && err != ETIMEDOUT)
+            {
+                RBUSLOG_ERROR("Error %d:%s running command pthread_cond_timedwait", err, strerror(err));
+            }
+        }
+
+        if(!gIS->running)
+        {
+            break;
+        }
+
+        /*take all the records which are due off the schedule*/
+        rtTime_Now(&now);
+        while((top = rbusHeap_Top(&gIS->schedule)) != NULL && rtTime_Compare(&top->due, &now) <= 0)
+        {
+            IntervalRecord* rec = rbusHeap_Entry(top, IntervalRecord, schedule);
+
+            rbusHeap_Remove(&gIS->schedule, top);
+            rec->busy = true;
+            rec->expire = rec->expires && rtTime_Compare(&rec->expireTime, &now) <= 0;
+            if(numDue == dueCapacity)
+            {
+                dueCapacity = dueCapacity ? dueCapacity * 2 : 16;
+                due = rt_realloc(due, dueCapacity * sizeof(IntervalRecord*));
+            }
+            due[numDue++] = rec;
+        }
+
+        if(numDue == 0)
+            continue;
+
+        /*getHandlers, publishing and unsubscribing can be slow and call back into rbus so don't hold the lock.
+          busy records can't be freed by other threads until this is done*/
+        UNLOCK();
+        for(i = 0; i < numDue; ++i)
+        {
+            if(due[i]->expire)
+                intervalRecord_Expire(due[i]);
+            else
+                intervalRecord_Sample(due[i]);
+        }
+        LOCK();
+
+        for(i = 0; i < numDue; ++i)
+        {
+            IntervalRecord* rec = due[i];
+            rec->busy = false;
+            if(rec->removed)
+            {
+                free(rec);
+            }
+            else if(rec->expire)
+            {
+                /*unsubscribe didn't find it, so just stop timing it*/
+                rtVector_RemoveItem(gIS->subs, rec, free);
+            }
+            else
+            {
+                rtTime_Later(NULL, rec->interval * 1000, &rec->nextSample);
+                intervalRecord_Schedule(rec);
+            }
+        }
+        gIS->runCount++;
+        ERROR_CHECK(pthread_cond_broadcast(&gIS->doneCond));
+    }
+    UNLOCK();
+    free(due);
+    RBUSLOG_DEBUG("%s: stop", __FUNCTION__);
+    return NULL;
+}
+
+void rbusIntervalSub_AddSubscription(rbusHandle_t handle, rbusSubscription_t* sub)
+{
+    IntervalRecord* rec;
+
+    VERIFY_NULL(sub);
+
+    if(!gIS)
+    {
+        rbusIntervalSub_Init();
+    }
+
+    RBUSLOG_DEBUG("%s: %s interval=%d duration=%d", __FUNCTION__, sub->eventName, sub->interval, sub->duration);
+
+    LOCK();//############ LOCK ############
+
+    rec = intervalRecord_Find(sub);
+    if(!rec)
+    {
+        rec = (IntervalRecord*)rt_calloc(1, sizeof(IntervalRecord));
+        rec->handle = handle;
+        rec->sub = sub;
+        rbusHeapLink_Init(&rec->schedule);
+
+        /*only auto published properties are sampled and a filter means the interval is for value-change instead*/
+        if(sub->interval > 0 && !sub->filter && sub->autoPublish &&
+           sub->element && sub->element->type == RBUS_ELEMENT_TYPE_PROPERTY)
+        {
+            rec->interval = sub->interval;
+            rtTime_Later(NULL, rec->interval * 1000, &rec->nextSample);
+        }
+        if(sub->duration > 0)
+        {
+            rec->expires = true;
+            rtTime_Later(NULL, sub->duration * 1000, &rec->expireTime);
+        }
+
+        if(rec->interval == 0 && !rec->expires)
+        {
+            free(rec);
+            UNLOCK();//############ UNLOCK ############
+            return;
+        }
+
+        rtVector_PushBack(gIS->subs, rec);
+        intervalRecord_Schedule(rec);
+
+        /* start the thread if needed, otherwise wake it up as rec may be due before whatever it's waiting on */
+
+        if(!gIS->running)
+        {
+            gIS->running = 1;
+            pthread_create(&gIS->thread, NULL, rbusIntervalSub_threadFunc, NULL);
+        }
+        else
+        {
+            ERROR_CHECK(pthread_cond_signal(&gIS->cond));
+        }
+    }
+
+    UNLOCK();//############ UNLOCK ############
+}
+
+void rbusIntervalSub_RemoveSubscription(rbusHandle_t handle, rbusSubscription_t* sub)
+{
+    IntervalRecord* rec;
+
+    (void)(handle);
+    VERIFY_NULL(sub);
+
+    if(!gIS)
+    {
+        return;
+    }
+
+    LOCK();//############ LOCK ############
+    rec = intervalRecord_Find(sub);
+    if(rec)
+    {
+        RBUSLOG_DEBUG("%s: %s", __FUNCTION__, sub->eventName);
+        /* the caller holds the registry lock, which the thread may be waiting on, so neither wait
+           for the thread nor join it.  with nothing left the thread just idles until the handle closes */
+        intervalRecord_Remove(rec, false);
+    }
+    UNLOCK();//############ UNLOCK ############
+}
+
+void rbusIntervalSub_CloseHandle(rbusHandle_t handle)
+{
+    RBUSLOG_DEBUG("%s", __FUNCTION__);
+
+    if(!gIS)
+    {
+        return;
+    }
+
+    //remove all subscriptions for this bus handle
+    LOCK();//############ LOCK ############
+    size_t i = 0;
+    while(i < rtVector_Size(gIS->subs))
+    {
+        IntervalRecord* rec = (IntervalRecord*)rtVector_At(gIS->subs, i);
+        if(rec && rec->handle == handle)
+        {
+            intervalRecord_Remove(rec, true);
+        }
+        else
+        {
+            //only i++ here because rtVector_RemoveItem does a right shift on all the elements after remove index
+            i++; 
+        }
+    }
+
+    //clean up everything once all subscriptions are removed
+    //but check the size to ensure we do not clean up if subscriptions for other rbus handles exist
+    if(rtVector_Size(gIS->subs) == 0)
+    {
+        if(gIS->running)
+        {
+            gIS->running = 0;
+            UNLOCK();//############ UNLOCK ############
+            ERROR_CHECK(pthread_cond_signal(&gIS->cond));
+            ERROR_CHECK(pthread_join(gIS->thread, NULL));
+        }
+        else
+        {
+            UNLOCK();//############ UNLOCK ############
+        }
+        ERROR_CHECK(pthread_mutex_destroy(&gIS->mutex));
+        ERROR_CHECK(pthread_cond_destroy(&gIS->cond));
+        ERROR_CHECK(pthread_cond_destroy(&gIS->doneCond));
+        rtVector_Destroy(gIS->subs, NULL);
+        rbusHeap_Clear(&gIS->schedule);
+        free(gIS);
+        gIS = NULL;
+    }
+    else
+    {
+        UNLOCK();//############ UNLOCK ############
+    }
+}
@@ -24,6 +24,8 @@
 #include <string.h>
 #include <assert.h>
 #include <stdarg.h>
+#include "rbus_buffer.h"
+#include "rbus_pool.h"
 
 #define VERIFY_NULL(T)    if(NULL == T){ return; }
 
@@ -44,11 +46,11 @@ struct _rbusObject
 rbusObject_t rbusObject_Init(rbusObject_t* pobject, char const* name)
 {
     rbusObject_t object;
-    object = rt_calloc(1, sizeof(struct _rbusObject));
+    object = rbusPool_Alloc(RBUS_POOL_OBJECT, sizeof(struct _rbusObject));
     object->type = RBUS_OBJECT_SINGLE_INSTANCE;
     object->retainable.refCount = 1;
     if(name)
-        object->name = strdup(name);
+        object->name = rbusPool_StrDup(name);
     if(pobject)
         *pobject = object;
     return object;
@@ -66,7 +68,7 @@ void rbusObject_Destroy(rtRetainable* r)
     VERIFY_NULL(object);
     if(object->name)
     {
-        free(object->name);
+        rbusPool_FreeString(object->name);
         object->name = NULL;
     }
     if(object->properties)
@@ -78,7 +80,7 @@ void rbusObject_Destroy(rtRetainable* r)
     rbusObject_SetNext(object, NULL);
     rbusObject_SetParent(object, NULL);
 
-    free(object);
+    rbusPool_Free(RBUS_POOL_OBJECT, object);
 }
 
 void rbusObject_Retain(rbusObject_t object)
@@ -243,9 +245,9 @@ void rbusObject_SetName(rbusObject_t object, char const* name)
 {
     VERIFY_NULL(object);
     if(object->name)
-        free(object->name);
+        rbusPool_FreeString(object->name);
     if(name)
-        object->name = strdup(name);
+        object->name = rbusPool_StrDup(name);
     else
         object->name = NULL;
 }
@@ -533,3 +535,82 @@ void rbusObject_SetPropertyBytes(rbusObject_t object, char const* name, uint8_t
     rbusObject_SetPropertyValue(object, name, v);
     rbusValue_Release(v);
 }
+
+int rbusObject_Encode(rbusObject_t object, rbusBuffer_t buff)
+{
+    rbusObject_t child;
+    int32_t numChild = 0;
+
+    if(!object)
+        return -1;
+    if(object->name)
+    {
+        if(strlen(object->name) >= UINT16_MAX)
+            return -1;
+        rbusBuffer_WriteStringTLV(buff, object->name, strlen(object->name)+1);
+    }
+    else
+    {
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_NONE, 0, NULL);
+    }
+    rbusBuffer_WriteInt32TLV(buff, object->type);
+    if(rbusPropertyList_Encode(object->properties, buff) < 0)
+        return -1;
+
+    for(child = object->children; child; child = child->next)
+        numChild++;
+    rbusBuffer_WriteInt32TLV(buff, numChild);
+    for(child = object->children; child; child = child->next)
+    {
+        if(rbusObject_Encode(child, buff) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+int rbusObject_Decode(rbusObject_t* object, rbusBuffer_t const buff)
+{
+    rbusValue_t name = NULL;
+    int32_t type = 0;
+    int32_t numChild = 0;
+    rbusProperty_t prop = NULL;
+    rbusObject_t obj, previous = NULL;
+
+    *object = NULL;
+    if(rbusValue_Decode(&name, buff) < 0 ||
+       rbusBuffer_ReadInt32TLV(buff, &type) < 0 ||
+       rbusPropertyList_Decode(&prop, buff) < 0)
+    {
+        rbusValue_Release(name);
+        return -1;
+    }
+
+    rbusObject_Init(&obj, rbusValue_GetType(name) == RBUS_STRING ? rbusValue_GetString(name, NULL) : NULL);
+    rbusValue_Release(name);
+    if(type == RBUS_OBJECT_MULTI_INSTANCE)
+        obj->type = RBUS_OBJECT_MULTI_INSTANCE;
+    obj->properties = prop;
+
+    if(rbusBuffer_ReadInt32TLV(buff, &numChild) < 0)
+    {
+        rbusObject_Release(obj);
+        return -1;
+    }
+    while(--numChild >= 0)
+    {
+        rbusObject_t next;
+        if(rbusObject_Decode(&next, buff) < 0)
+        {
+            rbusObject_Release(obj);
+            return -1;
+        }
+        if(previous)
+            previous->next = next;/*the list holds the only reference*/
+        else
+            obj->children = next;
+        rbusObject_SetParent(next, obj);
+        previous = next;
+    }
+    *object = obj;
+    return 0;
+}
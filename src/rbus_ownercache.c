@@ -0,0 +1,184 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Owner Cache:
+    A process wide cache of which component owns each element, so rbus_getExt and
+    rbus_setMulti can batch their names by component without first asking the broker.
+    The broker's discovery reply carries only the owning component of each name, not
+    the registration it matched, so entries are keyed by the full element name.
+    An entry can go stale when its owner unregisters or disconnects; callers remove it
+    when a request sent by it fails, and the cache is cleared on every client
+    disconnect advisory.  Entries are hashed by their name (see rbus_hash.h).
+*/
+
+#include "rbus_ownercache.h"
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <rtMemory.h>
+
+#define OWNERCACHE_MIN_BUCKETS 1024
+#define OWNERCACHE_MAX_ENTRIES 4096
+
+typedef struct _rbusOwnerCacheEntry
+{
+    rbusHashLink    link;
+    char*           name;
+    char*           owner;
+} rbusOwnerCacheEntry;
+
+static pthread_mutex_t gOwnerCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static rbusHashTable gEntries = RBUS_HASH_TABLE_INITIALIZER(OWNERCACHE_MIN_BUCKETS);
+
+static rbusOwnerCacheEntry* findEntry(char const* name, uint32_t hash)
+{
+    rbusHashLink* link;
+    for(link = rbusHashTable_Find(&gEntries, hash); link; link = rbusHashTable_FindNext(link))
+    {
+        rbusOwnerCacheEntry* entry = rbusHashTable_Entry(link, rbusOwnerCacheEntry, link);
+        if(!strcmp(entry->name, name))
+            return entry;
+    }
+    return NULL;
+}
+
+static void freeEntry(rbusOwnerCacheEntry* entry)
+{
+    free(entry->name);
+    free(entry->owner);
+    free(entry);
+}
+
+static void clearEntries(void)
+{
+    uint32_t b;
+    for(b = 0; b < gEntries.numBuckets; ++b)
+    {
+        rbusHashLink* link = gEntries.buckets[b];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            freeEntry(rbusHashTable_Entry(link, rbusOwnerCacheEntry, link));
+            link = next;
+        }
+    }
+    rbusHashTable_Clear(&gEntries);
+}
+
+int rbusOwnerCache_Lookup(int numElements, char const** elementNames, char** owners)
+{
+    int i;
+    int found = 0;
+
+    pthread_mutex_lock(&gOwnerCacheMutex);
+    for(i = 0; i < numElements; ++i)
+    {
+        rbusOwnerCacheEntry* entry = findEntry(elementNames[i], rbusHash_String(elementNames[i]));
+        if(entry)
+        {
+            owners[i] = strdup(entry->owner);
+            found++;
+        }
+        else
+        {
+            owners[i] = NULL;
+        }
+    }
+    pthread_mutex_unlock(&gOwnerCacheMutex);
+
+    return found;
+}
+
+void rbusOwnerCache_Add(char const* elementName, char const* owner)
+{
+    uint32_t hash = rbusHash_String(elementName);
+    rbusOwnerCacheEntry* entry;
+
+    pthread_mutex_lock(&gOwnerCacheMutex);
+
+    entry = findEntry(elementName, hash);
+    if(entry)
+    {
+        if(strcmp(entry->owner, owner))
+        {
+            free(entry->owner);
+            entry->owner = strdup(owner);
+        }
+    }
+    else
+    {
+        /*owners are cheap to rediscover, so when full just start over*/
+        if(gEntries.numEntries >= OWNERCACHE_MAX_ENTRIES)
+            clearEntries();
+
+        entry = rt_malloc(sizeof(rbusOwnerCacheEntry));
+        entry->name = strdup(elementName);
+        entry->owner = strdup(owner);
+        rbusHashTable_Insert(&gEntries, &entry->link, hash);
+    }
+
+    pthread_mutex_unlock(&gOwnerCacheMutex);
+}
+
+void rbusOwnerCache_Remove(char const* elementName)
+{
+    rbusOwnerCacheEntry* entry;
+
+    pthread_mutex_lock(&gOwnerCacheMutex);
+    entry = findEntry(elementName, rbusHash_String(elementName));
+    if(entry)
+    {
+        rbusHashTable_Remove(&gEntries, &entry->link);
+        freeEntry(entry);
+    }
+    pthread_mutex_unlock(&gOwnerCacheMutex);
+}
+
+void rbusOwnerCache_RemoveOwner(char const* owner)
+{
+    uint32_t b;
+
+    pthread_mutex_lock(&gOwnerCacheMutex);
+    for(b = 0; b < gEntries.numBuckets; ++b)
+    {
+        rbusHashLink* link = gEntries.buckets[b];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            rbusOwnerCacheEntry* entry = rbusHashTable_Entry(link, rbusOwnerCacheEntry, link);
+            if(!strcmp(entry->owner, owner))
+            {
+                rbusHashTable_Remove(&gEntries, link);
+                freeEntry(entry);
+            }
+            link = next;
+        }
+    }
+    pthread_mutex_unlock(&gOwnerCacheMutex);
+}
+
+void rbusOwnerCache_Clear(void)
+{
+    pthread_mutex_lock(&gOwnerCacheMutex);
+    clearEntries();
+    pthread_mutex_unlock(&gOwnerCacheMutex);
+}
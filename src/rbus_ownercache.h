@@ -0,0 +1,47 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef RBUS_OWNERCACHE_H
+#define RBUS_OWNERCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*look up the components owning elementNames.  owners[i] is set to a copy of the
+  owner of elementNames[i], to be freed by the caller, or NULL if it isn't cached.
+  returns the number of names found*/
+int rbusOwnerCache_Lookup(int numElements, char const** elementNames, char** owners);
+
+/*remember that owner owns elementName*/
+void rbusOwnerCache_Add(char const* elementName, char const* owner);
+
+/*forget the owner of elementName*/
+void rbusOwnerCache_Remove(char const* elementName);
+
+/*forget every element owned by owner, such as when it unregisters elements*/
+void rbusOwnerCache_RemoveOwner(char const* owner);
+
+/*forget everything, such as when some component disconnects*/
+void rbusOwnerCache_Clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,261 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Pools:
+    Values, properties and objects are allocated and freed constantly on both sides of the bus.
+    Freed structs are kept on a free list belonging to the thread that freed them, up to
+    POOL_MAX_FREE of each type, so the next allocation on that thread doesn't touch the heap.
+    A thread's free lists are released when the thread exits.
+    Arenas:
+    A thread building a whole tree that is freed together (the properties of a get response)
+    can begin an arena, so that the tree's structs and names are carved from ARENA_CHUNK_SIZE
+    chunks.  Each chunk counts the blocks carved from it, plus one while the arena is still
+    carving from it, and is freed when that count drops to zero.
+    Every block has a small header recording its chunk, which is NULL for blocks from the heap.
+*/
+
+#include "rbus_pool.h"
+#include "rbus_log.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <rtMemory.h>
+
+#define POOL_MAX_FREE       256
+#define ARENA_CHUNK_SIZE    4096
+#define POOL_ALIGN(N)       (((N) + sizeof(rbusPoolBlock) - 1) & ~(sizeof(rbusPoolBlock) - 1))
+
+typedef struct _rbusArenaChunk
+{
+    int                     refCount;   /*one per block carved from the chunk plus one while its arena carves from it*/
+    size_t                  used;
+} rbusArenaChunk;
+
+/*the header is two pointers so the struct after it keeps 8 byte alignment on 32 bit and 16 on 64 bit*/
+typedef struct _rbusPoolBlock
+{
+    rbusArenaChunk*         chunk;  /*the chunk the block was carved from or NULL if it's from the heap*/
+    struct _rbusPoolBlock*  next;   /*the next block on a thread's free list*/
+} rbusPoolBlock;
+
+struct _rbusArena
+{
+    rbusArenaChunk*         chunk;      /*the chunk being carved from*/
+    struct _rbusArena*      prev;       /*the arena which was active when this one began*/
+};
+
+typedef struct _rbusPoolThread
+{
+    rbusPoolBlock*          freeList[RBUS_POOL_MAX];
+    int                     freeCount[RBUS_POOL_MAX];
+    struct _rbusArena*      arena;
+} rbusPoolThread;
+
+static pthread_once_t gPoolOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t gPoolKey;
+static int gLiveChunks = 0;
+
+static void rbusPool_ThreadExit(void* p)
+{
+    rbusPoolThread* pt = p;
+    int i;
+    for(i = 0; i < RBUS_POOL_MAX; ++i)
+    {
+        while(pt->freeList[i])
+        {
+            rbusPoolBlock* b = pt->freeList[i];
+            pt->freeList[i] = b->next;
+            free(b);
+        }
+    }
+    free(pt);
+}
+
+static void rbusPool_CreateKey(void)
+{
+    int err = pthread_key_create(&gPoolKey, rbusPool_ThreadExit);
+    if(err != 0)
+        RBUSLOG_ERROR("pthread_key_create failed: %d", err);
+}
+
+/*returns NULL if the thread's state couldn't be created, in which case everything comes from the heap*/
+static rbusPoolThread* rbusPool_Thread(void)
+{
+    rbusPoolThread* pt;
+    pthread_once(&gPoolOnce, rbusPool_CreateKey);
+    pt = pthread_getspecific(gPoolKey);
+    if(!pt)
+    {
+        pt = calloc(1, sizeof(rbusPoolThread));
+        if(pt && pthread_setspecific(gPoolKey, pt) != 0)
+        {
+            free(pt);
+            pt = NULL;
+        }
+    }
+    return pt;
+}
+
+static void rbusArenaChunk_Release(rbusArenaChunk* chunk)
+{
+    if(__atomic_sub_fetch(&chunk->refCount, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        free(chunk);
+        __atomic_sub_fetch(&gLiveChunks, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/*carve a zeroed block of size bytes, including its header, or return NULL if it's too big for a chunk*/
+static rbusPoolBlock* rbusArena_Carve(struct _rbusArena* arena, size_t size)
+{
+    size_t const start = POOL_ALIGN(sizeof(rbusArenaChunk));
+    rbusPoolBlock* b;
+
+    size = POOL_ALIGN(size);
+    if(size > (ARENA_CHUNK_SIZE - start) / 4)
+        return NULL;
+
+    if(!arena->chunk || arena->chunk->used + size > ARENA_CHUNK_SIZE)
+    {
+        rbusArenaChunk* chunk = malloc(ARENA_CHUNK_SIZE);
+        if(!chunk)
+            return NULL;
+        chunk->refCount = 1;
+        chunk->used = start;
+        __atomic_add_fetch(&gLiveChunks, 1, __ATOMIC_RELAXED);
+        if(arena->chunk)
+            rbusArenaChunk_Release(arena->chunk);
+        arena->chunk = chunk;
+    }
+
+    b = (rbusPoolBlock*)((uint8_t*)arena->chunk + arena->chunk->used);
+    arena->chunk->used += size;
+    __atomic_add_fetch(&arena->chunk->refCount, 1, __ATOMIC_RELAXED);
+    memset(b, 0, size);
+    b->chunk = arena->chunk;
+    return b;
+}
+
+void* rbusPool_Alloc(rbusPoolType_t type, size_t size)
+{
+    rbusPoolThread* pt = rbusPool_Thread();
+    rbusPoolBlock* b = NULL;
+
+    size += sizeof(rbusPoolBlock);
+    if(pt && pt->arena)
+    {
+        b = rbusArena_Carve(pt->arena, size);
+    }
+    else if(pt && pt->freeList[type])
+    {
+        b = pt->freeList[type];
+        pt->freeList[type] = b->next;
+        pt->freeCount[type]--;
+        memset(b, 0, size);
+    }
+    if(!b)
+        b = rt_calloc(1, size);
+    return b + 1;
+}
+
+void rbusPool_Free(rbusPoolType_t type, void* p)
+{
+    rbusPoolBlock* b;
+    rbusPoolThread* pt;
+
+    if(!p)
+        return;
+    b = (rbusPoolBlock*)p - 1;
+    if(b->chunk)
+    {
+        rbusArenaChunk_Release(b->chunk);
+        return;
+    }
+    pt = rbusPool_Thread();
+    if(pt && pt->freeCount[type] < POOL_MAX_FREE)
+    {
+        b->next = pt->freeList[type];
+        pt->freeList[type] = b;
+        pt->freeCount[type]++;
+        return;
+    }
+    free(b);
+}
+
+char* rbusPool_StrDup(char const* s)
+{
+    rbusPoolThread* pt = rbusPool_Thread();
+    rbusPoolBlock* b = NULL;
+    size_t len = strlen(s) + 1;
+
+    if(pt && pt->arena)
+        b = rbusArena_Carve(pt->arena, sizeof(rbusPoolBlock) + len);
+    if(!b)
+    {
+        b = rt_malloc(sizeof(rbusPoolBlock) + len);
+        b->chunk = NULL;
+    }
+    memcpy(b + 1, s, len);
+    return (char*)(b + 1);
+}
+
+void rbusPool_FreeString(char* s)
+{
+    rbusPoolBlock* b;
+    if(!s)
+        return;
+    b = (rbusPoolBlock*)s - 1;
+    if(b->chunk)
+        rbusArenaChunk_Release(b->chunk);
+    else
+        free(b);
+}
+
+void rbusArena_Begin(rbusArena_t* parena)
+{
+    rbusPoolThread* pt = rbusPool_Thread();
+    rbusArena_t arena = rt_calloc(1, sizeof(struct _rbusArena));
+    if(pt)
+    {
+        arena->prev = pt->arena;
+        pt->arena = arena;
+    }
+    *parena = arena;
+}
+
+void rbusArena_End(rbusArena_t arena)
+{
+    rbusPoolThread* pt = rbusPool_Thread();
+    if(!arena)
+        return;
+    if(pt && pt->arena == arena)
+        pt->arena = arena->prev;
+    else
+        RBUSLOG_WARN("arena ended out of order or on another thread");
+    if(arena->chunk)
+        rbusArenaChunk_Release(arena->chunk);
+    free(arena);
+}
+
+int rbusArena_LiveChunks(void)
+{
+    return __atomic_load_n(&gLiveChunks, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,64 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+#ifndef RBUS_POOL_H
+#define RBUS_POOL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*the fixed size structs which have a free list per thread*/
+typedef enum _rbusPoolType
+{
+    RBUS_POOL_VALUE,
+    RBUS_POOL_PROPERTY,
+    RBUS_POOL_OBJECT,
+    RBUS_POOL_MAX
+} rbusPoolType_t;
+
+typedef struct _rbusArena *rbusArena_t;
+
+/*allocate zeroed memory for a struct of type.  size must be the same on every call for a type*/
+void* rbusPool_Alloc(rbusPoolType_t type, size_t size);
+
+/*free memory from rbusPool_Alloc, keeping it on the calling thread's free list if there's room*/
+void rbusPool_Free(rbusPoolType_t type, void* p);
+
+/*strdup, allocating from the thread's arena if it has one.  free with rbusPool_FreeString*/
+char* rbusPool_StrDup(char const* s);
+void rbusPool_FreeString(char* s);
+
+/*while an arena is active on a thread, everything that thread allocates with rbusPool_Alloc
+  and rbusPool_StrDup is carved from large chunks.  A chunk is freed in one go once the arena
+  has ended and everything carved from it has been freed, so anything that outlives the
+  arena stays valid.  Arenas nest and must be ended on the thread that began them*/
+void rbusArena_Begin(rbusArena_t* arena);
+void rbusArena_End(rbusArena_t arena);
+
+/*the number of arena chunks currently allocated by all threads, for diagnosing trees kept alive too long*/
+int rbusArena_LiveChunks(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
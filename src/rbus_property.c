@@ -23,6 +23,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include "rbus_buffer.h"
+#include "rbus_pool.h"
 
 #define VERIFY_NULL(T)      if(NULL == T){ return; }
 
@@ -36,10 +38,10 @@ struct _rbusProperty
 
 rbusProperty_t rbusProperty_Init(rbusProperty_t* pproperty, char const* name, rbusValue_t value)
 {
-    rbusProperty_t p = rt_calloc(1, sizeof(struct _rbusProperty));
+    rbusProperty_t p = rbusPool_Alloc(RBUS_POOL_PROPERTY, sizeof(struct _rbusProperty));
     p->retainable.refCount = 1;
     if(name)
-        p->name = strdup(name);
+        p->name = rbusPool_StrDup(name);
     if(value)
         rbusProperty_SetValue(p, value);
     if(pproperty)
@@ -54,7 +56,7 @@ void rbusProperty_Destroy(rtRetainable* r)
 
     if(property->name)
     {
-        free(property->name);
+        rbusPool_FreeString(property->name);
         property->name = NULL;
     }
 
@@ -65,7 +67,7 @@ void rbusProperty_Destroy(rtRetainable* r)
         property->next = NULL;
     }
 
-    free(property);
+    rbusPool_Free(RBUS_POOL_PROPERTY, property);
 }
 
 void rbusProperty_Retain(rbusProperty_t property)
@@ -114,12 +116,12 @@ void rbusProperty_Copy(rbusProperty_t destination, rbusProperty_t source)
 {
     if(destination->name)
     {
-        free(destination->name);
+        rbusPool_FreeString(destination->name);
         destination->name = NULL;
     }
 
     if(source->name)
-        destination->name = strdup(source->name);
+        destination->name = rbusPool_StrDup(source->name);
 
     rbusValue_Copy(destination->value, source->value);
 
@@ -155,9 +157,9 @@ void rbusProperty_SetName(rbusProperty_t property, char const* name)
 {
     VERIFY_NULL(property);
     if(property->name)
-        free(property->name);
+        rbusPool_FreeString(property->name);
     if(name)
-        property->name = strdup(name);
+        property->name = rbusPool_StrDup(name);
     else
         property->name = NULL;
 }
@@ -348,3 +350,94 @@ DEFINE_PROPERTY_TYPE_FUNCS(Double, double, RBUS_DOUBLE, f64)
 DEFINE_PROPERTY_TYPE_FUNCS(Time,rbusDateTime_t const*, RBUS_DATETIME, tv);
 DEFINE_PROPERTY_TYPE_FUNCS(Property,struct _rbusProperty*, RBUS_PROPERTY, property);
 DEFINE_PROPERTY_TYPE_FUNCS(Object,struct _rbusObject*, RBUS_OBJECT, object);
+
+static void rbusProperty_EncodeName(char const* name, rbusBuffer_t buff)
+{
+    if(name)
+        rbusBuffer_WriteStringTLV(buff, name, strlen(name)+1);
+    else
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_NONE, 0, NULL);
+}
+
+int rbusProperty_Encode(rbusProperty_t property, rbusBuffer_t buff)
+{
+    if(!property)
+        return -1;
+    if(property->name && strlen(property->name) >= UINT16_MAX)
+        return -1;
+    rbusProperty_EncodeName(property->name, buff);
+    if(!property->value)
+    {
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_NONE, 0, NULL);
+        return 0;
+    }
+    return rbusValue_Encode(property->value, buff);
+}
+
+int rbusProperty_Decode(rbusProperty_t* property, rbusBuffer_t const buff)
+{
+    rbusValue_t name = NULL;
+    rbusValue_t value = NULL;
+
+    if(rbusValue_Decode(&name, buff) < 0)
+    {
+        rbusValue_Release(name);
+        return -1;
+    }
+    if(rbusValue_Decode(&value, buff) < 0)
+    {
+        rbusValue_Release(name);
+        rbusValue_Release(value);
+        return -1;
+    }
+    rbusProperty_Init(property,
+        rbusValue_GetType(name) == RBUS_STRING ? rbusValue_GetString(name, NULL) : NULL,
+        rbusValue_GetType(value) == RBUS_NONE ? NULL : value);
+    rbusValue_Release(name);
+    rbusValue_Release(value);
+    return 0;
+}
+
+int rbusPropertyList_Encode(rbusProperty_t first, rbusBuffer_t buff)
+{
+    rbusProperty_t prop;
+    rbusBuffer_WriteInt32TLV(buff, (int32_t)rbusProperty_Count(first));
+    for(prop = first; prop; prop = prop->next)
+    {
+        if(rbusProperty_Encode(prop, buff) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+int rbusPropertyList_Decode(rbusProperty_t* first, rbusBuffer_t const buff)
+{
+    rbusProperty_t head = NULL, tail = NULL;
+    int32_t numProps = 0;
+
+    *first = NULL;
+    if(rbusBuffer_ReadInt32TLV(buff, &numProps) < 0)
+        return -1;
+    while(--numProps >= 0)
+    {
+        rbusProperty_t prop;
+        if(rbusProperty_Decode(&prop, buff) < 0)
+        {
+            if(head)
+                rbusProperty_Release(head);
+            return -1;
+        }
+        if(tail)
+        {
+            /*the list holds the only reference to each property after the first*/
+            tail->next = prop;
+        }
+        else
+        {
+            head = prop;
+        }
+        tail = prop;
+    }
+    *first = head;
+    return 0;
+}
@@ -17,11 +17,17 @@
  * limitations under the License.
 */
 
+#define _GNU_SOURCE 1 //needed for PTHREAD_MUTEX_RECURSIVE
+
 #include "rbus_subscriptions.h"
+#include "rbus_intervalsub.h"
 #include "rbus_buffer.h"
 #include "rbus_handle.h"
+#include "rbus_atom.h"
+#include "rbus_hash.h"
 #include <rtMemory.h>
 #include <string.h>
+#include <pthread.h>
 #include <assert.h>
 #include <sys/stat.h>
 #include <sys/types.h> 
@@ -29,7 +35,20 @@
 
 #define VERIFY_NULL(T)         if(NULL == T){ return; }
 #define CACHE_FILE_PATH_FORMAT "%s/rbus_subs_%s"
-
+#define SUBS_INDEX_MIN_BUCKETS 64
+
+/*  Subscriptions are kept in subList, in the order they were added, for the cache file and
+    for matching new table rows.  They are also in two hash tables (see rbus_hash.h) so that lookups
+    by key [listener, componentId, eventName, filter] and by listener don't scan the list:
+    keyIndex links them through keyLink and listenerIndex through listenerLink.
+    A third table, patternIndex, links them through patternLink and groups subs by the
+    registration node their event name resolves to (e.g. Foo.{i}.Prop for Foo.*.Prop).
+    An instance node can only match a sub's token chain if both come from the same registration
+    node, so when a table row is added only the subs hashed with that node are matched against it.
+    The registry is changed by the thread handling subscribe requests, by threads adding and removing
+    table rows and by the interval thread expiring subscriptions, so they all hold its mutex
+    (see rbusSubscriptions_lock).
+ */
 struct _rbusSubscriptions
 {
     rbusHandle_t handle;
@@ -37,12 +56,21 @@ struct _rbusSubscriptions
     char* componentName;
     char* tmpDir;
     rtList subList;
+    uint32_t numCached;         /* subs loaded from cache and not yet resubscribed */
+    rbusHashTable keyIndex;
+    rbusHashTable listenerIndex;
+    rbusHashTable patternIndex;
+    bool deferSave;             /* while set, saveCache only marks the cache dirty */
+    bool cacheDirty;
+    pthread_mutex_t mutex;      /* recursive, so subscribe handlers can be called with it held */
 };
 
 static void rbusSubscriptions_loadCache(rbusSubscriptions_t subscriptions);
 static void rbusSubscriptions_saveCache(rbusSubscriptions_t subscriptions);
+static void rbusSubscriptions_beginDeferSave(rbusSubscriptions_t subscriptions);
+static void rbusSubscriptions_endDeferSave(rbusSubscriptions_t subscriptions);
 
-int subscribeHandlerImpl(rbusHandle_t handle, bool added, elementNode* el, char const* eventName, char const* listener, int32_t componentId, int32_t interval, int32_t duration, rbusFilter_t filter);
+int subscribeHandlerImpl(rbusHandle_t handle, bool added, elementNode* el, char const* eventName, char const* listener, int32_t componentId, int32_t interval, int32_t duration, rbusFilter_t filter, int32_t version);
 
 static int subscriptionKeyCompare(rbusSubscription_t* subscription, char const* listener, int32_t componentId,  char const* eventName, rbusFilter_t filter)
 {
@@ -64,6 +92,48 @@ static int subscriptionKeyCompare(rbusSubscription_t* subscription, char const*
     return rc;
 }
 
+static uint32_t subscriptionListenerHash(char const* listener)
+{
+    return rbusHash_String(listener);
+}
+
+/*the filter isn't hashed, so subs differing only by filter share a chain and are told apart by rbusFilter_Compare*/
+static uint32_t subscriptionKeyHash(char const* listener, int32_t componentId, char const* eventName)
+{
+    uint32_t hash = rbusHash_Bytes(RBUS_HASH_INIT, listener, strlen(listener) + 1);
+    hash = rbusHash_Bytes(hash, &componentId, sizeof(componentId));
+    return rbusHash_Bytes(hash, eventName, strlen(eventName));
+}
+
+static uint32_t subscriptionPatternHash(elementNode* node)
+{
+    elementNode* regNode = getRegistrationElement(node);
+    return rbusHash_Bytes(RBUS_HASH_INIT, &regNode, sizeof(regNode));
+}
+
+/*add sub to the end of subList and to the indexes*/
+static void rbusSubscriptions_insert(rbusSubscriptions_t subscriptions, rbusSubscription_t* sub)
+{
+    rtList_PushBack(subscriptions->subList, sub, &sub->listItem);
+    if(!sub->tokens)
+        subscriptions->numCached++;
+    rbusHashTable_Insert(&subscriptions->keyIndex, &sub->keyLink, subscriptionKeyHash(sub->listener, sub->componentId, sub->eventName));
+    rbusHashTable_Insert(&subscriptions->listenerIndex, &sub->listenerLink, subscriptionListenerHash(sub->listener));
+    rbusHashTable_Insert(&subscriptions->patternIndex, &sub->patternLink, subscriptionPatternHash(sub->element));
+}
+
+/*remove sub from subList and the indexes without freeing it*/
+static void rbusSubscriptions_unlink(rbusSubscriptions_t subscriptions, rbusSubscription_t* sub)
+{
+    rbusHashTable_Remove(&subscriptions->keyIndex, &sub->keyLink);
+    rbusHashTable_Remove(&subscriptions->listenerIndex, &sub->listenerLink);
+    rbusHashTable_Remove(&subscriptions->patternIndex, &sub->patternLink);
+    rtList_RemoveItem(subscriptions->subList, sub->listItem, NULL);
+    sub->listItem = NULL;
+    if(!sub->tokens)
+        subscriptions->numCached--;
+}
+
 static void subscriptionFree(void* p)
 {
     rbusSubscription_t* sub = p;
@@ -82,21 +152,34 @@ static void subscriptionFree(void* p)
         TokenChain_destroy(sub->tokens);
     if(sub->instances)
         rtList_Destroy(sub->instances, NULL);
-    free(sub->eventName);
+    rbusAtom_Release(sub->eventName);
     free(sub->listener);
     if(sub->filter)
         rbusFilter_Release(sub->filter);
+    free(sub->trailer);
     free(sub);
 }
 
 void rbusSubscriptions_create(rbusSubscriptions_t* subscriptions, rbusHandle_t handle, char const* componentName, elementNode* root, const char* tmpDir)
 {
+    pthread_mutexattr_t attrib;
+
     *subscriptions = rt_malloc(sizeof(struct _rbusSubscriptions));
     (*subscriptions)->handle = handle;
     (*subscriptions)->root = root;
     (*subscriptions)->componentName = strdup(componentName);
     (*subscriptions)->tmpDir = strdup(tmpDir);
     rtList_Create(&(*subscriptions)->subList);
+    (*subscriptions)->numCached = 0;
+    (*subscriptions)->deferSave = false;
+    (*subscriptions)->cacheDirty = false;
+    rbusHashTable_Init(&(*subscriptions)->keyIndex, SUBS_INDEX_MIN_BUCKETS);
+    rbusHashTable_Init(&(*subscriptions)->listenerIndex, SUBS_INDEX_MIN_BUCKETS);
+    rbusHashTable_Init(&(*subscriptions)->patternIndex, SUBS_INDEX_MIN_BUCKETS);
+    pthread_mutexattr_init(&attrib);
+    pthread_mutexattr_settype(&attrib, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&(*subscriptions)->mutex, &attrib);
+    pthread_mutexattr_destroy(&attrib);
     rbusSubscriptions_loadCache(*subscriptions);
 }
 
@@ -105,15 +188,31 @@ void rbusSubscriptions_destroy(rbusSubscriptions_t subscriptions)
 {
     VERIFY_NULL(subscriptions);
     rtList_Destroy(subscriptions->subList, subscriptionFree);
+    rbusHashTable_Clear(&subscriptions->keyIndex);
+    rbusHashTable_Clear(&subscriptions->listenerIndex);
+    rbusHashTable_Clear(&subscriptions->patternIndex);
     free(subscriptions->componentName);
     free(subscriptions->tmpDir);
+    pthread_mutex_destroy(&subscriptions->mutex);
     free(subscriptions);
 }
 
+void rbusSubscriptions_lock(rbusSubscriptions_t subscriptions)
+{
+    VERIFY_NULL(subscriptions);
+    pthread_mutex_lock(&subscriptions->mutex);
+}
+
+void rbusSubscriptions_unlock(rbusSubscriptions_t subscriptions)
+{
+    VERIFY_NULL(subscriptions);
+    pthread_mutex_unlock(&subscriptions->mutex);
+}
+
 static void rbusSubscriptions_onSubscriptionCreated(rbusSubscription_t* sub, elementNode* node);
 
 /*add a new subscription*/
-rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter, int32_t interval, int32_t duration, bool autoPublish, elementNode* registryElem)
+rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter, int32_t interval, int32_t duration, bool autoPublish, int32_t version, elementNode* registryElem)
 {
     rbusSubscription_t* sub;
     TokenChain* tokens;
@@ -132,7 +231,7 @@ rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscr
     sub = rt_malloc(sizeof(rbusSubscription_t));
 
     sub->listener = strdup(listener);
-    sub->eventName = strdup(eventName);
+    sub->eventName = rbusAtom_Intern(eventName, strlen(eventName));
     sub->componentId = componentId;
     sub->filter = filter;
     if(sub->filter)
@@ -140,10 +239,13 @@ rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscr
     sub->interval = interval;
     sub->duration = duration;
     sub->autoPublish = autoPublish;
+    sub->version = version;
     sub->element = registryElem;
     sub->tokens = tokens;
+    sub->trailer = NULL;
+    sub->trailerLength = 0;
     rtList_Create(&sub->instances);
-    rtList_PushBack(subscriptions->subList, sub, NULL);
+    rbusSubscriptions_insert(subscriptions, sub);
 
     rbusSubscriptions_onSubscriptionCreated(sub, subscriptions->root);
 
@@ -155,30 +257,21 @@ rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscr
 /*get an existing subscription by searching for its unique key [eventName, listener, filter]*/
 rbusSubscription_t* rbusSubscriptions_getSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter)
 {
-    rtListItem item;
-    rbusSubscription_t* sub;
+    rbusHashLink* link;
 
     RBUSLOG_DEBUG("%s: searching for %s %s", __FUNCTION__, listener, eventName);
 
     if(!subscriptions)
         return NULL;
 
-    rtList_GetFront(subscriptions->subList, &item);
-
-    while(item)
+    for(link = rbusHashTable_Find(&subscriptions->keyIndex, subscriptionKeyHash(listener, componentId, eventName)); link; link = rbusHashTable_FindNext(link))
     {
-        rtListItem_GetData(item, (void**)&sub);
-
-        if(!sub)
-            return NULL;
-        RBUSLOG_DEBUG("%s: comparing to %s %s", __FUNCTION__, sub->listener, sub->eventName);
-
+        rbusSubscription_t* sub = rbusHashTable_Entry(link, rbusSubscription_t, keyLink);
         if(subscriptionKeyCompare(sub, listener, componentId, eventName, filter) == 0)
         {
             RBUSLOG_DEBUG("%s: found sub %s %s %d", __FUNCTION__, listener, eventName, componentId);
             return sub;
         }
-        rtListItem_GetNext(item, &item);
     }
     RBUSLOG_DEBUG("%s: no sub found for %s %s", __FUNCTION__, listener, eventName);
 
@@ -188,26 +281,19 @@ rbusSubscription_t* rbusSubscriptions_getSubscription(rbusSubscriptions_t subscr
 /*remove an existing subscription*/
 void rbusSubscriptions_removeSubscription(rbusSubscriptions_t subscriptions, rbusSubscription_t* sub)
 {
-    rtListItem item;
-    rbusSubscription_t* sub2;
-
     VERIFY_NULL(subscriptions);
     VERIFY_NULL(sub);
     RBUSLOG_DEBUG("%s: %s %s", __FUNCTION__, sub->listener, sub->eventName);
 
-    rtList_GetFront(subscriptions->subList, &item);
-
-    while(item)
+    if(sub->listItem)
     {
-        rtListItem_GetData(item, (void**)&sub2);
-        if(sub == sub2)
-        {
-            RBUSLOG_DEBUG("%s: removing %s %s", __FUNCTION__, sub->listener, sub->eventName);
-            rtList_RemoveItem(subscriptions->subList, item, subscriptionFree);
-            break;
-        }
-        rtListItem_GetNext(item, &item);
-    }    
+        RBUSLOG_DEBUG("%s: removing %s %s", __FUNCTION__, sub->listener, sub->eventName);
+        /*however the sub is removed (unsubscribe, expiry or its row deleted), stop timing it before it's freed*/
+        if(sub->interval > 0 || sub->duration > 0)
+            rbusIntervalSub_RemoveSubscription(subscriptions->handle, sub);
+        rbusSubscriptions_unlink(subscriptions, sub);
+        subscriptionFree(sub);
+    }
     rbusSubscriptions_saveCache(subscriptions);
 }
 
@@ -233,6 +319,12 @@ static void rbusSubscriptions_onSubscriptionCreated(rbusSubscription_t* sub, ele
                 }
             }
 
+            /*a virtual row has no instance nodes to add until its children get copied from the template*/
+            if(child->virtualRow && TokenChain_matchPrefix(sub->tokens, child))
+            {
+                materializeTableRow(child);
+            }
+
             /*recurse into children except for row templates {i}*/
             if( child->child && !(child->parent->type == RBUS_ELEMENT_TYPE_TABLE && strcmp(child->name, "{i}") == 0) )
             {
@@ -245,6 +337,40 @@ static void rbusSubscriptions_onSubscriptionCreated(rbusSubscription_t* sub, ele
     }
 }
 
+/*  check whether any subscription could match a node the virtual row will have once materialized
+ *  regNode walks the row template the same way onElementCreated walks the row
+ */
+static bool rbusSubscriptions_virtualRowHasMatch(rbusSubscriptions_t subscriptions, elementNode* row, elementNode* regNode)
+{
+    elementNode* child = regNode->child;
+
+    while(child)
+    {
+        if(child->type == 0)
+        {
+            if(rbusSubscriptions_virtualRowHasMatch(subscriptions, row, child))
+                return true;
+        }
+        else
+        {
+            rbusHashLink* link;
+
+            for(link = rbusHashTable_Find(&subscriptions->patternIndex, subscriptionPatternHash(child)); link; link = rbusHashTable_FindNext(link))
+            {
+                rbusSubscription_t* sub = rbusHashTable_Entry(link, rbusSubscription_t, patternLink);
+                if(sub->tokens &&
+                   TokenChain_matchPrefix(sub->tokens, row))
+                {
+                    return true;
+                }
+            }
+        }
+
+        child = child->nextSibling;
+    }
+    return false;
+}
+
 /*  called after a new node instance is created 
  *  we go through the list of subscriptions and check to see if the 
  *  new node is picked up by any subscription eventName
@@ -253,7 +379,17 @@ static void rbusSubscriptions_onElementCreated(rbusSubscriptions_t subscriptions
 {
     if(node)
     {
-        elementNode* child = node->child;
+        elementNode* child;
+
+        /*a new row stays virtual unless a subscription needs its instance nodes*/
+        if(node->virtualRow)
+        {
+            if(!rbusSubscriptions_virtualRowHasMatch(subscriptions, node, node->regNode))
+                return;
+            materializeTableRow(node);
+        }
+
+        child = node->child;
 
         while(child)
         {
@@ -263,22 +399,18 @@ static void rbusSubscriptions_onElementCreated(rbusSubscriptions_t subscriptions
             }
             else
             {
-                rtListItem item;
-                rbusSubscription_t* sub;
-
-                rtList_GetFront(subscriptions->subList, &item);
+                rbusHashLink* link;
 
-                while(item)
+                /*only subs of the same registration node can match*/
+                for(link = rbusHashTable_Find(&subscriptions->patternIndex, subscriptionPatternHash(child)); link; link = rbusHashTable_FindNext(link))
                 {
-                    rtListItem_GetData(item, (void**)&sub);
-
+                    rbusSubscription_t* sub = rbusHashTable_Entry(link, rbusSubscription_t, patternLink);
                     if(sub->tokens/*tokens can NULL when loaded from cache*/ && 
                        TokenChain_match(sub->tokens, child))
                     {
                         rtList_PushBack(sub->instances, child, NULL);
                         addElementSubscription(child, sub, false);
                     }
-                    rtListItem_GetNext(item, &item);
                 }
 
                 /*we dont recurse into child because either child is a leaf (e.g. property/method/event)
@@ -299,28 +431,24 @@ void rbusSubscriptions_onElementDeleted(rbusSubscriptions_t subscriptions, eleme
 
         while(child)
         {
-            /*if child's type is a subscribable type*/
-            if(child->type != 0)
+            /*if child's type is a subscribable type, the subs with child as an instance are in its subscriptions list*/
+            if(child->type != 0 && child->subscriptions)
             {
-                rtListItem item, tempitem;
+                rtListItem item;
                 rbusSubscription_t* sub;
-                bool val=false;
-                rbusSubscription_t* subscription = NULL;
 
-                rtList_GetFront(subscriptions->subList, &item);
+                rtList_GetFront(child->subscriptions, &item);
 
-                /* go through all subscriptions */
                 while(item)
                 {
                     rtListItem item2;
                     elementNode* inst;
 
-                    rtListItem_GetNext(item, &tempitem);
                     rtListItem_GetData(item, (void**)&sub);
 
                     rtList_GetFront(sub->instances, &item2);
 
-                    /* go through all instances in this subscription */
+                    /* remove child from this subscription's instances */
                     while(item2)
                     {
                         rtListItem_GetData(item2, (void**)&inst);
@@ -328,27 +456,16 @@ void rbusSubscriptions_onElementDeleted(rbusSubscriptions_t subscriptions, eleme
                         if(child == inst)
                         {
                             rtList_RemoveItem(sub->instances, item2, NULL);
-                            removeElementSubscription(child, sub);
-                            val = true;
                             break;
                         }
                         rtListItem_GetNext(item2, &item2);
                     }
+                    rtList_RemoveItem(child->subscriptions, item, NULL);
 
                     /* RDKB-38389 : Removing the instance of the row to be removed from the subscriptions->subList linked list */
-                    if(val)
-                    {
-                        subscription = rbusSubscriptions_getSubscription(subscriptions, sub->listener, sub->eventName, sub->componentId, sub->filter);
-                        if(!subscription)
-                        {
-                            RBUSLOG_INFO("unsubscribing from event which isn't currectly subscribed to event=%s listener=%s", sub->eventName, sub->listener);
-                        }
-                        else
-                        {
-                            rbusSubscriptions_removeSubscription(subscriptions, subscription);
-                        }
-                    }
-                    item = tempitem;
+                    rbusSubscriptions_removeSubscription(subscriptions, sub);
+
+                    rtList_GetFront(child->subscriptions, &item);
                 }
             }
 
@@ -369,10 +486,103 @@ void rbusSubscriptions_onTableRowAdded(rbusSubscriptions_t subscriptions, elemen
     rbusSubscriptions_onElementCreated(subscriptions, node);
 }
 
+/*add to subs every subscription to a node under the row template regNode*/
+static void rbusSubscriptions_collectTemplateSubs(rbusSubscriptions_t subscriptions, elementNode* regNode, rtVector subs)
+{
+    elementNode* child = regNode->child;
+
+    while(child)
+    {
+        if(child->type == 0)
+        {
+            rbusSubscriptions_collectTemplateSubs(subscriptions, child, subs);
+        }
+        else
+        {
+            rbusHashLink* link;
+
+            for(link = rbusHashTable_Find(&subscriptions->patternIndex, subscriptionPatternHash(child)); link; link = rbusHashTable_FindNext(link))
+            {
+                rbusSubscription_t* sub = rbusHashTable_Entry(link, rbusSubscription_t, patternLink);
+                if(sub->tokens)
+                    rtVector_PushBack(subs, sub);
+            }
+        }
+
+        child = child->nextSibling;
+    }
+}
+
+void rbusSubscriptions_onTableRowsAdded(rbusSubscriptions_t subscriptions, elementNode** rows, int numRows)
+{
+    rtVector subs;
+    size_t numSubs;
+    size_t j;
+    int i;
+
+    VERIFY_NULL(subscriptions);
+    VERIFY_NULL(rows);
+
+    /*rows of the same table share a template, so find the subscriptions that could match under it once
+      and leave the rows no subscription can match virtual*/
+    rtVector_Create(&subs);
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i] && rows[i]->virtualRow)
+        {
+            rbusSubscriptions_collectTemplateSubs(subscriptions, rows[i]->regNode, subs);
+            break;
+        }
+    }
+    numSubs = rtVector_Size(subs);
+
+    rbusSubscriptions_beginDeferSave(subscriptions);
+    for(i = 0; i < numRows; ++i)
+    {
+        elementNode* row = rows[i];
+
+        if(!row)
+            continue;
+
+        if(row->virtualRow)
+        {
+            for(j = 0; j < numSubs; ++j)
+            {
+                if(TokenChain_matchPrefix(((rbusSubscription_t*)rtVector_At(subs, j))->tokens, row))
+                    break;
+            }
+            if(j == numSubs)
+                continue;
+            materializeTableRow(row);
+        }
+        rbusSubscriptions_onElementCreated(subscriptions, row);
+    }
+    rbusSubscriptions_endDeferSave(subscriptions);
+
+    rtVector_Destroy(subs, NULL);
+}
+
+void rbusSubscriptions_onTableRowsRemoved(rbusSubscriptions_t subscriptions, elementNode** rows, int numRows)
+{
+    int i;
+
+    VERIFY_NULL(subscriptions);
+    VERIFY_NULL(rows);
+    rbusSubscriptions_beginDeferSave(subscriptions);
+    for(i = 0; i < numRows; ++i)
+    {
+        if(rows[i])
+            rbusSubscriptions_onElementDeleted(subscriptions, rows[i]);
+    }
+    rbusSubscriptions_endDeferSave(subscriptions);
+}
+
 void rbusSubscriptions_onTableRowRemoved(rbusSubscriptions_t subscriptions, elementNode* node)
 {
     VERIFY_NULL(subscriptions);
+    rbusSubscriptions_beginDeferSave(subscriptions);
     rbusSubscriptions_onElementDeleted(subscriptions, node);
+    rbusSubscriptions_endDeferSave(subscriptions);
 }
 
 static pid_t rbusSubscriptions_getListenerPid(char const* listener)
@@ -497,13 +707,7 @@ static void rbusSubscriptions_loadCache(rbusSubscriptions_t subscriptions)
         if(rbusBuffer_ReadUInt16(buff, &length) < 0) goto remove_bad_file;
         if(type != RBUS_STRING || length >= RBUS_MAX_NAME_LENGTH) goto remove_bad_file;
 
-        sub->eventName = rt_try_malloc(length);
-        if(!sub->eventName)
-        {
-            RBUSLOG_ERROR("%s: failed to malloc %d bytes for eventName", __FUNCTION__, length);
-            goto remove_bad_file;
-        }
-        memcpy(sub->eventName, buff->data + buff->posRead, length);
+        sub->eventName = rbusAtom_Intern((char const*)buff->data + buff->posRead, strnlen((char const*)buff->data + buff->posRead, length));
         buff->posRead += length;
 
         //read componentId
@@ -545,6 +749,22 @@ static void rbusSubscriptions_loadCache(rbusSubscriptions_t subscriptions)
         {
             sub->filter = NULL;
         }
+
+        //read version, which files written before it was added don't have.  the next sub starts with a string
+        if(buff->posRead < buff->posWrite)
+        {
+            int posRead = buff->posRead;
+            if(rbusBuffer_ReadUInt16(buff, &type) < 0) goto remove_bad_file;
+            if(type == RBUS_INT32)
+            {
+                if(rbusBuffer_ReadUInt16(buff, &length) < 0) goto remove_bad_file;
+                if(rbusBuffer_ReadInt32(buff, &sub->version) < 0) goto remove_bad_file;
+            }
+            else
+            {
+                buff->posRead = posRead;
+            }
+        }
         /*
             It's possible that we can load a sub from the cache for a listener whose process is no longer running.
             Example, this provider exited with active subscribers and thus still had those subs in its cache.
@@ -560,7 +780,7 @@ static void rbusSubscriptions_loadCache(rbusSubscriptions_t subscriptions)
         }
 
         rtList_Create(&sub->instances);
-        rtList_PushBack(subscriptions->subList, sub, NULL);
+        rbusSubscriptions_insert(subscriptions, sub);
 
         RBUSLOG_INFO("%s: loaded %s %s", __FUNCTION__, sub->listener, sub->eventName);
     }
@@ -597,6 +817,12 @@ static void rbusSubscriptions_saveCache(rbusSubscriptions_t subscriptions)
     rbusSubscription_t* sub;
     char filePath[256];
 
+    if(subscriptions->deferSave)
+    {
+        subscriptions->cacheDirty = true;
+        return;
+    }
+
     snprintf(filePath, 256, CACHE_FILE_PATH_FORMAT, subscriptions->tmpDir, subscriptions->componentName);
 
     RBUSLOG_INFO("%s: saving %s", __FUNCTION__, filePath);
@@ -637,6 +863,7 @@ static void rbusSubscriptions_saveCache(rbusSubscriptions_t subscriptions)
         rbusBuffer_WriteInt32TLV(buff, sub->filter ? 1 : 0);
         if(sub->filter)
           rbusFilter_Encode(sub->filter, buff);
+        rbusBuffer_WriteInt32TLV(buff, sub->version);
 
         RBUSLOG_DEBUG("%s: saved %s %s", __FUNCTION__, sub->listener, sub->eventName);
 
@@ -650,6 +877,22 @@ static void rbusSubscriptions_saveCache(rbusSubscriptions_t subscriptions)
     fclose(file);
 }
 
+/*hold off writing the cache while removing or adding many subs, then write it once*/
+static void rbusSubscriptions_beginDeferSave(rbusSubscriptions_t subscriptions)
+{
+    subscriptions->deferSave = true;
+}
+
+static void rbusSubscriptions_endDeferSave(rbusSubscriptions_t subscriptions)
+{
+    subscriptions->deferSave = false;
+    if(subscriptions->cacheDirty)
+    {
+        subscriptions->cacheDirty = false;
+        rbusSubscriptions_saveCache(subscriptions);
+    }
+}
+
 /*this is basicially a strcmp with the addition that it will ignore any wildcard (e.g. "*") in the event name
   if there's a corresponding table row tag (e.g. "{i}") in the element name */
 static int _compareEventNameToElemName(char const* event, char const* elem)
@@ -696,32 +939,96 @@ static int _compareEventNameToElemName(char const* event, char const* elem)
     }
 }
 
-void rbusSubscriptions_resubscribeCache(rbusHandle_t handle, rbusSubscriptions_t subscriptions, char const* elementName, elementNode* el)
+/*hashes a name with every wildcard "*" and row tag "{i}" hashed alike, so that
+  names equal by _compareEventNameToElemName have equal hashes*/
+static uint32_t _hashEventName(char const* name)
+{
+    uint32_t hash = RBUS_HASH_INIT;
+    while(*name)
+    {
+        uint8_t c = (uint8_t)*name;
+        if(strncmp(name, "{i}", 3) == 0)
+        {
+            c = '*';
+            name += 3;
+        }
+        else
+        {
+            name++;
+        }
+        hash = rbusHash_Byte(hash, c);
+    }
+    return hash;
+}
+
+void rbusSubscriptions_resubscribeCache(rbusHandle_t handle, rbusSubscriptions_t subscriptions, int numElements, rbusDataElement_t* elements, elementNode** nodes)
 {
     rtListItem item;
     rbusSubscription_t* sub;
+    uint32_t numSlots = 8;
+    uint32_t mask;
+    int* slots;
+    int i;
 
     VERIFY_NULL(subscriptions);
-    VERIFY_NULL(el);
-    RBUSLOG_DEBUG("%s: event %s", __FUNCTION__, elementName);
+    VERIFY_NULL(elements);
+    VERIFY_NULL(nodes);
+    RBUSLOG_DEBUG("%s: %d elements", __FUNCTION__, numElements);
+
+    /*only subs loaded from the cache are waiting to be resubscribed*/
+    if(subscriptions->numCached == 0 || numElements <= 0)
+        return;
+
+    /*open addressed table of element index + 1, so each cached sub looks up its element instead of comparing to all*/
+    while(numSlots < (uint32_t)numElements * 2)
+        numSlots *= 2;
+    mask = numSlots - 1;
+    slots = rt_calloc(numSlots, sizeof(int));
+    for(i = 0; i < numElements; ++i)
+    {
+        uint32_t slot = _hashEventName(elements[i].name) & mask;
+        while(slots[slot])
+            slot = (slot + 1) & mask;
+        slots[slot] = i + 1;
+    }
+
+    rbusSubscriptions_lock(subscriptions);
+
+    /*write the cache once after all subs are resubscribed*/
+    rbusSubscriptions_beginDeferSave(subscriptions);
 
     rtList_GetFront(subscriptions->subList, &item);
 
     while(item)
     {
+        elementNode* el = NULL;
+
         rtListItem_GetData(item, (void**)&sub);
 
-        VERIFY_NULL(sub);
+        if(!sub)
+            break;
+
+        if(sub->element == NULL && sub->tokens == NULL)/*not already subscribed*/
+        {
+            uint32_t slot;
+            for(slot = _hashEventName(sub->eventName) & mask; slots[slot]; slot = (slot + 1) & mask)
+            {
+                if(_compareEventNameToElemName(sub->eventName, elements[slots[slot] - 1].name) == 0)
+                {
+                    el = nodes[slots[slot] - 1];
+                    break;
+                }
+            }
+        }
 
-        if(sub->element == NULL && sub->tokens == NULL &&/*not already subscribed*/
-           _compareEventNameToElemName(sub->eventName, elementName) == 0)
+        if(el)
         {
             rtListItem next;
             rbusError_t err;
             RBUSLOG_INFO("%s: subscribing %s %s", __FUNCTION__, sub->eventName, sub->listener);
             rtListItem_GetNext(item, &next);
-            rtList_RemoveItem(subscriptions->subList, item, NULL);/*remove before calling subscribeHandlerImpl to avoid dupes in cache file*/
-            err = subscribeHandlerImpl(handle, true, el, sub->eventName, sub->listener, sub->componentId, sub->interval, sub->duration, sub->filter);
+            rbusSubscriptions_unlink(subscriptions, sub);/*remove before calling subscribeHandlerImpl to avoid dupes in cache file*/
+            err = subscribeHandlerImpl(handle, true, el, sub->eventName, sub->listener, sub->componentId, sub->interval, sub->duration, sub->filter, sub->version);
             /*TODO figure out what to do if we get an error resubscribing
             It's conceivable that a provider might not like the sub due to some state change between this and the previous process run
             */
@@ -734,31 +1041,41 @@ void rbusSubscriptions_resubscribeCache(rbusHandle_t handle, rbusSubscriptions_t
             rtListItem_GetNext(item, &item);
         }
     }
+
+    free(slots);
+
+    rbusSubscriptions_endDeferSave(subscriptions);
+
+    rbusSubscriptions_unlock(subscriptions);
 }
 
 void rbusSubscriptions_handleClientDisconnect(rbusHandle_t handle, rbusSubscriptions_t subscriptions, char const* listener)
 {
-    rtListItem item;
-    rbusSubscription_t* sub;
+    rbusHashLink* link;
+    rbusHashLink* next;
     elementNode* el = NULL;
     struct _rbusHandle* handleInfo = (struct _rbusHandle*)handle;
 
     VERIFY_NULL(subscriptions);
     RBUSLOG_DEBUG("%s: %s", __FUNCTION__, listener);
 
-    rtList_GetFront(subscriptions->subList, &item);
+    rbusSubscriptions_lock(subscriptions);
 
-    while(item)
+    /*write the cache once after all of the listener's subs are gone, not once per sub*/
+    rbusSubscriptions_beginDeferSave(subscriptions);
+
+    /*unsubscribing by the sub's full key removes only that sub, so next stays valid*/
+    for(link = rbusHashTable_Find(&subscriptions->listenerIndex, subscriptionListenerHash(listener)); link; link = next)
     {
-        rtListItem_GetData(item, (void**)&sub);
-        rtListItem_GetNext(item, &item);
+        rbusSubscription_t* sub = rbusHashTable_Entry(link, rbusSubscription_t, listenerLink);
+        next = rbusHashTable_FindNext(link);
         if(strcmp(sub->listener, listener) == 0)
         {
             /* RDKB-38389 : Checking for elementnode existence for which the eventname is subscribed */
             el = retrieveInstanceElement(handleInfo->elementRoot, sub->eventName);
             if(el)
             {
-                subscribeHandlerImpl(handle, false, sub->element, sub->eventName, sub->listener, sub->componentId, 0, 0, 0);
+                subscribeHandlerImpl(handle, false, sub->element, sub->eventName, sub->listener, sub->componentId, 0, 0, sub->filter, sub->version);
             }
             else
             {
@@ -766,6 +1083,10 @@ void rbusSubscriptions_handleClientDisconnect(rbusHandle_t handle, rbusSubscript
             }
         }
     }
+
+    rbusSubscriptions_endDeferSave(subscriptions);
+
+    rbusSubscriptions_unlock(subscriptions);
 }
 
 #if 0
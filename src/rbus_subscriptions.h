@@ -29,23 +29,33 @@ extern "C" {
 
 typedef struct _rbusSubscriptions *rbusSubscriptions_t;
 
+/*subscribe payloads end with the subscriber's wire version.  older subscribers send none and are version 0*/
+#define RBUS_SUBSCRIBE_WIRE_VERSION 1
+
 /* The unique 'key' for a subscription is [listener, eventName, filter]
     meaning a subscriber can subscribe to the same event with different filters
  */
 typedef struct _rbusSubscription
 {
     char* listener;             /* the subscriber's address to publish to*/
-    char* eventName;            /* the event name subscribed to e.g. Device.WiFi.AccessPoint.1.AssociatedDevice.*.SignalStrength */
+    char const* eventName;      /* the event name subscribed to e.g. Device.WiFi.AccessPoint.1.AssociatedDevice.*.SignalStrength, an atom */
     int32_t componentId;     /* the id known by the subscriber and unique per listener/process */
     rbusFilter_t filter;        /* optional filter */
     int32_t interval;           /* optional interval */
     int32_t duration;           /* optional duration */
     bool autoPublish;           /* auto publishing */
+    int32_t version;            /* the subscriber's wire version, which says what it can unpack, e.g. batched events */
     TokenChain* tokens;         /* tokenized eventName for pattern matching */
     elementNode* element;       /* the registation element e.g. Device.WiFi.AccessPoint.{i}.AssociatedDevice.{i}.SignalStrength */
     rtList instances;           /* the instance elements e.g.   Device.WiFi.AccessPoint.1.AssociatedDevice.1.SignalStrength
                                                                 Device.WiFi.AccessPoint.1.AssociatedDevice.2.SignalStrength
                                                                 Device.WiFi.AccessPoint.2.AssociatedDevice.1.SignalStrength */
+    uint8_t* trailer;           /* serialized filter and componentId which end every event message published to the subscriber */
+    uint32_t trailerLength;
+    rbusHashLink keyLink;       /* hashed by [listener, componentId, eventName], in the key index */
+    rbusHashLink listenerLink;  /* hashed by listener, in the listener index */
+    rbusHashLink patternLink;   /* hashed by the registration node of element, used to match new table rows */
+    rtListItem listItem;        /* this subscription's item in the registry's ordered list */
 } rbusSubscription_t;
 
 /*create a new subscriptions registry for an rbus handle*/
@@ -54,8 +64,13 @@ void rbusSubscriptions_create(rbusSubscriptions_t* subscriptions, rbusHandle_t h
 /*destroy a subscriptions registry*/
 void rbusSubscriptions_destroy(rbusSubscriptions_t subscriptions);
 
+/*lock the registry, and the subscriptions in it, against other threads.  the lock is recursive.
+  hold it across getting a subscription and using or removing it*/
+void rbusSubscriptions_lock(rbusSubscriptions_t subscriptions);
+void rbusSubscriptions_unlock(rbusSubscriptions_t subscriptions);
+
 /*add a new subscription with unique key [listener, eventName, filter] and the corresponding*/
-rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter, int32_t interval, int32_t duration, bool autoPublish, elementNode* registryElem);
+rbusSubscription_t* rbusSubscriptions_addSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter, int32_t interval, int32_t duration, bool autoPublish, int32_t version, elementNode* registryElem);
 
 /*get an existing subscription by searching for its unique key [listener, eventName, filter]*/
 rbusSubscription_t* rbusSubscriptions_getSubscription(rbusSubscriptions_t subscriptions, char const* listener, char const* eventName, int32_t componentId, rbusFilter_t filter);
@@ -69,8 +84,15 @@ void rbusSubscriptions_onTableRowAdded(rbusSubscriptions_t subscriptions, elemen
 /*call right before an existing row is delete*/
 void rbusSubscriptions_onTableRowRemoved(rbusSubscriptions_t subscriptions, elementNode* node);
 
-/*call when registering an event data element to resubscribe any listeners that might have been loaded from cache*/
-void rbusSubscriptions_resubscribeCache(rbusHandle_t handle, rbusSubscriptions_t subscriptions, char const* elementName, elementNode* el);
+/*call right after rows of the same table are added by instantiateTableRows. NULL rows are skipped*/
+void rbusSubscriptions_onTableRowsAdded(rbusSubscriptions_t subscriptions, elementNode** rows, int numRows);
+
+/*call right before rows are deleted by deleteTableRows. NULL rows are skipped*/
+void rbusSubscriptions_onTableRowsRemoved(rbusSubscriptions_t subscriptions, elementNode** rows, int numRows);
+
+/*call after registering data elements to resubscribe any listeners that might have been loaded from cache.
+  nodes[i] is the element inserted for elements[i]*/
+void rbusSubscriptions_resubscribeCache(rbusHandle_t handle, rbusSubscriptions_t subscriptions, int numElements, rbusDataElement_t* elements, elementNode** nodes);
 
 /*unsubscribe any client when they disconnect from broker. handles cases where clients don't unsubscribe properly (e.g. because they crashed)*/
 void rbusSubscriptions_handleClientDisconnect(rbusHandle_t handle, rbusSubscriptions_t subscriptions, char const* listener);
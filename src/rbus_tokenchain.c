@@ -18,6 +18,7 @@
 */
 
 #include "rbus_tokenchain.h"
+#include "rbus_atom.h"
 #include <rtMemory.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -162,7 +163,7 @@ TokenChain* TokenChain_create(char const* sourceName, elementNode* regNode)
 
                 tok->text++; /* move past [ to record just the alias */
 
-                p = tok->text + 1;
+                p = (char*)tok->text + 1;
 
                 while(*p != ']' && (p - name) < nameLen)
                 {
@@ -216,6 +217,13 @@ TokenChain* TokenChain_create(char const* sourceName, elementNode* regNode)
     }
 
     chain->first = next;
+
+    /*intern the token text so matching compares it to element names and aliases by pointer*/
+    for(next = chain->first; next; next = next->next)
+    {
+        next->text = rbusAtom_Intern(next->text, strlen(next->text));
+    }
+    free(name);
     return chain;
 
 tokenChainError:
@@ -237,30 +245,21 @@ void TokenChain_destroy(TokenChain* chain)
     if(!chain)
         return;
     Token* token = chain->first;
-    if(token)
-        free(token->text);
     while(token)
     {
         Token* next = token->next;
+        rbusAtom_Release(token->text);
         free(token);
         token = next;
     }
     free(chain);
 }
 
-bool TokenChain_match(TokenChain* chain, elementNode* instNode)
+static bool TokenChain_matchFrom(Token* token, elementNode* instNode)
 {
-    if((!chain)||(!instNode))
-        return false;
-    Token* token = chain->last;
     elementNode* inst = instNode;
     int rc;
 
-#   if DEBUG_TOKEN
-    RBUSLOG_INFO("%s DEBUG: instNode=%s tokenChain=", __FUNCTION__, instNode->fullName);
-    TokenChain_print(chain);
-#   endif
-
     while(token && inst && inst->parent != NULL)
     {
 #       if DEBUG_TOKEN
@@ -293,7 +292,7 @@ bool TokenChain_match(TokenChain* chain, elementNode* instNode)
 
             if(token->type == TokenInstNum)
             {
-                rc = strcmp(inst->name, token->text);
+                rc = inst->name != token->text;
 
 #               if DEBUG_TOKEN
                 RBUSLOG_INFO("%s DEBUG: instance numbers %s and %s %s", __FUNCTION__, inst->name, token->text, rc==0 ? "match" : "don't match");
@@ -306,7 +305,7 @@ bool TokenChain_match(TokenChain* chain, elementNode* instNode)
             }
             else if(token->type == TokenAlias)
             {
-                rc = strcmp(inst->alias, token->text);
+                rc = inst->alias != token->text;
 
 #               if DEBUG_TOKEN
                 RBUSLOG_INFO("%s DEBUG: aliases %s and %s %s", __FUNCTION__, inst->alias, token->text, rc==0 ? "match" : "don't match");
@@ -324,7 +323,7 @@ bool TokenChain_match(TokenChain* chain, elementNode* instNode)
         }
         else
         {
-            rc = strcmp(inst->name, token->text);
+            rc = inst->name != token->text;
 
 #           if DEBUG_TOKEN
             RBUSLOG_INFO("%s DEBUG: instance numbers %s and %s %s", __FUNCTION__, inst->name, token->text, rc==0 ? "match" : "don't match");
@@ -356,6 +355,38 @@ bool TokenChain_match(TokenChain* chain, elementNode* instNode)
     return true;
 }
 
+bool TokenChain_match(TokenChain* chain, elementNode* instNode)
+{
+    if((!chain)||(!instNode))
+        return false;
+
+#   if DEBUG_TOKEN
+    RBUSLOG_INFO("%s DEBUG: instNode=%s tokenChain=", __FUNCTION__, instNode->fullName);
+    TokenChain_print(chain);
+#   endif
+
+    return TokenChain_matchFrom(chain->last, instNode);
+}
+
+bool TokenChain_matchPrefix(TokenChain* chain, elementNode* instNode)
+{
+    Token* token;
+    elementNode* inst;
+
+    if((!chain)||(!instNode))
+        return false;
+
+    /*the first token is for the node under the root, so step down one token per level below that*/
+    token = chain->first;
+    for(inst = instNode; token && inst->parent && inst->parent->parent; inst = inst->parent)
+        token = token->next;
+
+    if(!token)
+        return false;
+
+    return TokenChain_matchFrom(token, instNode);
+}
+
 #if DEBUG_TOKEN
 void TokenChain_print(TokenChain* chain)
 {
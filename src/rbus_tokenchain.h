@@ -36,7 +36,7 @@ typedef enum TokenType
 
 typedef struct Token
 {
-    char* text;         /* text of token. e.g. the 'WiFi' in 'Device.WiFi.Radio.1' */
+    char const* text;   /* text of token, an atom. e.g. the 'WiFi' in 'Device.WiFi.Radio.1' */
     elementNode* node;  /* the corresponding registration node in the element tree */
     TokenType type;     /* type of expression used to identify a row instance*/
     struct Token* prev; /* the previous token in list */
@@ -55,6 +55,10 @@ void TokenChain_destroy(TokenChain* chain);
 
 bool TokenChain_match(TokenChain* chain, elementNode* instNode);
 
+/*like TokenChain_match but only matches the leading tokens down to the depth of instNode,
+  telling whether anything under instNode could match the chain*/
+bool TokenChain_matchPrefix(TokenChain* chain, elementNode* instNode);
+
 void TokenChain_print(TokenChain* chain);
 
 #ifdef __cplusplus
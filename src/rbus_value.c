@@ -35,6 +35,7 @@
 #include <limits.h>
 #include <rtMemory.h>
 #include "rbus_buffer.h"
+#include "rbus_pool.h"
 #include "rbus_log.h"
 
 #define VERIFY_NULL(T)      if(NULL == T){ return; }
@@ -64,8 +65,21 @@ struct _rbusValue
         struct  _rbusObject*    object;
     } d;
     rbusValueType_t type;
+    bool view;  /*allocated by rbusValue_InitView as an rbusValueView rather than from the pool*/
 };
 
+/*a string or bytes value created by rbusValue_InitView*/
+typedef struct _rbusValueView
+{
+    struct _rbusValue   value;
+    struct _rbusBuffer  buffer;
+    void*               owner;
+    void                (*release)(void* owner);
+} rbusValueView;
+
+/*true while d.bytes references memory held by the view's owner*/
+#define VALUE_IS_VIEWING(V) ((V)->view && (V)->d.bytes == &((rbusValueView*)(V))->buffer)
+
 char const* rbusValueType_ToDebugString(rbusValueType_t type)
 {
     char const* s = NULL;
@@ -101,7 +115,16 @@ static void rbusValue_FreeInternal(rbusValue_t v)
 {
     if( (v->type == RBUS_STRING || v->type == RBUS_BYTES) && v->d.bytes )
     {
-        rbusBuffer_Destroy(v->d.bytes);
+        if(VALUE_IS_VIEWING(v))
+        {
+            rbusValueView* vv = (rbusValueView*)v;
+            vv->release(vv->owner);
+            vv->owner = NULL;
+        }
+        else
+        {
+            rbusBuffer_Destroy(v->d.bytes);
+        }
     }
     else if(v->type == RBUS_PROPERTY && v->d.property)
     {
@@ -118,7 +141,7 @@ static void rbusValue_FreeInternal(rbusValue_t v)
 
 rbusValue_t rbusValue_Init(rbusValue_t* pvalue)
 {
-    rbusValue_t v = rt_calloc(1, sizeof(struct _rbusValue));
+    rbusValue_t v = rbusPool_Alloc(RBUS_POOL_VALUE, sizeof(struct _rbusValue));
     v->retainable.refCount = 1;
     v->type = RBUS_NONE;
     if(pvalue)
@@ -126,6 +149,36 @@ rbusValue_t rbusValue_Init(rbusValue_t* pvalue)
     return v;
 }
 
+rbusValue_t rbusValue_InitView(rbusValueType_t type, uint8_t const* data, uint32_t length, rbusBufferOwner_t const* owner)
+{
+    rbusValueView* vv;
+
+    if(!data || !owner || length == 0 || length > INT_MAX)
+        return NULL;
+    if(type == RBUS_STRING)
+    {
+        /*GetString hands out data directly so it must be terminated at exactly length-1*/
+        if(memchr(data, 0, length) != data + length - 1)
+            return NULL;
+    }
+    else if(type != RBUS_BYTES)
+    {
+        return NULL;
+    }
+
+    vv = rt_calloc(1, sizeof(rbusValueView));
+    vv->value.retainable.refCount = 1;
+    vv->value.type = type;
+    vv->value.view = true;
+    vv->value.d.bytes = &vv->buffer;
+    vv->buffer.data = (uint8_t*)data;
+    vv->buffer.lenAlloc = vv->buffer.posWrite = (int)length;
+    vv->owner = owner->owner;
+    vv->release = owner->release;
+    owner->retain(owner->owner);
+    return &vv->value;
+}
+
 rbusValue_t rbusValue_InitString(char const* s)
 {
     rbusValue_t v;
@@ -167,7 +220,10 @@ void rbusValue_Destroy(rtRetainable* r)
     VERIFY_NULL(v);
     rbusValue_FreeInternal(v);
     v->type = RBUS_NONE;
-    free(v);
+    if(v->view)
+        free(v);
+    else
+        rbusPool_Free(RBUS_POOL_VALUE, v);
 }
 
 void rbusValue_Retain(rbusValue_t v)
@@ -533,6 +589,8 @@ void rbusValue_SetTime(rbusValue_t v, rbusDateTime_t const* tv)
 static void rbusValue_SetBufferData(rbusValue_t v, const void* data, int len, rbusValueType_t type)
 {
     VERIFY_NULL(v);
+    if(VALUE_IS_VIEWING(v))
+        rbusValue_FreeInternal(v);
     if((v->type == RBUS_STRING || v->type == RBUS_BYTES) && v->d.bytes)
     {
         assert(v->d.bytes->data);
@@ -668,17 +726,30 @@ int rbusValue_Decode(rbusValue_t* value, rbusBuffer_t const buff)
     uint16_t    length;
     rbusValue_t current;
 
-    rbusValue_Init(value);
-
     if(!value)
         return -1;
-    current = *value;
 
     // read value
-    rbusBuffer_ReadUInt16(buff, &type);
-    rbusBuffer_ReadUInt16(buff, &length);
-    if(!buff)
+    if(rbusBuffer_ReadUInt16(buff, &type) < 0 || rbusBuffer_ReadUInt16(buff, &length) < 0)
+    {
+        rbusValue_Init(value);
         return -1;
+    }
+
+    /*reference strings and bytes in place when the buffer is a view kept alive by an owner*/
+    if((type == RBUS_STRING || type == RBUS_BYTES) && buff->owner &&
+        buff->posRead + length <= buff->lenAlloc)
+    {
+        *value = rbusValue_InitView(type, buff->data + buff->posRead, length, buff->owner);
+        if(*value)
+        {
+            buff->posRead += length;
+            return length;
+        }
+    }
+
+    rbusValue_Init(value);
+    current = *value;
     current->type = type;
     switch(type)
     {
@@ -731,19 +802,50 @@ int rbusValue_Decode(rbusValue_t* value, rbusBuffer_t const buff)
         return rbusBuffer_ReadDouble(buff, &current->d.f64);
     case RBUS_DATETIME:
         return rbusBuffer_ReadDateTime(buff, &current->d.tv);
+    /* Property lists and objects follow their zero length type header */
+    case RBUS_PROPERTY:
+    {
+        rbusProperty_t prop = NULL;
+        if(rbusPropertyList_Decode(&prop, buff) < 0)
+        {
+            RBUSLOG_WARN("rbusValue_Decode failed");
+            return -1;
+        }
+        rbusValue_SetProperty(current, prop);
+        if(prop)
+            rbusProperty_Release(prop);
+        return 0;
+    }
+    case RBUS_OBJECT:
+    {
+        rbusObject_t obj = NULL;
+        if(rbusObject_Decode(&obj, buff) < 0)
+        {
+            RBUSLOG_WARN("rbusValue_Decode failed");
+            return -1;
+        }
+        rbusValue_SetObject(current, obj);
+        rbusObject_Release(obj);
+        return 0;
+    }
+    case RBUS_NONE:
+        return 0;
     default:
         assert(false);
         return -1;
     }
 }
 
-void rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff)
+int rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff)
 {
-    VERIFY_NULL(value);
+    if(!value)
+        return -1;
     // encode value
     switch(value->type)
     {
     case RBUS_STRING:/*length should include null term*/
+        if(value->d.bytes->posWrite > UINT16_MAX)
+            return -1;
         assert(value->d.bytes->data);
         assert(value->d.bytes->posWrite <= value->d.bytes->lenAlloc);
         assert(value->d.bytes->posRead == 0);
@@ -751,6 +853,8 @@ void rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff)
         rbusBuffer_WriteStringTLV(buff, (char const*)value->d.bytes->data, value->d.bytes->posWrite);
         break;
     case RBUS_BYTES:
+        if(value->d.bytes->posWrite > UINT16_MAX)
+            return -1;
         assert(value->d.bytes->data);
         assert(value->d.bytes->posWrite <= value->d.bytes->lenAlloc);
         assert(value->d.bytes->posRead == 0);
@@ -798,10 +902,21 @@ void rbusValue_Encode(rbusValue_t value, rbusBuffer_t buff)
     case RBUS_DATETIME:
         rbusBuffer_WriteDateTimeTLV(buff, &value->d.tv);
         break;
+    /* Property lists and objects are written as a zero length type header followed by their own encoding */
+    case RBUS_PROPERTY:
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_PROPERTY, 0, NULL);
+        return rbusPropertyList_Encode(value->d.property, buff);
+    case RBUS_OBJECT:
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_OBJECT, 0, NULL);
+        return rbusObject_Encode(value->d.object, buff);
+    case RBUS_NONE:
+        rbusBuffer_WriteTypeLengthValue(buff, RBUS_NONE, 0, NULL);
+        break;
     default:
         assert(false);
-        break;
+        return -1;
     }
+    return 0;
 }
 
 static double rbusValue_CoerceNumericToDouble(rbusValue_t v)
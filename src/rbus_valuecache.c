@@ -0,0 +1,519 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+    Value Cache:
+    An opt-in cache of the values a consumer gets with rbus_get and rbus_getExt.
+    Each value expires its ttl after it was got.  When the cache is coherent, caching a
+    property also subscribes to its value-change event.  Once the subscription is active,
+    a value got or updated by an event is kept until an event or an invalidation replaces
+    it, however long it stays the same.  A value got before then still expires, since a
+    change could have been missed while subscribing.
+    Values set through the same handle are dropped.  Each invalidation or event counts a
+    generation, and a get which was already in flight when one happened doesn't cache
+    its older value.  Entries are hashed by their name (see rbus_hash.h).
+
+    The value-change subscriptions are the cache's own.  They are made under a componentId
+    of their own and kept in the entries instead of the handle's eventSubs, so the app can
+    subscribe to and unsubscribe from the same events without noticing them.  While an entry's
+    subscription is pending the subscribe retrier owns it, and the entry only points at it so
+    the result can be matched to the entry.  Once active, the entry owns it.
+    When the cache is full, entries are evicted, subscribed or not, and their subscriptions removed.
+*/
+
+#include "rbus_valuecache.h"
+#include "rbus_log.h"
+#include "rbus_hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <rtMemory.h>
+#include <rtTime.h>
+#include <rtVector.h>
+
+#define VALUECACHE_MIN_BUCKETS 1024
+#define VALUECACHE_MAX_ENTRIES 4096
+#define VALUECACHE_EVICT_TO (VALUECACHE_MAX_ENTRIES - VALUECACHE_MAX_ENTRIES / 8)
+
+/*defined in rbus.c*/
+void rbusEvent_SubscribeForValueCache(rbusEventSubscription_t* sub);
+rbusError_t rbusEvent_UnsubscribeForValueCache(rbusEventSubscription_t* sub);
+void rbusEventSubscription_free(void* p);
+
+typedef enum _rbusValueCacheSubState
+{
+    VALUECACHE_SUB_NONE = 0,
+    VALUECACHE_SUB_PENDING,
+    VALUECACHE_SUB_ACTIVE,
+    VALUECACHE_SUB_FAILED
+} rbusValueCacheSubState;
+
+typedef struct _rbusValueCacheEntry
+{
+    rbusHashLink                    link;
+    char*                           name;
+    rbusValue_t                     value;      /* NULL once invalidated */
+    rtTime_t                        expires;
+    bool                            current;    /* value was set while the subscription was active, so doesn't expire */
+    uint64_t                        changed;    /* the generation of the last invalidation or event */
+    rbusValueCacheSubState          subState;   /* of the value-change subscription, when coherent */
+    rbusEventSubscription_t*        sub;        /* while PENDING or ACTIVE */
+} rbusValueCacheEntry;
+
+typedef struct _rbusValueCacheTTL
+{
+    char*       name;
+    size_t      len;
+    uint32_t    ttl;
+} rbusValueCacheTTL;
+
+struct _rbusValueCache
+{
+    rbusHandle_t            handle;
+    pthread_mutex_t         mutex;
+    uint32_t                ttl;        /* default ttl in miliseconds, 0 when the cache is off */
+    bool                    coherent;
+    rtVector                ttls;       /* rbusValueCacheTTL matched by longest name prefix */
+    rbusHashTable           entries;
+    uint32_t                evictBucket;/* where the next eviction starts */
+    uint64_t                generation; /* counts invalidations and events */
+    uint64_t                missChanged;/* the generation of the last invalidation of a name without an entry */
+};
+
+static rbusValueCacheEntry* findEntry(rbusValueCache_t cache, char const* name, uint32_t hash)
+{
+    rbusHashLink* link;
+    for(link = rbusHashTable_Find(&cache->entries, hash); link; link = rbusHashTable_FindNext(link))
+    {
+        rbusValueCacheEntry* entry = rbusHashTable_Entry(link, rbusValueCacheEntry, link);
+        if(!strcmp(entry->name, name))
+            return entry;
+    }
+    return NULL;
+}
+
+/*drop the entry's subscription: an active one is added to unsubs to be removed once the lock is
+  released, while a pending one is left to valueCache_subscribeHandler, which won't match it anymore*/
+static void dropSubscription(rbusValueCacheEntry* entry, rtVector unsubs)
+{
+    if(entry->subState == VALUECACHE_SUB_ACTIVE)
+        rtVector_PushBack(unsubs, entry->sub);
+    entry->sub = NULL;
+    entry->subState = VALUECACHE_SUB_NONE;
+}
+
+static void freeEntry(rbusValueCacheEntry* entry, rtVector unsubs)
+{
+    dropSubscription(entry, unsubs);
+    if(entry->value)
+        rbusValue_Release(entry->value);
+    free(entry->name);
+    free(entry);
+}
+
+/*called without the lock*/
+static void removeSubscriptions(rtVector unsubs)
+{
+    size_t i, n = rtVector_Size(unsubs);
+    for(i = 0; i < n; ++i)
+    {
+        rbusEventSubscription_t* sub = rtVector_At(unsubs, i);
+        rbusEvent_UnsubscribeForValueCache(sub);
+        rbusEventSubscription_free(sub);
+    }
+    rtVector_Destroy(unsubs, NULL);
+}
+
+static void freeTTL(void* p)
+{
+    rbusValueCacheTTL* ttl = p;
+    free(ttl->name);
+    free(ttl);
+}
+
+static rbusValue_t copyValue(rbusValue_t value)
+{
+    rbusValue_t copy;
+    rbusValue_Init(&copy);
+    rbusValue_Copy(copy, value);
+    return copy;
+}
+
+static void setValue(rbusValueCacheEntry* entry, rbusValue_t value, uint32_t ttl)
+{
+    if(entry->value)
+        rbusValue_Release(entry->value);
+    entry->value = copyValue(value);
+    entry->current = entry->subState == VALUECACHE_SUB_ACTIVE;
+    rtTime_Later(NULL, (int)ttl, &entry->expires);
+}
+
+/*the ttl of name: the longest prefix with its own ttl, or the default*/
+static uint32_t getTTL(rbusValueCache_t cache, char const* name)
+{
+    size_t i, n = rtVector_Size(cache->ttls);
+    size_t bestLen = 0;
+    uint32_t ttl = cache->ttl;
+
+    for(i = 0; i < n; ++i)
+    {
+        rbusValueCacheTTL* it = rtVector_At(cache->ttls, i);
+        if(it->len > bestLen && strncmp(name, it->name, it->len) == 0 &&
+           (it->name[it->len-1] == '.' || name[it->len] == '\0' || name[it->len] == '.'))
+        {
+            bestLen = it->len;
+            ttl = it->ttl;
+        }
+    }
+    return ttl;
+}
+
+/*drop entries without a value or past their ttl, except those with a value-change subscription to keep track of*/
+static void sweepEntries(rbusValueCache_t cache)
+{
+    rtTime_t now;
+    uint32_t b;
+
+    rtTime_Now(&now);
+    for(b = 0; b < cache->entries.numBuckets; ++b)
+    {
+        rbusHashLink* link = cache->entries.buckets[b];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            rbusValueCacheEntry* entry = rbusHashTable_Entry(link, rbusValueCacheEntry, link);
+            if((entry->subState == VALUECACHE_SUB_NONE || entry->subState == VALUECACHE_SUB_FAILED) &&
+               (!entry->value || rtTime_Compare(&now, &entry->expires) >= 0))
+            {
+                rbusHashTable_Remove(&cache->entries, link);
+                freeEntry(entry, NULL);
+            }
+            link = next;
+        }
+    }
+}
+
+/*when sweeping isn't enough, as when every entry is subscribed, evict whole buckets, going round
+  the buckets from where the last eviction stopped, until an eighth of the cache is free*/
+static void evictEntries(rbusValueCache_t cache, rtVector unsubs)
+{
+    while(cache->entries.numEntries > VALUECACHE_EVICT_TO)
+    {
+        uint32_t b = cache->evictBucket & (cache->entries.numBuckets - 1);
+        cache->evictBucket = b + 1;
+        while(cache->entries.buckets[b])
+        {
+            rbusHashLink* link = cache->entries.buckets[b];
+            rbusHashTable_Remove(&cache->entries, link);
+            freeEntry(rbusHashTable_Entry(link, rbusValueCacheEntry, link), unsubs);
+        }
+    }
+}
+
+void rbusValueCache_Update(rbusValueCache_t cache, rbusEvent_t const* event)
+{
+    rbusValueCacheEntry* entry;
+    rbusValue_t value;
+
+    if(event->type != RBUS_EVENT_VALUE_CHANGED || !event->data)
+        return;
+
+    value = rbusObject_GetValue(event->data, "value");
+    if(!value)
+        return;
+
+    pthread_mutex_lock(&cache->mutex);
+    entry = findEntry(cache, event->name, rbusHash_String(event->name));
+    if(entry && cache->ttl)
+    {
+        setValue(entry, value, getTTL(cache, entry->name));
+        /*newer than any get in flight*/
+        entry->changed = ++cache->generation;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+static void valueCache_eventHandler(rbusHandle_t handle, rbusEvent_t const* event, rbusEventSubscription_t* subscription)
+{
+    (void)handle;
+    rbusValueCache_Update(subscription->userData, event);
+}
+
+static void valueCache_subscribeHandler(rbusHandle_t handle, rbusEventSubscription_t* subscription, rbusError_t error)
+{
+    rbusValueCache_t cache = subscription->userData;
+    rbusValueCacheEntry* entry;
+    bool keep = false;
+
+    (void)handle;
+
+    if(error != RBUS_ERROR_SUCCESS)
+        RBUSLOG_INFO("%s: %s won't be kept coherent; subscribe error %d", __FUNCTION__, subscription->eventName, error);
+
+    pthread_mutex_lock(&cache->mutex);
+    entry = findEntry(cache, subscription->eventName, rbusHash_String(subscription->eventName));
+    if(entry && entry->sub == subscription && entry->subState == VALUECACHE_SUB_PENDING)
+    {
+        if(error == RBUS_ERROR_SUCCESS)
+        {
+            entry->subState = VALUECACHE_SUB_ACTIVE;
+            keep = true;
+        }
+        else
+        {
+            entry->subState = VALUECACHE_SUB_FAILED;
+            entry->sub = NULL;
+        }
+    }
+    pthread_mutex_unlock(&cache->mutex);
+
+    if(keep)
+        return;
+
+    /*failed, or the entry was dropped while this was pending*/
+    if(error == RBUS_ERROR_SUCCESS)
+        rbusEvent_UnsubscribeForValueCache(subscription);
+    rbusEventSubscription_free(subscription);
+}
+
+void rbusValueCache_Create(rbusValueCache_t* cache, rbusHandle_t handle)
+{
+    (*cache) = rt_calloc(1, sizeof(struct _rbusValueCache));
+    (*cache)->handle = handle;
+    pthread_mutex_init(&(*cache)->mutex, NULL);
+    rtVector_Create(&(*cache)->ttls);
+    rbusHashTable_Init(&(*cache)->entries, VALUECACHE_MIN_BUCKETS);
+}
+
+static void clearEntries(rbusValueCache_t cache, rtVector unsubs)
+{
+    uint32_t b;
+    for(b = 0; b < cache->entries.numBuckets; ++b)
+    {
+        rbusHashLink* link = cache->entries.buckets[b];
+        while(link)
+        {
+            rbusHashLink* next = link->next;
+            freeEntry(rbusHashTable_Entry(link, rbusValueCacheEntry, link), unsubs);
+            link = next;
+        }
+    }
+    rbusHashTable_Clear(&cache->entries);
+}
+
+void rbusValueCache_Destroy(rbusValueCache_t cache)
+{
+    rtVector unsubs;
+
+    if(!cache)
+        return;
+    rtVector_Create(&unsubs);
+    clearEntries(cache, unsubs);
+    removeSubscriptions(unsubs);
+    rtVector_Destroy(cache->ttls, freeTTL);
+    pthread_mutex_destroy(&cache->mutex);
+    free(cache);
+}
+
+void rbusValueCache_SetOptions(rbusValueCache_t cache, uint32_t ttl, bool coherent)
+{
+    rtVector unsubs;
+    uint32_t b;
+
+    rtVector_Create(&unsubs);
+
+    pthread_mutex_lock(&cache->mutex);
+
+    if(ttl == 0)
+    {
+        clearEntries(cache, unsubs);
+    }
+    else
+    {
+        for(b = 0; b < cache->entries.numBuckets; ++b)
+        {
+            rbusHashLink* link;
+            for(link = cache->entries.buckets[b]; link; link = link->next)
+            {
+                rbusValueCacheEntry* entry = rbusHashTable_Entry(link, rbusValueCacheEntry, link);
+                if(!coherent)
+                    dropSubscription(entry, unsubs);
+                /*drop the values cached with the old ttl*/
+                if(ttl != cache->ttl && entry->value)
+                {
+                    rbusValue_Release(entry->value);
+                    entry->value = NULL;
+                }
+            }
+        }
+    }
+    cache->ttl = ttl;
+    cache->coherent = coherent;
+
+    pthread_mutex_unlock(&cache->mutex);
+
+    removeSubscriptions(unsubs);
+}
+
+void rbusValueCache_SetTTL(rbusValueCache_t cache, char const* name, uint32_t ttl)
+{
+    size_t i, n;
+    size_t len = strlen(name);
+    rbusValueCacheTTL* it = NULL;
+
+    pthread_mutex_lock(&cache->mutex);
+
+    n = rtVector_Size(cache->ttls);
+    for(i = 0; i < n; ++i)
+    {
+        rbusValueCacheTTL* t = rtVector_At(cache->ttls, i);
+        if(t->len == len && !strcmp(t->name, name))
+        {
+            it = t;
+            break;
+        }
+    }
+    if(!it)
+    {
+        it = rt_malloc(sizeof(rbusValueCacheTTL));
+        it->name = strdup(name);
+        it->len = len;
+        rtVector_PushBack(cache->ttls, it);
+    }
+    it->ttl = ttl;
+
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+rbusValue_t rbusValueCache_Get(rbusValueCache_t cache, char const* name)
+{
+    rbusValueCacheEntry* entry;
+    rbusValue_t value = NULL;
+    rtTime_t now;
+
+    pthread_mutex_lock(&cache->mutex);
+    if(cache->ttl)
+    {
+        entry = findEntry(cache, name, rbusHash_String(name));
+        if(entry && entry->value &&
+           ((entry->subState == VALUECACHE_SUB_ACTIVE && entry->current) || rtTime_Compare(rtTime_Now(&now), &entry->expires) < 0))
+            value = copyValue(entry->value);
+    }
+    pthread_mutex_unlock(&cache->mutex);
+
+    return value;
+}
+
+uint64_t rbusValueCache_GetGeneration(rbusValueCache_t cache)
+{
+    uint64_t generation;
+
+    pthread_mutex_lock(&cache->mutex);
+    generation = cache->generation;
+    pthread_mutex_unlock(&cache->mutex);
+    return generation;
+}
+
+void rbusValueCache_Put(rbusValueCache_t cache, char const* name, rbusValue_t value, uint64_t generation)
+{
+    rbusValueCacheEntry* entry;
+    rbusEventSubscription_t* sub = NULL;
+    rtVector unsubs;
+    uint32_t hash, ttl;
+
+    if(!value)
+        return;
+
+    rtVector_Create(&unsubs);
+
+    pthread_mutex_lock(&cache->mutex);
+
+    if(cache->ttl == 0 || (ttl = getTTL(cache, name)) == 0)
+    {
+        pthread_mutex_unlock(&cache->mutex);
+        rtVector_Destroy(unsubs, NULL);
+        return;
+    }
+
+    hash = rbusHash_String(name);
+    entry = findEntry(cache, name, hash);
+
+    /*invalidated or updated since the get was made*/
+    if((entry ? entry->changed : cache->missChanged) > generation)
+    {
+        pthread_mutex_unlock(&cache->mutex);
+        rtVector_Destroy(unsubs, NULL);
+        return;
+    }
+
+    if(!entry)
+    {
+        if(cache->entries.numEntries >= VALUECACHE_MAX_ENTRIES)
+            sweepEntries(cache);
+        if(cache->entries.numEntries >= VALUECACHE_MAX_ENTRIES)
+            evictEntries(cache, unsubs);
+
+        entry = rt_calloc(1, sizeof(rbusValueCacheEntry));
+        entry->name = strdup(name);
+        rbusHashTable_Insert(&cache->entries, &entry->link, hash);
+    }
+
+    setValue(entry, value, ttl);
+
+    if(cache->coherent && entry->subState == VALUECACHE_SUB_NONE)
+    {
+        sub = rt_calloc(1, sizeof(rbusEventSubscription_t));
+        sub->handle = cache->handle;
+        sub->eventName = strdup(name);
+        sub->handler = valueCache_eventHandler;
+        sub->userData = cache;
+        sub->asyncHandler = valueCache_subscribeHandler;
+        entry->sub = sub;
+        entry->subState = VALUECACHE_SUB_PENDING;
+    }
+
+    pthread_mutex_unlock(&cache->mutex);
+
+    removeSubscriptions(unsubs);
+
+    if(sub)
+        rbusEvent_SubscribeForValueCache(sub);
+}
+
+void rbusValueCache_Invalidate(rbusValueCache_t cache, char const* name)
+{
+    rbusValueCacheEntry* entry;
+
+    pthread_mutex_lock(&cache->mutex);
+    entry = findEntry(cache, name, rbusHash_String(name));
+    if(entry)
+    {
+        if(entry->value)
+        {
+            rbusValue_Release(entry->value);
+            entry->value = NULL;
+        }
+        entry->changed = ++cache->generation;
+    }
+    else
+    {
+        cache->missChanged = ++cache->generation;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+}
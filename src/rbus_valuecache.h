@@ -0,0 +1,65 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2019 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef RBUS_VALUECACHE_H
+#define RBUS_VALUECACHE_H
+
+#include <rbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*a consumer's cache of the values it gets, see rbusHandle_ConfigValueCache*/
+typedef struct _rbusValueCache *rbusValueCache_t;
+
+void rbusValueCache_Create(rbusValueCache_t* cache, rbusHandle_t handle);
+
+/*destroy the cache and remove its active value-change subscriptions.  pending ones must have been
+  dropped with rbusAsyncSubscribe_CloseHandle first*/
+void rbusValueCache_Destroy(rbusValueCache_t cache);
+
+/*change the options.  a ttl of 0 turns the cache off, dropping every entry.
+  turning coherent off unsubscribes from the value-change events of the entries*/
+void rbusValueCache_SetOptions(rbusValueCache_t cache, uint32_t ttl, bool coherent);
+
+/*set the ttl of the values of every element whose name starts with name.  a ttl of 0 stops them being cached*/
+void rbusValueCache_SetTTL(rbusValueCache_t cache, char const* name, uint32_t ttl);
+
+/*a copy of the cached value of name, or NULL if it isn't cached or has expired.
+  a value kept coherent by an active subscription doesn't expire*/
+rbusValue_t rbusValueCache_Get(rbusValueCache_t cache, char const* name);
+
+/*the current generation, to pass to rbusValueCache_Put with the value got after a cache miss*/
+uint64_t rbusValueCache_GetGeneration(rbusValueCache_t cache);
+
+/*cache a copy of the value of name, got by a request made at generation.  it isn't cached
+  if name was invalidated or updated by an event since*/
+void rbusValueCache_Put(rbusValueCache_t cache, char const* name, rbusValue_t value, uint64_t generation);
+
+/*update the cached value from a value-change event of one of the cache's subscriptions*/
+void rbusValueCache_Update(rbusValueCache_t cache, rbusEvent_t const* event);
+
+/*drop the cached value of name, such as after setting it*/
+void rbusValueCache_Invalidate(rbusValueCache_t cache, char const* name);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
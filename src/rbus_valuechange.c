@@ -22,12 +22,17 @@
     Simple API that allows you to add/remove parameters you wish to check value-change for.
     Uses a single thread to poll parameter values across all rbus handles.
     The thread is started on first param added and stopped on last param removed.
-    A poling period (default 30 seconds) helps to limit the cpu usage.
+    Each param has its own polling period: the smallest interval its subscribers asked for or,
+    if none did, the configured valueChangePeriod.  Params are kept in a min-heap ordered by
+    when they are next due (see rbus_heap.h), so the thread only wakes up when something is due and only gets
+    the params which are due.
     Runs in the provider process, so the value are got with direct callbacks and not over the network.
     The technique is simple:
     1) when a param is added, get and cache its current value.
-    2) on a background thread, periodically get the latest value and compare to cached value.
+    2) on a background thread, get the latest value when the param is due and compare to cached value.
     3) if the value has change, publish an event.
+    Providers which know when their values change can call rbusEvent_NotifyValueChanged to have
+    a param checked right away, and can turn polling off for it with rbusEvent_SetValueChangePolling.
 */
 
 #define _GNU_SOURCE 1 //needed for pthread_mutexattr_settype
@@ -35,6 +40,7 @@
 #include "rbus_valuechange.h"
 #include "rbus_config.h"
 #include "rbus_handle.h"
+#include "rbus_heap.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -58,21 +64,31 @@
 #define LOCK() ERROR_CHECK(pthread_mutex_lock(&gVC->mutex))
 #define UNLOCK() ERROR_CHECK(pthread_mutex_unlock(&gVC->mutex))
 
+typedef struct ValueChangeRecord ValueChangeRecord;
+
 typedef struct ValueChangeDetector_t
 {
-    int              running;
-    rtVector         params;
-    pthread_mutex_t  mutex;
-    pthread_t        thread;
-    pthread_cond_t   cond;
+    int                  running;
+    rtVector             params;
+    rbusHeap             schedule;      //params which are scheduled, ordered by when they are next polled
+    unsigned int         pollCount;     //incremented each time the polling thread finishes a batch
+    pthread_mutex_t      mutex;
+    pthread_t            thread;
+    pthread_cond_t       cond;
+    pthread_cond_t       doneCond;      //signaled each time the polling thread finishes a batch
 } ValueChangeDetector_t;
 
-typedef struct ValueChangeRecord
+struct ValueChangeRecord
 {
     rbusHandle_t handle;    //needed when calling rbus_getHandler and rbusEvent_Publish
     elementNode const* node;    //used to call the rbus_getHandler is contains
     rbusProperty_t property;    //the parameter with value that gets cached
-} ValueChangeRecord;
+    int period;                 //polling period in milliseconds
+    rbusHeapLink schedule;      //when the param is due to be polled next
+    bool dirty;                 //provider notified a change while the param was being polled
+    bool busy;                  //the polling thread is getting/publishing the param outside the lock
+    bool removed;               //the param was removed while busy, the polling thread will free it
+};
 
 ValueChangeDetector_t* gVC = NULL;
 
@@ -90,6 +106,8 @@ static void rbusValueChange_Init()
 
     gVC->running = 0;
     gVC->params = NULL;
+    rbusHeap_Init(&gVC->schedule);
+    gVC->pollCount = 0;
 
     rtVector_Create(&gVC->params);
 
@@ -100,6 +118,7 @@ static void rbusValueChange_Init()
     ERROR_CHECK(pthread_condattr_init(&cattrib));
     ERROR_CHECK(pthread_condattr_setclock(&cattrib, CLOCK_MONOTONIC));
     ERROR_CHECK(pthread_cond_init(&gVC->cond, &cattrib));
+    ERROR_CHECK(pthread_cond_init(&gVC->doneCond, &cattrib));
     ERROR_CHECK(pthread_condattr_destroy(&cattrib));
 }
 
@@ -124,27 +143,176 @@ static ValueChangeRecord* vcParams_Find(const elementNode* paramNode)
     return NULL;
 }
 
+/*convert a subscription interval in seconds to a polling period in milliseconds*/
+static int vcParams_Period(int32_t interval)
+{
+    if(interval > 0)
+        return interval * 1000;
+    return rbusConfig_Get()->valueChangePeriod;
+}
+
+/*schedule the next poll of rec after it was polled or added*/
+static void vcParams_ScheduleNext(ValueChangeRecord* rec)
+{
+    if(rec->dirty)
+    {
+        rec->dirty = false;
+        rtTime_Now(&rec->schedule.due);
+    }
+    else if(rec->node->valueChangeNotify)
+    {
+        /*provider tells us when it changes so don't poll*/
+        rbusHeap_Remove(&gVC->schedule, &rec->schedule);
+        return;
+    }
+    else
+    {
+        rtTime_Later(NULL, rec->period, &rec->schedule.due);
+    }
+    rbusHeap_Schedule(&gVC->schedule, &rec->schedule);
+}
+
+/*unlink rec and free it, or if the polling thread is using it, have the polling thread free it.
+  must be called with the lock held*/
+static void vcParams_Remove(ValueChangeRecord* rec)
+{
+    rtVector_RemoveItem(gVC->params, rec, NULL);
+    rbusHeap_Remove(&gVC->schedule, &rec->schedule);
+    if(rec->busy)
+    {
+        rec->removed = true;
+        /*unless this is a getHandler/publish on the polling thread itself, wait for the thread to finish
+          with rec so the caller can safely free the node afterwards.  rec is freed by then so don't touch it*/
+        if(!pthread_equal(pthread_self(), gVC->thread))
+        {
+            unsigned int pollCount = gVC->pollCount;
+            while(gVC->pollCount == pollCount)
+                ERROR_CHECK(pthread_cond_wait(&gVC->doneCond, &gVC->mutex));
+        }
+    }
+    else
+    {
+        vcParams_Free(rec);
+    }
+}
+
+/*get the current value of a param and publish a value-change event if it changed.
+  called without the lock held*/
+static void vcParams_Poll(ValueChangeRecord* rec)
+{
+    rbusProperty_t property;
+    rbusValue_t newVal, oldVal;
+
+    rbusProperty_Init(&property,rbusProperty_GetName(rec->property), NULL);
+
+    rbusGetHandlerOptions_t opts;
+    memset(&opts, 0, sizeof(rbusGetHandlerOptions_t));
+    opts.requestingComponent = "valueChangePollThread";
+
+    int result = rec->node->cbTable.getHandler(rec->handle, property, &opts);
+
+    if(result != RBUS_ERROR_SUCCESS)
+    {
+        RBUSLOG_WARN("%s: failed to get current value of %s", __FUNCTION__, rbusProperty_GetName(property));
+        rbusProperty_Release(property);
+        return;
+    }
+
+    char* sValue = rbusValue_ToString(rbusProperty_GetValue(property), NULL, 0);
+    RBUSLOG_DEBUG("%s: %s=%s", __FUNCTION__, rbusProperty_GetName(property), sValue);
+    free(sValue);
+
+    newVal = rbusProperty_GetValue(property);
+    oldVal = rbusProperty_GetValue(rec->property);
+
+    if(rbusValue_Compare(newVal, oldVal))
+    {
+        rbusEvent_t event = {0};
+        rbusObject_t data;
+        rbusValue_t byVal = NULL;
+
+        RBUSLOG_INFO("%s: value change detected for %s", __FUNCTION__, rbusProperty_GetName(rec->property));
+
+        /* The "by" field is set to the component's name which made the last value change.
+           The source of a value-change could be an external component calling rbus_set or the provider internally updating
+           the value.  changeComp/changeTime are updated through the rbus_set path, but not through the provider internal path.
+           We must deduce if the provider has updated the value and reflect that change to the changeComp/changeTime, right here.
+           If we don't have a changeComp or we do but the changeTime is older then the param's polling period,
+           then we know it was the provider who updated the value we are now detecting.
+        */
+        if(rec->node->changeComp == NULL || 
+           (rtTime_Elapsed(&rec->node->changeTime, NULL) >= rec->period &&
+           strcmp(rec->handle->componentName, rec->node->changeComp) == 0))
+        {
+            RBUSLOG_DEBUG("VC detected provider-side value-change oldcomp=%s elapsed=%d period=%d", rec->node->changeComp, rtTime_Elapsed(&rec->node->changeTime, NULL), rec->period);
+            setPropertyChangeComponent((elementNode*)rec->node, rec->handle->componentName);
+        }
+
+        rbusObject_Init(&data, NULL);
+        rbusObject_SetValue(data, "value", newVal);
+        rbusObject_SetValue(data, "oldValue", oldVal);
+
+        rbusValue_Init(&byVal);
+        rbusValue_SetString(byVal, rec->node->changeComp);
+        rbusObject_SetValue(data, "by", byVal);
+        rbusValue_Release(byVal);
+
+        event.name = rbusProperty_GetName(rec->property);
+        event.data = data;
+        event.type = RBUS_EVENT_VALUE_CHANGED;
+        result = rbusEvent_Publish(rec->handle, &event);
+
+        rbusObject_Release(data);
+
+        if(result != RBUS_ERROR_SUCCESS)
+        {
+            RBUSLOG_WARN("%s: rbusEvent_Publish failed with result=%d", __FUNCTION__, result);
+        }
+
+        /*update the record's property with new value*/
+        rbusProperty_SetValue(rec->property, rbusProperty_GetValue(property));
+        rbusProperty_Release(property);
+    }
+    else
+    {
+        RBUSLOG_DEBUG("%s: value change not detected for %s", __FUNCTION__, rbusProperty_GetName(rec->property));
+        rbusProperty_Release(property);
+    }
+}
+
 static void* rbusValueChange_pollingThreadFunc(void *userData)
 {
+    ValueChangeRecord** due = NULL;
+    size_t dueCapacity = 0;
+
     (void)(userData);
     RBUSLOG_DEBUG("%s: start", __FUNCTION__);
     LOCK();
     while(gVC->running)
     {
-        size_t i;
+        size_t i, numDue = 0;
         int err;
-        rtTime_t timeout;
+        rtTime_t timeout, now;
         rtTimespec_t ts;
+        rbusHeapLink* top;
 
-        rtTime_Later(NULL, rbusConfig_Get()->valueChangePeriod, &timeout);
-        
-        err = pthread_cond_timedwait(&gVC->cond, 
-                                    &gVC->mutex, 
-                                    rtTime_ToTimespec(&timeout, &ts));
+        /*sleep until the next param is due, or until woken because the schedule changed*/
+        if((top = rbusHeap_Top(&gVC->schedule)) != NULL)
+            timeout = top->due;
+        else
+            rtTime_Later(NULL, rbusConfig_Get()->valueChangePeriod, &timeout);
 
-        if(err != 0 && err != ETIMEDOUT)
+        rtTime_Now(&now);
+        if(rtTime_Compare(&now, &timeout) < 0)
         {
-            RBUSLOG_ERROR("Error %d:%s running command pthread_cond_timedwait", err, strerror(err));
+            err = pthread_cond_timedwait(&gVC->cond, 
+                                        &gVC->mutex, 
+                                        rtTime_ToTimespec(&timeout, &ts));
+
+            if(err != 0 && err != ETIMEDOUT)
+            {
+                RBUSLOG_ERROR("Error %d:%s running command pthread_cond_timedwait", err, strerror(err));
+            }
         }
         
         if(!gVC->running)
@@ -152,92 +320,52 @@ static void* rbusValueChange_pollingThreadFunc(void *userData)
             break;
         }
 
-        for(i=0; i < rtVector_Size(gVC->params); ++i)
+        /*take all the params that are due off the schedule*/
+        rtTime_Now(&now);
+        while((top = rbusHeap_Top(&gVC->schedule)) != NULL && rtTime_Compare(&top->due, &now) <= 0)
         {
-            rbusProperty_t property;
-            rbusValue_t newVal, oldVal;
-
-            ValueChangeRecord* rec = (ValueChangeRecord*)rtVector_At(gVC->params, i);
-            if(!rec)
-                continue;
-
-            rbusProperty_Init(&property,rbusProperty_GetName(rec->property), NULL);
-
-            rbusGetHandlerOptions_t opts;
-            memset(&opts, 0, sizeof(rbusGetHandlerOptions_t));
-            opts.requestingComponent = "valueChangePollThread";
-
-            int result = rec->node->cbTable.getHandler(rec->handle, property, &opts);
-
-            if(result != RBUS_ERROR_SUCCESS)
+            ValueChangeRecord* rec = rbusHeap_Entry(top, ValueChangeRecord, schedule);
+            rbusHeap_Remove(&gVC->schedule, &rec->schedule);
+            rec->busy = true;
+            if(numDue == dueCapacity)
             {
-                RBUSLOG_WARN("%s: failed to get current value of %s", __FUNCTION__, rbusProperty_GetName(property));
-                continue;
+                dueCapacity = dueCapacity ? dueCapacity * 2 : 16;
+                due = rt_realloc(due, dueCapacity * sizeof(ValueChangeRecord*));
             }
+            due[numDue++] = rec;
+        }
 
-            char* sValue = rbusValue_ToString(rbusProperty_GetValue(property), NULL, 0);
-            RBUSLOG_DEBUG("%s: %s=%s", __FUNCTION__, rbusProperty_GetName(property), sValue);
-            free(sValue);
+        if(numDue == 0)
+            continue;
 
-            newVal = rbusProperty_GetValue(property);
-            oldVal = rbusProperty_GetValue(rec->property);
+        /*getHandlers and publishing can be slow and can call back into rbus so don't hold the lock while doing them.
+          busy records can't be freed by other threads until this batch is done*/
+        UNLOCK();
+        for(i = 0; i < numDue; ++i)
+        {
+            bool removed;
+            LOCK();
+            removed = due[i]->removed;
+            UNLOCK();
+            if(!removed)
+                vcParams_Poll(due[i]);
+        }
+        LOCK();
 
-            if(rbusValue_Compare(newVal, oldVal))
-            {
-                rbusEvent_t event = {0};
-                rbusObject_t data;
-                rbusValue_t byVal = NULL;
-
-                RBUSLOG_INFO("%s: value change detected for %s", __FUNCTION__, rbusProperty_GetName(rec->property));
-
-                /* The "by" field is set to the component's name which made the last value change.
-                   The source of a value-change could be an external component calling rbus_set or the provider internally updating
-                   the value.  changeComp/changeTime are updated through the rbus_set path, but not through the provider internal path.
-                   We must deduce if the provider has updated the value and reflect that change to the changeComp/changeTime, right here.
-                   If we don't have a changeComp or we do but the changeTime is older then the current polling period,
-                   then we know it was the provider who updated the value we are now detecting.
-                */
-                if(rec->node->changeComp == NULL || 
-                   (rtTime_Elapsed(&rec->node->changeTime, NULL) >= rbusConfig_Get()->valueChangePeriod &&
-                   strcmp(rec->handle->componentName, rec->node->changeComp) == 0))
-                {
-                    printf("VC detected provider-side value-change oldcomp=%s elapsed=%d period=%d\n", rec->node->changeComp, rtTime_Elapsed(&rec->node->changeTime, NULL), rbusConfig_Get()->valueChangePeriod);
-                    setPropertyChangeComponent((elementNode*)rec->node, rec->handle->componentName);
-                }
-
-                rbusObject_Init(&data, NULL);
-                rbusObject_SetValue(data, "value", newVal);
-                rbusObject_SetValue(data, "oldValue", oldVal);
-
-                rbusValue_Init(&byVal);
-                rbusValue_SetString(byVal, rec->node->changeComp);
-                rbusObject_SetValue(data, "by", byVal);
-                rbusValue_Release(byVal);
-
-                event.name = rbusProperty_GetName(rec->property);
-                event.data = data;
-                event.type = RBUS_EVENT_VALUE_CHANGED;
-                result = rbusEvent_Publish(rec->handle, &event);
-
-                rbusObject_Release(data);
-
-                if(result != RBUS_ERROR_SUCCESS)
-                {
-                    RBUSLOG_WARN("%s: rbusEvent_Publish failed with result=%d", __FUNCTION__, result);
-                }
-
-                /*update the record's property with new value*/
-                rbusProperty_SetValue(rec->property, rbusProperty_GetValue(property));
-                rbusProperty_Release(property);
-            }
+        for(i = 0; i < numDue; ++i)
+        {
+            ValueChangeRecord* rec = due[i];
+            rec->busy = false;
+            if(rec->removed)
+                vcParams_Free(rec);
             else
-            {
-                RBUSLOG_DEBUG("%s: value change not detected for %s", __FUNCTION__, rbusProperty_GetName(rec->property));
-                rbusProperty_Release(property);
-            }
+                vcParams_ScheduleNext(rec);
         }
+        gVC->pollCount++;
+        ERROR_CHECK(pthread_cond_broadcast(&gVC->doneCond));
     }
     UNLOCK();
+    free(due);
     RBUSLOG_DEBUG("%s: stop", __FUNCTION__);
     return NULL;
 }
@@ -280,11 +408,21 @@ void rbusValueChange_AddPropertyNode(rbusHandle_t handle, elementNode* propNode)
 
     UNLOCK();//############ UNLOCK ############
 
-    if(!rec)
+    if(rec)
+    {
+        /* a new subscriber might want a shorter interval */
+        rbusValueChange_SetPropertyNodeInterval(handle, propNode, elementGetAutoPubInterval(propNode, NULL));
+    }
+    else
     {
         rec = (ValueChangeRecord*)rt_malloc(sizeof(ValueChangeRecord));
         rec->handle = handle;
         rec->node = propNode;
+        rec->period = vcParams_Period(elementGetAutoPubInterval(propNode, NULL));
+        rbusHeapLink_Init(&rec->schedule);
+        rec->dirty = false;
+        rec->busy = false;
+        rec->removed = false;
 
         rbusProperty_Init(&rec->property, propNode->fullName, NULL);
 
@@ -310,19 +448,83 @@ void rbusValueChange_AddPropertyNode(rbusHandle_t handle, elementNode* propNode)
         LOCK();//############ LOCK ############
 
         rtVector_PushBack(gVC->params, rec);
+        vcParams_ScheduleNext(rec);
 
-        /* start polling thread if needed */
+        /* start polling thread if needed, otherwise wake it up as rec may be due before whatever it's waiting on */
 
         if(!gVC->running)
         {
             gVC->running = 1;
             pthread_create(&gVC->thread, NULL, rbusValueChange_pollingThreadFunc, NULL);
         }
+        else
+        {
+            ERROR_CHECK(pthread_cond_signal(&gVC->cond));
+        }
 
         UNLOCK();//############ UNLOCK ############
     }
 }
 
+void rbusValueChange_SetPropertyNodeInterval(rbusHandle_t handle, elementNode* propNode, int32_t interval)
+{
+    ValueChangeRecord* rec;
+
+    (void)(handle);
+    VERIFY_NULL(propNode);
+
+    if(!gVC)
+    {
+        return;
+    }
+
+    LOCK();//############ LOCK ############
+    rec = vcParams_Find(propNode);
+    if(rec && rec->period != vcParams_Period(interval))
+    {
+        RBUSLOG_DEBUG("%s: %s period %d -> %d", __FUNCTION__, propNode->fullName, rec->period, vcParams_Period(interval));
+        rec->period = vcParams_Period(interval);
+        if(rbusHeapLink_IsScheduled(&rec->schedule))
+        {
+            rtTime_Later(NULL, rec->period, &rec->schedule.due);
+            rbusHeap_Schedule(&gVC->schedule, &rec->schedule);
+            ERROR_CHECK(pthread_cond_signal(&gVC->cond));
+        }
+    }
+    UNLOCK();//############ UNLOCK ############
+}
+
+void rbusValueChange_NotifyPropertyNode(rbusHandle_t handle, elementNode* propNode)
+{
+    ValueChangeRecord* rec;
+
+    (void)(handle);
+    VERIFY_NULL(propNode);
+
+    if(!gVC)
+    {
+        return;
+    }
+
+    LOCK();//############ LOCK ############
+    rec = vcParams_Find(propNode);
+    if(rec)
+    {
+        if(rec->busy)
+        {
+            /*the polling thread may have already got the old value so have it poll again once done*/
+            rec->dirty = true;
+        }
+        else
+        {
+            rtTime_Now(&rec->schedule.due);
+            rbusHeap_Schedule(&gVC->schedule, &rec->schedule);
+            ERROR_CHECK(pthread_cond_signal(&gVC->cond));
+        }
+    }
+    UNLOCK();//############ UNLOCK ############
+}
+
 void rbusValueChange_RemovePropertyNode(rbusHandle_t handle, elementNode* propNode)
 {
     ValueChangeRecord* rec;
@@ -341,9 +543,10 @@ void rbusValueChange_RemovePropertyNode(rbusHandle_t handle, elementNode* propNo
     rec = vcParams_Find(propNode);
     if(rec)
     {
-        rtVector_RemoveItem(gVC->params, rec, vcParams_Free);
-        /* if there's nothing left to poll then shutdown the polling thread */
-        if(gVC->running && rtVector_Size(gVC->params) == 0)
+        vcParams_Remove(rec);
+        /* if there's nothing left to poll then shutdown the polling thread.
+           the polling thread can't join itself so if this is called from it, leave it idle */
+        if(gVC->running && rtVector_Size(gVC->params) == 0 && !pthread_equal(pthread_self(), gVC->thread))
         {
             stopThread = true;
             gVC->running = 0;
@@ -382,7 +585,7 @@ void rbusValueChange_CloseHandle(rbusHandle_t handle)
         ValueChangeRecord* rec = (ValueChangeRecord*)rtVector_At(gVC->params, i);
         if(rec && rec->handle == handle)
         {
-            rtVector_RemoveItem(gVC->params, rec, vcParams_Free);
+            vcParams_Remove(rec);
         }
         else
         {
@@ -408,8 +611,10 @@ void rbusValueChange_CloseHandle(rbusHandle_t handle)
         }
         ERROR_CHECK(pthread_mutex_destroy(&gVC->mutex));
         ERROR_CHECK(pthread_cond_destroy(&gVC->cond));
+        ERROR_CHECK(pthread_cond_destroy(&gVC->doneCond));
         rtVector_Destroy(gVC->params, NULL);
         gVC->params = NULL;
+        rbusHeap_Clear(&gVC->schedule);
         free(gVC);
         gVC = NULL;
     }
@@ -418,4 +623,3 @@ void rbusValueChange_CloseHandle(rbusHandle_t handle)
         UNLOCK();//############ UNLOCK ############
     }
 }
-
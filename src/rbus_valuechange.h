@@ -28,6 +28,8 @@ extern "C" {
 
 void rbusValueChange_AddPropertyNode(rbusHandle_t handle, elementNode* propNode);
 void rbusValueChange_RemovePropertyNode(rbusHandle_t handle, elementNode* propNode);
+void rbusValueChange_SetPropertyNodeInterval(rbusHandle_t handle, elementNode* propNode, int32_t interval);
+void rbusValueChange_NotifyPropertyNode(rbusHandle_t handle, elementNode* propNode);
 void rbusValueChange_CloseHandle(rbusHandle_t handle);
 
 #ifdef __cplusplus
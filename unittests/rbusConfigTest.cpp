@@ -0,0 +1,86 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "../src/rbus_config.h"
+#include "../src/rbus_handle.h"
+
+#define GET_TIMEOUT_OVERRIDE "/tmp/rbus_timeout_get"
+
+TEST(rbusConfigTest, timeoutPrecedence)
+{
+  struct _rbusHandle handle1;
+  struct _rbusHandle handle2;
+  int def;
+
+  rbusConfig_CreateOnce();
+  def = rbusConfig_Get()->getTimeout;
+
+  memset(&handle1, 0, sizeof(handle1));
+  memset(&handle2, 0, sizeof(handle2));
+  rbusElementTimeouts_Create(&handle1.elementTimeouts);
+  rbusElementTimeouts_Create(&handle2.elementTimeouts);
+
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), def);
+
+  /*the handle's timeout, then its element overrides, the longest prefix first*/
+  handle1.getTimeout = 2000;
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 2000);
+  rbusElementTimeouts_Set(handle1.elementTimeouts, "Device.A.", 3000, 0);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 3000);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.AB.Param1"), 2000);
+  rbusElementTimeouts_Set(handle1.elementTimeouts, "Device.A.Param1", 4000, 0);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 4000);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param10"), 3000);
+
+  /*an override of only the get timeout leaves the set timeout alone*/
+  EXPECT_EQ(rbusConfig_SetTimeoutFor(&handle1, "Device.A.Param1"), rbusConfig_Get()->setTimeout);
+
+  /*overrides are the handle's own*/
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle2, "Device.A.Param1"), def);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(NULL, "Device.A.Param1"), def);
+
+  /*the override file beats them all.  leave a real one alone*/
+  if(access(GET_TIMEOUT_OVERRIDE, F_OK) != 0)
+  {
+    FILE* fp = fopen(GET_TIMEOUT_OVERRIDE, "w");
+    ASSERT_TRUE(fp != NULL);
+    fprintf(fp, "5");
+    fclose(fp);
+
+    /*the file is checked at most once a second*/
+    usleep(1100000);
+    EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 5000);
+    EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle2, "Device.A.Param1"), 5000);
+
+    unlink(GET_TIMEOUT_OVERRIDE);
+    usleep(1100000);
+    EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 4000);
+  }
+
+  /*setting both to 0 removes an override*/
+  rbusElementTimeouts_Set(handle1.elementTimeouts, "Device.A.Param1", 0, 0);
+  EXPECT_EQ(rbusConfig_GetTimeoutFor(&handle1, "Device.A.Param1"), 3000);
+
+  rbusElementTimeouts_Destroy(handle1.elementTimeouts);
+  rbusElementTimeouts_Destroy(handle2.elementTimeouts);
+}
@@ -24,6 +24,7 @@
 #include <rbus.h>
 #include "rbusProviderConsumer.h"
 #include <math.h>
+#include <pthread.h>
 #define MIN(a,b) ((a) < (b) ? (a) : (b))
 
 void hasProviderStarted(const char *provider);
@@ -34,6 +35,14 @@ void getCompileTime(struct tm *t);
 static char gtest_err[64];
 
 static bool asyncCalled = false;
+static int intervalEvents = 0;
+static int batchEvents = 0;
+static int batchValueChanges = 0;
+static unsigned int rowEvents = 0;
+static int notifiedEvents = 0;
+static int32_t notifiedValue = -1;
+static int asyncPending = 0;
+static pthread_mutex_t asyncMutex = PTHREAD_MUTEX_INITIALIZER;
 
 void testOutParams(rbusObject_t outParams, char const* name, rbusError_t error)
 {
@@ -205,6 +214,376 @@ static void eventReceiveHandler(
     printf("User data: %s\n", (char*)subscription->userData);
 }
 
+static void intervalEventHandler(
+    rbusHandle_t handle,
+    rbusEvent_t const* event,
+    rbusEventSubscription_t* subscription)
+{
+  (void)handle;
+  (void)subscription;
+
+  printf("Consumer received interval event for param %s\n", event->name);
+
+  /*a sample has the value of each subscribed instance, named by its full name*/
+  if(event->type == RBUS_EVENT_INTERVAL && rbusObject_GetValue(event->data, "Device.rbusProvider.Param1"))
+    intervalEvents++;
+  else
+    snprintf(gtest_err, sizeof(gtest_err), "Unexpected event type %d", event->type);
+}
+
+static void notifiedEventHandler(
+    rbusHandle_t handle,
+    rbusEvent_t const* event,
+    rbusEventSubscription_t* subscription)
+{
+  (void)handle;
+  (void)subscription;
+
+  rbusValue_t value = rbusObject_GetValue(event->data, "value");
+
+  printf("Consumer received value-change event for param %s\n", event->name);
+
+  if(event->type == RBUS_EVENT_VALUE_CHANGED && value)
+  {
+    notifiedValue = rbusValue_GetInt32(value);
+    notifiedEvents++;
+  }
+  else
+  {
+    snprintf(gtest_err, sizeof(gtest_err), "Unexpected event type %d", event->type);
+  }
+}
+
+static void polledEventHandler(
+    rbusHandle_t handle,
+    rbusEvent_t const* event,
+    rbusEventSubscription_t* subscription)
+{
+  (void)handle;
+  (void)subscription;
+
+  /*Device.rbusProvider.Polled never changes*/
+  snprintf(gtest_err, sizeof(gtest_err), "Unexpected event for %s", event->name);
+}
+
+/*wait up to timeout milliseconds for the count of value-change events of Device.rbusProvider.Notified*/
+static int waitNotifiedEvents(int count, int timeout)
+{
+  for(; notifiedEvents < count && timeout > 0; timeout -= 100)
+    usleep(100000);
+  EXPECT_EQ(notifiedEvents, count);
+  return notifiedEvents == count ? RBUS_ERROR_SUCCESS : RBUS_ERROR_BUS_ERROR;
+}
+
+static void batchEventHandler(
+    rbusHandle_t handle,
+    rbusEvent_t const* event,
+    rbusEventSubscription_t* subscription)
+{
+  (void)handle;
+  (void)subscription;
+
+  rbusValue_t value = rbusObject_GetValue(event->data, "value");
+  rbusValue_t oldValue = rbusObject_GetValue(event->data, "oldValue");
+
+  printf("Consumer received batched event %s type %d\n", event->name, event->type);
+
+  /*one handler call per event, in the order published*/
+  if(event->type == RBUS_EVENT_GENERAL)
+  {
+    if(!value || rbusValue_GetInt32(value) != batchEvents)
+      snprintf(gtest_err, sizeof(gtest_err), "Event %d out of order", batchEvents);
+    batchEvents++;
+  }
+  else if(event->type == RBUS_EVENT_VALUE_CHANGED)
+  {
+    if(!value || !oldValue || rbusValue_GetInt32(value) != 3 || rbusValue_GetInt32(oldValue) != 0)
+      snprintf(gtest_err, sizeof(gtest_err), "Value-changes not coalesced");
+    batchValueChanges++;
+  }
+}
+
+/*gets every parameter of the table's rows and checks they are exactly the rows' Param1s*/
+static int checkRowParams(rbusHandle_t handle, char const* const* expected, int numExpected)
+{
+  rbusProperty_t props = NULL;
+  rbusProperty_t next;
+  int actualCount = 0;
+  int rc, i;
+  const char *table = "Device.rbusProvider.Rows.";
+
+  rc = rbus_getExt(handle, 1, &table, &actualCount, &props);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  EXPECT_EQ(actualCount,numExpected);
+  if(rc != RBUS_ERROR_SUCCESS)
+    return rc;
+  if(actualCount != numExpected)
+    rc = RBUS_ERROR_BUS_ERROR;
+
+  for(next = props; next; next = rbusProperty_GetNext(next))
+  {
+    for(i = 0; i < numExpected; i++)
+      if(strcmp(rbusProperty_GetName(next), expected[i]) == 0)
+        break;
+    if(i == numExpected)
+    {
+      printf("Consumer got unexpected row param %s\n", rbusProperty_GetName(next));
+      rc = RBUS_ERROR_BUS_ERROR;
+    }
+  }
+  rbusProperty_Release(props);
+  return rc;
+}
+
+static int32_t getCounter(rbusHandle_t handle)
+{
+  rbusValue_t value = NULL;
+  int32_t counter = -1;
+  int rc;
+
+  rc = rbus_get(handle, "Device.rbusProvider.Counter", &value);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  if(value)
+  {
+    counter = rbusValue_GetInt32(value);
+    rbusValue_Release(value);
+  }
+  return counter;
+}
+
+typedef struct
+{
+  int numPages;
+  int numProps;
+  int maxPages;
+  char names[8][64];
+} pageCollection_t;
+
+/*keep the names of a page's properties, failing on one already seen in an earlier page*/
+static int collectPage(pageCollection_t* pages, int numProps, rbusProperty_t props)
+{
+  rbusProperty_t next;
+  int count = 0;
+  int rc = RBUS_ERROR_SUCCESS;
+  int i;
+
+  pages->numPages++;
+  for(next = props; next; next = rbusProperty_GetNext(next), count++)
+  {
+    for(i = 0; i < pages->numProps; i++)
+      if(strcmp(pages->names[i], rbusProperty_GetName(next)) == 0)
+        break;
+    if(i < pages->numProps || pages->numProps == 8)
+    {
+      printf("Consumer got %s twice or too many properties\n", rbusProperty_GetName(next));
+      rc = RBUS_ERROR_BUS_ERROR;
+      continue;
+    }
+    snprintf(pages->names[pages->numProps++], sizeof(pages->names[0]), "%s", rbusProperty_GetName(next));
+  }
+  EXPECT_EQ(count, numProps);
+  return count == numProps ? rc : RBUS_ERROR_BUS_ERROR;
+}
+
+static bool streamPageHandler(rbusHandle_t handle, char const* query, int numProps, rbusProperty_t props, void* userData)
+{
+  pageCollection_t* pages = (pageCollection_t*)userData;
+
+  (void)handle;
+  printf("streamPageHandler called: query=%s numProps=%d\n", query, numProps);
+
+  if(collectPage(pages, numProps, props) != RBUS_ERROR_SUCCESS)
+    snprintf(gtest_err, sizeof(gtest_err), "%s", "getStream page");
+  return pages->maxPages == 0 || pages->numPages < pages->maxPages;
+}
+
+/*get every page of query, checking none is larger than pageSize*/
+static int getAllPages(rbusHandle_t handle, char const* query, uint32_t pageSize, pageCollection_t* pages)
+{
+  uint32_t cursor = 0;
+  int rc = RBUS_ERROR_SUCCESS;
+
+  memset(pages, 0, sizeof(*pages));
+  do
+  {
+    int numProps = 0;
+    rbusProperty_t props = NULL;
+
+    rc = rbus_getPage(handle, query, pageSize, &cursor, &numProps, &props);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+    EXPECT_LE(numProps, (int)pageSize);
+    if(rc == RBUS_ERROR_SUCCESS)
+      rc = collectPage(pages, numProps, props);
+    if(props)
+      rbusProperty_Release(props);
+  } while(cursor != 0 && rc == RBUS_ERROR_SUCCESS && pages->numPages < 8);
+
+  EXPECT_EQ(cursor, 0u);
+  return cursor == 0 ? rc : RBUS_ERROR_BUS_ERROR;
+}
+
+/*the number of properties a single getExt of query returns*/
+static int getExtCount(rbusHandle_t handle, char const* query)
+{
+  rbusProperty_t props = NULL;
+  int count = 0;
+  int rc;
+
+  rc = rbus_getExt(handle, 1, &query, &count, &props);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  if(props)
+    rbusProperty_Release(props);
+  return rc == RBUS_ERROR_SUCCESS ? count : -1;
+}
+
+/*the provider's counts of multi handler calls, which it resets on every read*/
+static int checkMultiStats(rbusHandle_t handle, char const* param, char const* expected)
+{
+  char* stats = NULL;
+  int rc;
+
+  rc = rbus_getStr(handle, param, &stats);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  if(stats)
+  {
+    EXPECT_STREQ(stats, expected);
+    if(strcmp(stats, expected))
+      rc = RBUS_ERROR_BUS_ERROR;
+    free(stats);
+  }
+  return rc;
+}
+
+static int setMultiStrings(rbusHandle_t handle, int numProps, char const* const* names, char const* const* values, bool commit)
+{
+  rbusProperty_t props = NULL;
+  rbusSetOptions_t opts = {commit, 0};
+  int i, rc;
+
+  for(i = numProps - 1; i >= 0; i--)
+  {
+    rbusProperty_t prop;
+    rbusValue_t value;
+
+    rbusValue_Init(&value);
+    rbusValue_SetString(value, values[i]);
+    rbusProperty_Init(&prop, names[i], value);
+    rbusProperty_SetNext(prop, props);
+    if(props)
+      rbusProperty_Release(props);
+    props = prop;
+    rbusValue_Release(value);
+  }
+
+  rc = rbus_setMulti(handle, numProps, props, &opts);
+  rbusProperty_Release(props);
+  return rc;
+}
+
+static int checkString(rbusHandle_t handle, char const* param, char const* expected)
+{
+  char* value = NULL;
+  int rc;
+
+  rc = rbus_getStr(handle, param, &value);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  if(value)
+  {
+    EXPECT_STREQ(value, expected);
+    if(strcmp(value, expected))
+      rc = RBUS_ERROR_BUS_ERROR;
+    free(value);
+  }
+  return rc;
+}
+
+/*the value-change polls of Device.rbusProvider.Polled since the last call*/
+static int getPollCount(rbusHandle_t handle)
+{
+  int count = -1;
+
+  EXPECT_EQ(rbus_getInt(handle, "Device.rbusProvider.PollCount", &count), RBUS_ERROR_SUCCESS);
+  return count;
+}
+
+/*the async callbacks can run on different threads at once*/
+static void asyncCompleted(char const* err)
+{
+  pthread_mutex_lock(&asyncMutex);
+  if(err && !strlen(gtest_err))
+    snprintf(gtest_err, sizeof(gtest_err), "%s", err);
+  asyncPending--;
+  pthread_mutex_unlock(&asyncMutex);
+}
+
+static int getAsyncPending()
+{
+  int pending;
+
+  pthread_mutex_lock(&asyncMutex);
+  pending = asyncPending;
+  pthread_mutex_unlock(&asyncMutex);
+  return pending;
+}
+
+static void getAsyncHandler(rbusHandle_t handle, char const* name, rbusError_t error, rbusValue_t value, void* userData)
+{
+  (void)handle;
+  printf("Consumer getAsync %s completed %d\n", name, error);
+
+  /*userData is the name the get was made for*/
+  if(strcmp(name, (char const*)userData) != 0)
+    asyncCompleted("getAsync name mismatch");
+  else if(strcmp(name, "Device.rbusProvider.Int32") == 0)
+    asyncCompleted((error != RBUS_ERROR_SUCCESS || !value || rbusValue_GetInt32(value) != GTEST_VAL_INT32) ? "getAsync bad value" : NULL);
+  else
+    asyncCompleted((error == RBUS_ERROR_SUCCESS || value) ? "getAsync of a missing name succeeded" : NULL);
+}
+
+static void getExtAsyncHandler(rbusHandle_t handle, rbusError_t error, int numProps, rbusProperty_t properties, void* userData)
+{
+  (void)handle;
+  (void)userData;
+  printf("Consumer getExtAsync completed %d with %d properties\n", error, numProps);
+
+  if(error != RBUS_ERROR_SUCCESS || numProps != 2 || !properties)
+    asyncCompleted("getExtAsync failed");
+  else if(rbusValue_GetInt16(rbusProperty_GetValue(properties)) != GTEST_VAL_INT16 ||
+          rbusValue_GetUInt32(rbusProperty_GetValue(rbusProperty_GetNext(properties))) != GTEST_VAL_UINT32)
+    asyncCompleted("getExtAsync bad values");
+  else
+    asyncCompleted(NULL);
+}
+
+static void setAsyncHandler(rbusHandle_t handle, char const* name, rbusError_t error, void* userData)
+{
+  (void)handle;
+  (void)userData;
+  printf("Consumer setAsync %s completed %d\n", name, error);
+
+  asyncCompleted(error != RBUS_ERROR_SUCCESS ? "setAsync failed" : NULL);
+}
+
+static void rowEventHandler(
+    rbusHandle_t handle,
+    rbusEvent_t const* event,
+    rbusEventSubscription_t* subscription)
+{
+  (void)handle;
+  (void)subscription;
+  unsigned int row = 0;
+  char tail[16] = {0};
+
+  printf("Consumer received row event %s\n", event->name);
+
+  /*each row's event once, and nothing from the registration node*/
+  if(sscanf(event->name, "Device.rbusProvider.Rows.%u.%15s", &row, tail) != 2 ||
+     strcmp(tail, "Event1!") != 0 || row < 1 || row > 3 || (rowEvents & (1u << row)))
+    snprintf(gtest_err, sizeof(gtest_err), "Unexpected row event %s", event->name);
+  else
+    rowEvents |= 1u << row;
+}
+
 static void asyncMethodHandler(
     rbusHandle_t handle,
     char const* methodName,
@@ -254,7 +633,7 @@ int rbusConsumer(rbusGtest_t test, pid_t pid, int runtime)
   const char* event_param = "Device.rbusProvider.Param1";
   rbusEventSubscription_t subscription = {event_param, NULL, 0, 0, (void *)eventReceiveHandler, NULL, 0};
 
-  if(RBUS_GTEST_GET_EXT2 == test)
+  if(RBUS_GTEST_GET_EXT2 == test || RBUS_GTEST_GET_EXT3 == test || RBUS_GTEST_GET_PAGE2 == test)
   {
     int i = 0;
     for(i = 0 ; i < 3 ; i++)
@@ -742,6 +1121,54 @@ int rbusConsumer(rbusGtest_t test, pid_t pid, int runtime)
         kill(pid_arr[0],SIGUSR1);
         kill(pid_arr[1],SIGUSR1);
         kill(pid_arr[2],SIGUSR1);
+        memset(pid_arr,0,sizeof(pid_arr));
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_GET_EXT3:
+      {
+        rbusProperty_t props = NULL;
+        rbusProperty_t next;
+        int actualCount = 0;
+        int i = 0;
+        rbusValue_t actualValue;
+        /*not in provider order, so the fanned out replies have to be put back in request order*/
+        const char *params[3] = {
+          "Device.rbusMultiProvider2.Param1",
+          "Device.rbusMultiProvider0.Param1",
+          "Device.rbusMultiProvider1.Param1",
+        };
+
+        isElementPresent(handle, params[0]);
+        isElementPresent(handle, params[1]);
+        isElementPresent(handle, params[2]);
+
+        rc = rbus_getExt(handle, 3, params, &actualCount, &props);
+        EXPECT_EQ(actualCount, 3);
+        if(rc == RBUS_ERROR_SUCCESS)
+        {
+          next = props;
+          for(i = 0; next; i++)
+          {
+            actualValue = rbusProperty_GetValue(next);
+            if(i >= 3 || 0 != strcmp(rbusProperty_GetName(next), params[i]) ||
+               actualValue == NULL || rbusValue_GetType(actualValue) != RBUS_STRING ||
+               0 != strcmp(rbusValue_GetString(actualValue, NULL), params[i]))
+            {
+              rc = RBUS_ERROR_BUS_ERROR;
+              break;
+            }
+            next = rbusProperty_GetNext(next);
+          }
+          rbusProperty_Release(props);
+          if(i != 3)
+            rc = RBUS_ERROR_BUS_ERROR;
+        }
+
+        kill(pid_arr[0],SIGUSR1);
+        kill(pid_arr[1],SIGUSR1);
+        kill(pid_arr[2],SIGUSR1);
+        memset(pid_arr,0,sizeof(pid_arr));
         EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
       }
       break;
@@ -939,6 +1366,491 @@ int rbusConsumer(rbusGtest_t test, pid_t pid, int runtime)
         rc = exec_rbus_set_test(handle, RBUS_ERROR_INVALID_INPUT, param, "unregister_row_fail");
       }
       break;
+    case RBUS_GTEST_TABLE_ROWS1:
+      {
+        uint32_t instNum1 = 0, instNum2 = 0;
+        char rowName1[64], rowName2[64];
+        char const* rowNames[2] = {rowName1, rowName2};
+
+        isElementPresent(handle, "Device.rbusProvider.PartialPath");
+
+        /*the single row requests an older consumer sends, to a provider with a multi-row handler*/
+        rc = rbusTable_addRow(handle, "Device.rbusProvider.PartialPath.", "colors", &instNum1);
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+        rc |= rbusTable_removeRow(handle, "Device.rbusProvider.PartialPath.[colors].");
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+
+        rc |= rbusTable_addRow(handle, "Device.rbusProvider.PartialPath.", NULL, &instNum1);
+        snprintf(rowName1, sizeof(rowName1), "Device.rbusProvider.PartialPath.%u", instNum1);
+        rc |= rbusTable_removeRow(handle, rowName1);
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+
+        /*a multi-row request, with one row name ending in a dot, goes to the same table*/
+        rc |= rbusTable_addRow(handle, "Device.rbusProvider.PartialPath.", NULL, &instNum1);
+        rc |= rbusTable_addRow(handle, "Device.rbusProvider.PartialPath.", NULL, &instNum2);
+        snprintf(rowName1, sizeof(rowName1), "Device.rbusProvider.PartialPath.%u.", instNum1);
+        snprintf(rowName2, sizeof(rowName2), "Device.rbusProvider.PartialPath.%u", instNum2);
+        rc |= rbusTable_removeRows(handle, 2, rowNames);
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_TABLE_ROWS3:
+      {
+        const char *row_event = "Device.rbusProvider.Rows.*.Event1!";
+
+        isElementPresent(handle, "Device.rbusProvider.Rows.");
+
+        /*subscribed before any row exists, so only adding the rows can match it to them*/
+        rc = rbusEvent_Subscribe(handle, row_event, rowEventHandler, NULL, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, "Device.rbusProvider.Param2", "register_row_events");
+
+        sleep(runtime);
+
+        EXPECT_EQ(rowEvents, (1u << 1) | (1u << 2) | (1u << 3));
+        if(rowEvents != ((1u << 1) | (1u << 2) | (1u << 3)))
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        rc |= rbusEvent_Unsubscribe(handle, row_event);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_TABLE_ROWS4:
+      {
+        const char *param = "Device.rbusProvider.Param2";
+        char const* allRows[4] = {
+          "Device.rbusProvider.Rows.1.Param1",
+          "Device.rbusProvider.Rows.2.Param1",
+          "Device.rbusProvider.Rows.3.Param1",
+          "Device.rbusProvider.Rows.4.Param1"
+        };
+        char const* keptRows[2] = {
+          "Device.rbusProvider.Rows.1.Param1",
+          "Device.rbusProvider.Rows.4.Param1"
+        };
+
+        isElementPresent(handle, "Device.rbusProvider.Rows.");
+
+        rc = exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "register_rows");
+        rc |= checkRowParams(handle, allRows, 4);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "unregister_rows");
+        rc |= checkRowParams(handle, keptRows, 2);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_VALUE_CACHE1:
+      {
+        int32_t c1, c2, c3, c4;
+
+        isElementPresent(handle, "Device.rbusProvider.Counter");
+
+        /*the provider's counter goes up on every get it answers, so a repeat means it came from the cache*/
+        rc = rbusHandle_ConfigValueCache(handle, 500, false);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        c1 = getCounter(handle);
+        c2 = getCounter(handle);
+        EXPECT_EQ(c1, c2);
+        usleep(700000);
+        c3 = getCounter(handle);
+        EXPECT_GT(c3, c2);
+        if(c1 != c2 || c3 <= c2)
+          rc |= RBUS_ERROR_BUS_ERROR;
+
+        /*coherent, a value-change event updates the cached value long before its ttl is up.
+          the provider polls the counter for value-changes every 2 seconds, which changes it every poll*/
+        rc |= rbusHandle_ConfigValueCache(handle, 60000, true);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        c3 = getCounter(handle);
+        sleep(5);
+        c4 = getCounter(handle);
+        EXPECT_GT(c4, c3);
+        if(c4 <= c3)
+          rc |= RBUS_ERROR_BUS_ERROR;
+
+        rc |= rbusHandle_ConfigValueCache(handle, 0, false);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_ASYNC_GETSET1:
+      {
+        const char *int32_param = "Device.rbusProvider.Int32";
+        const char *missing_param = "Device.rbusProvider.NotThere";
+        const char *ext_params[2] = {"Device.rbusProvider.Int16", "Device.rbusProvider.UInt32"};
+        rbusValue_t value;
+        int i;
+
+        isElementPresent(handle, int32_param);
+
+        asyncPending = 4;
+        rc = rbus_getAsync(handle, int32_param, getAsyncHandler, (void*)int32_param);
+        rc |= rbus_getAsync(handle, missing_param, getAsyncHandler, (void*)missing_param);
+        rc |= rbus_getExtAsync(handle, 2, ext_params, getExtAsyncHandler, NULL);
+
+        rbusValue_Init(&value);
+        rbusValue_SetString(value, "async set");
+        rc |= rbus_setAsync(handle, "Device.rbusProvider.Param2", value, NULL, setAsyncHandler, NULL);
+        rbusValue_Release(value);
+
+        /*an async request with no handler is refused and never completes*/
+        EXPECT_EQ(rbus_getAsync(handle, int32_param, NULL, NULL), RBUS_ERROR_INVALID_INPUT);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        for(i = 0; i < runtime * 10 && getAsyncPending(); i++)
+          usleep(100000);
+
+        pthread_mutex_lock(&asyncMutex);
+        EXPECT_EQ(asyncPending, 0);
+        if(asyncPending != 0)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+        pthread_mutex_unlock(&asyncMutex);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_TABLE_ROWS2:
+      {
+        char const* rowNames[3] = {"Device.rbuscoreProvider.Table.1", "Device.rbuscoreProvider.Table.2.", "Device.rbuscoreProvider.Table.3"};
+
+        /*an older provider removes only the first row of the request, so the others are sent again*/
+        isElementPresent(handle, "Device.rbuscoreProvider.Table.3");
+        rc = rbusTable_removeRows(handle, 3, rowNames);
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_INTERVAL_SUB1:
+      {
+        /*sample Param1 every second, for 3 seconds after which the provider ends the subscription*/
+        rbusEventSubscription_t intervalSub = {event_param, NULL, 1, 3, (void *)intervalEventHandler, NULL, 0};
+
+        isElementPresent(handle, event_param);
+        intervalEvents = 0;
+        rc = rbusEvent_SubscribeEx(handle, &intervalSub, 1, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        sleep(runtime);
+
+        /*no more samples once the duration is over*/
+        EXPECT_GE(intervalEvents, 2);
+        EXPECT_LE(intervalEvents, 3);
+        if(intervalEvents < 2 || intervalEvents > 3)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        /*the provider already removed it, so only the local subscription is left to remove*/
+        rbusEvent_UnsubscribeEx(handle, &intervalSub, 1);
+      }
+      break;
+    case RBUS_GTEST_EVENT_BATCH1:
+      {
+        const char *batch_event = "Device.rbusProvider.Event1!";
+
+        isElementPresent(handle, batch_event);
+        rc = rbusEvent_Subscribe(handle, batch_event, batchEventHandler, NULL, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        /*the provider's set handler publishes a batch and flushes it*/
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, "Device.rbusProvider.Param2", "publish_batch");
+
+        sleep(runtime);
+
+        EXPECT_EQ(batchEvents, 5);
+        EXPECT_EQ(batchValueChanges, 1);
+        if(batchEvents != 5 || batchValueChanges != 1)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        rc |= rbusEvent_Unsubscribe(handle, batch_event);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_GET_PAGE1:
+      {
+        const char *query = "Device.rbusProvider.PageTable.";
+        pageCollection_t pages;
+        char name[64];
+        int i;
+
+        isElementPresent(handle, query);
+
+        /*the table getHandler returns its 5 rows at once, but each row counts against the page*/
+        rc = getAllPages(handle, query, 2, &pages);
+        EXPECT_EQ(pages.numPages, 3);
+        EXPECT_EQ(pages.numProps, 5);
+        if(pages.numPages != 3 || pages.numProps != 5)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        for(i = 0; i < pages.numProps; i++)
+        {
+          snprintf(name, sizeof(name), "Device.rbusProvider.PageTable.%d.Param1", i + 1);
+          EXPECT_STREQ(pages.names[i], name);
+          if(strcmp(pages.names[i], name))
+            rc |= RBUS_ERROR_BUS_ERROR;
+        }
+
+        /*a stream gets what a single getExt does*/
+        memset(&pages, 0, sizeof(pages));
+        rc |= rbus_getStream(handle, query, 3, streamPageHandler, &pages);
+        EXPECT_EQ(pages.numPages, 2);
+        EXPECT_EQ(pages.numProps, getExtCount(handle, query));
+        if(pages.numPages != 2 || pages.numProps != 5)
+          rc |= RBUS_ERROR_BUS_ERROR;
+
+        /*and stops at the first page its handler declines the next of*/
+        memset(&pages, 0, sizeof(pages));
+        pages.maxPages = 1;
+        rc |= rbus_getStream(handle, query, 3, streamPageHandler, &pages);
+        EXPECT_EQ(pages.numPages, 1);
+        EXPECT_EQ(pages.numProps, 3);
+        if(pages.numPages != 1 || pages.numProps != 3)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_GET_PAGE2:
+      {
+        const char *query = "Device.";
+        pageCollection_t pages;
+        int i, j;
+
+        isElementPresent(handle, "Device.rbusMultiProvider0.Param1");
+        isElementPresent(handle, "Device.rbusMultiProvider1.Param1");
+        isElementPresent(handle, "Device.rbusMultiProvider2.Param1");
+
+        /*the cursor moves on to the next provider once one has returned all it has*/
+        rc = getAllPages(handle, query, 1, &pages);
+        EXPECT_EQ(pages.numProps, getExtCount(handle, query));
+        for(i = 0; i < 3; i++)
+        {
+          char name[64];
+
+          snprintf(name, sizeof(name), "Device.rbusMultiProvider%d.Param1", i);
+          for(j = 0; j < pages.numProps; j++)
+            if(strcmp(pages.names[j], name) == 0)
+              break;
+          EXPECT_LT(j, pages.numProps);
+          if(j == pages.numProps)
+            rc |= RBUS_ERROR_BUS_ERROR;
+        }
+
+        memset(&pages, 0, sizeof(pages));
+        rc |= rbus_getStream(handle, query, 2, streamPageHandler, &pages);
+        EXPECT_GE(pages.numPages, 3);
+        EXPECT_EQ(pages.numProps, getExtCount(handle, query));
+        if(pages.numPages < 3)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        kill(pid_arr[0],SIGUSR1);
+        kill(pid_arr[1],SIGUSR1);
+        kill(pid_arr[2],SIGUSR1);
+        memset(pid_arr,0,sizeof(pid_arr));
+        EXPECT_EQ(rc, RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_GET_PAGE3:
+      {
+        const char *query = "Device.rbuscoreProvider.Page.";
+        rbusProperty_t props = NULL;
+        rbusProperty_t next;
+        uint32_t cursor = 0;
+        int numProps = 0;
+        int i;
+
+        isElementPresent(handle, "Device.rbuscoreProvider.Page.Param3");
+
+        /*a provider that doesn't page returns everything, with no cursor, so it is the only page*/
+        rc = rbus_getPage(handle, query, 2, &cursor, &numProps, &props);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        EXPECT_EQ(numProps, 3);
+        EXPECT_EQ(cursor, 0u);
+        if(numProps != 3 || cursor != 0)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        for(next = props, i = 1; next; next = rbusProperty_GetNext(next), i++)
+        {
+          rbusValue_t value = rbusProperty_GetValue(next);
+
+          if(!value || rbusValue_GetType(value) != RBUS_INT32 || rbusValue_GetInt32(value) != i)
+            rc |= RBUS_ERROR_BUS_ERROR;
+        }
+        if(props)
+          rbusProperty_Release(props);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_GET_MULTI_HANDLER1:
+      {
+        rbusProperty_t props = NULL;
+        rbusProperty_t next;
+        int actualCount = 0;
+        int i;
+        const char *query = "Device.rbusProvider.Multi.";
+        const char *params[4] = {
+          "Device.rbusProvider.Multi.Param3",
+          "Device.rbusProvider.Multi.Param1",
+          "Device.rbusProvider.Multi.Param4",
+          "Device.rbusProvider.Multi.Param2"
+        };
+
+        isElementPresent(handle, "Device.rbusProvider.MultiStats");
+
+        /*one multi handler call gets them all but Param4, which falls back to its getHandler,
+          and the values come back in the order they were asked for*/
+        rc = rbus_getExt(handle, 4, params, &actualCount, &props);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        EXPECT_EQ(actualCount, 4);
+        for(next = props, i = 0; next; next = rbusProperty_GetNext(next), i++)
+        {
+          rbusValue_t value = rbusProperty_GetValue(next);
+
+          if(i >= 4 || strcmp(rbusProperty_GetName(next), params[i]) ||
+             !value || rbusValue_GetType(value) != RBUS_STRING ||
+             strcmp(rbusValue_GetString(value, NULL), params[i]))
+          {
+            rc |= RBUS_ERROR_BUS_ERROR;
+            break;
+          }
+        }
+        if(props)
+          rbusProperty_Release(props);
+        if(i != 4)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= checkMultiStats(handle, "Device.rbusProvider.MultiStats", "gets=1 props=4 singles=1");
+
+        /*so does a partial path query*/
+        props = NULL;
+        rc |= rbus_getExt(handle, 1, &query, &actualCount, &props);
+        EXPECT_EQ(actualCount, 4);
+        if(actualCount != 4)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        if(props)
+          rbusProperty_Release(props);
+        rc |= checkMultiStats(handle, "Device.rbusProvider.MultiStats", "gets=1 props=4 singles=1");
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_SET_MULTI_HANDLER1:
+      {
+        const char *stats = "Device.rbusProvider.MultiSetStats";
+        const char *names1[3] = {"Device.rbusProvider.Multi.Param1", "Device.rbusProvider.Param3", "Device.rbusProvider.Multi.Param2"};
+        const char *values1[3] = {"value1", "value2", "value3"};
+        const char *names2[2] = {"Device.rbusProvider.Multi.Param3", "Device.rbusProvider.Multi.Table.1.Param1"};
+        const char *values2[2] = {"value4", "value5"};
+        const char *names3[2] = {"Device.rbusProvider.Multi.Param1", "Device.rbusProvider.Multi.Table.7.Param1"};
+        const char *values3[2] = {"value6", "value7"};
+
+        isElementPresent(handle, stats);
+
+        /*the multi handler gets its properties in one call with the commit of the whole set,
+          and the property outside it goes to its own setHandler*/
+        rc = setMultiStrings(handle, 3, names1, values1, true);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        rc |= checkMultiStats(handle, stats, "sets=1 props=2 commits=1");
+        rc |= checkString(handle, names1[0], values1[0]);
+        rc |= checkString(handle, names1[2], values1[2]);
+
+        rc |= setMultiStrings(handle, 2, names2, values2, false);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        rc |= checkMultiStats(handle, stats, "sets=1 props=2 commits=0");
+        rc |= checkString(handle, names2[1], values2[1]);
+
+        /*a row that doesn't exist fails the set before any of it is applied*/
+        EXPECT_NE(setMultiStrings(handle, 2, names3, values3, true), RBUS_ERROR_SUCCESS);
+        rc |= checkMultiStats(handle, stats, "sets=0 props=0 commits=0");
+        rc |= checkString(handle, names3[0], values1[0]);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_VALUE_CHANGE_NOTIFY1:
+      {
+        const char *notified = "Device.rbusProvider.Notified";
+        const char *param = "Device.rbusProvider.Param2";
+
+        isElementPresent(handle, notified);
+        rc = rbusEvent_Subscribe(handle, notified, notifiedEventHandler, NULL, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+        /*the provider turned polling off, so only its notifications find changes*/
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "change_notified");
+        rc |= waitNotifiedEvents(1, 1000);
+        EXPECT_EQ(notifiedValue, 1);
+
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "change_notified_silently");
+        sleep(3);
+        rc |= waitNotifiedEvents(1, 0);
+
+        /*the next notification publishes the latest value*/
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "change_notified");
+        rc |= waitNotifiedEvents(2, 1000);
+        EXPECT_EQ(notifiedValue, 3);
+
+        /*with polling back on, a change is found without one*/
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "poll_notified");
+        rc |= exec_rbus_set_test(handle, RBUS_ERROR_SUCCESS, param, "change_notified_silently");
+        rc |= waitNotifiedEvents(3, 3000);
+        EXPECT_EQ(notifiedValue, 4);
+        if(notifiedValue != 4)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        rc |= rbusEvent_Unsubscribe(handle, notified);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
+    case RBUS_GTEST_VALUE_CHANGE_PERIOD1:
+      {
+        const char *polled = "Device.rbusProvider.Polled";
+        rbusFilter_t filter;
+        rbusValue_t filterValue;
+        rbusEventSubscription_t fastSub = {polled, NULL, 1, 0, (void *)polledEventHandler, NULL, 0};
+        int slow, fast, after;
+
+        isElementPresent(handle, polled);
+
+        /*never true, the subscription only asks for the property to be checked every second*/
+        rbusValue_Init(&filterValue);
+        rbusValue_SetInt32(filterValue, 100);
+        rbusFilter_InitRelation(&filter, RBUS_FILTER_OPERATOR_GREATER_THAN, filterValue);
+        fastSub.filter = filter;
+
+        /*polled every valueChangePeriod (2 seconds) by default*/
+        rc = rbusEvent_Subscribe(handle, polled, polledEventHandler, NULL, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        getPollCount(handle);
+        sleep(5);
+        slow = getPollCount(handle);
+
+        /*a subscriber with a 1 second interval makes it polled every second*/
+        rc |= rbusEvent_SubscribeEx(handle, &fastSub, 1, 0);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        getPollCount(handle);
+        sleep(5);
+        fast = getPollCount(handle);
+
+        /*and back to the default once it unsubscribes*/
+        rc |= rbusEvent_UnsubscribeEx(handle, &fastSub, 1);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+        getPollCount(handle);
+        sleep(5);
+        after = getPollCount(handle);
+
+        printf("Consumer got %d, %d and %d polls\n", slow, fast, after);
+        EXPECT_LE(slow, 3);
+        EXPECT_GE(fast, 4);
+        EXPECT_LE(after, 3);
+        if(slow > 3 || fast < 4 || after > 3)
+          rc |= RBUS_ERROR_BUS_ERROR;
+        rc |= (strlen(gtest_err)) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
+
+        rc |= rbusEvent_Unsubscribe(handle, polled);
+        rbusValue_Release(filterValue);
+        rbusFilter_Release(filter);
+        EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+      }
+      break;
   }
 
   rc |= rbus_close(handle);
@@ -304,3 +304,91 @@ TEST(rbusElementTest, negtestElement3)
 
     freeElementNode(root);
 }
+
+TEST(rbusElementTest, testElementIndex)
+{
+    elementNode* root = getEmptyElementNode();
+    root->name = strdup("root");
+    root->fullName = strdup("root");
+    char name[RBUS_MAX_NAME_LENGTH];
+    char alias[32];
+    int i;
+
+    insertElem(root, "Device.Foo.Table1.{i}.", RBUS_ELEMENT_TYPE_TABLE);
+    insertElem(root, "Device.Foo.Table1.{i}.Prop1", RBUS_ELEMENT_TYPE_PROPERTY);
+
+    //enough rows to force the index to grow a few times
+    for(i = 1; i <= 500; ++i)
+    {
+        snprintf(alias, sizeof(alias), "row%d", i);
+        addRow(root, "Device.Foo.Table1.", i, alias);
+    }
+
+    //properties registered after the rows exist get replicated into every row
+    insertElem(root, "Device.Foo.Table1.{i}.Prop2", RBUS_ELEMENT_TYPE_PROPERTY);
+
+    for(i = 1; i <= 500; ++i)
+    {
+        snprintf(name, sizeof(name), "Device.Foo.Table1.%d.Prop2", i);
+        EXPECT_EQ(testRetrieveInstanceElement(root, name, name),1);
+        snprintf(name, sizeof(name), "Device.Foo.Table1.[row%d].Prop1", i);
+        snprintf(alias, sizeof(alias), "Device.Foo.Table1.%d.Prop1", i);
+        EXPECT_EQ(testRetrieveInstanceElement(root, name, alias),1);
+    }
+
+    //deleted rows must drop out of the index, both by number and by alias
+    delRow(root, "Device.Foo.Table1.250");
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.250.Prop1", NULL),1);
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.[row250]", NULL),1);
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.[row251]", "Device.Foo.Table1.251"),1);
+
+    //a row can be added back under the same number with a new alias
+    addRow(root, "Device.Foo.Table1.", 250, "again");
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.[again].Prop2", "Device.Foo.Table1.250.Prop2"),1);
+    EXPECT_EQ(testRetrieveElement(root, "Device.Foo.Table1.250.Prop2", "Device.Foo.Table1.{i}.Prop2"),1);
+
+    removeElem(root, "Device.Foo.Table1.{i}.Prop2");
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.1.Prop2", NULL),1);
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.1.Prop1", "Device.Foo.Table1.1.Prop1"),1);
+
+    freeElementNode(root);
+}
+
+TEST(rbusElementTest, testElementMaterialize)
+{
+    elementNode* root = getEmptyElementNode();
+    root->name = strdup("root");
+    root->fullName = strdup("root");
+    elementNode* row;
+
+    insertElem(root, "Device.Foo.Table1.{i}.", RBUS_ELEMENT_TYPE_TABLE);
+    insertElem(root, "Device.Foo.Table1.{i}.Prop1", RBUS_ELEMENT_TYPE_PROPERTY);
+    insertElem(root, "Device.Foo.Table1.{i}.Table2.{i}.", RBUS_ELEMENT_TYPE_TABLE);
+    insertElem(root, "Device.Foo.Table1.{i}.Table2.{i}.Prop2", RBUS_ELEMENT_TYPE_PROPERTY);
+
+    addRow(root, "Device.Foo.Table1.", 1, "first");
+    row = lookupInstanceElement(root, "Device.Foo.Table1.1");
+    ASSERT_NE(nullptr, row);
+    EXPECT_TRUE(row->virtualRow);
+
+    //lookups resolve under a virtual row to the row template without copying it
+    EXPECT_EQ(isElementValid(lookupInstanceElement(root, "Device.Foo.Table1.1.Prop1"), "Device.Foo.Table1.{i}.Prop1"),1);
+    EXPECT_TRUE(row->virtualRow);
+    EXPECT_TRUE(isRowTemplateElement(lookupInstanceElement(root, "Device.Foo.Table1.1.Prop1")));
+
+    //retrieving materializes the row, found again by the name or alias it was reached by
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.[first].Prop1", "Device.Foo.Table1.1.Prop1"),1);
+    EXPECT_FALSE(row->virtualRow);
+    EXPECT_FALSE(isRowTemplateElement(lookupInstanceElement(root, "Device.Foo.Table1.1.Prop1")));
+
+    //a nested row is materialized through its materialized parent
+    addRow(root, "Device.Foo.Table1.1.Table2.", 7, NULL);
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.1.Table2.7.Prop2", "Device.Foo.Table1.1.Table2.7.Prop2"),1);
+
+    //rows deleted before they're retrieved are simply not found
+    addRow(root, "Device.Foo.Table1.", 2, NULL);
+    delRow(root, "Device.Foo.Table1.2");
+    EXPECT_EQ(testRetrieveInstanceElement(root, "Device.Foo.Table1.2.Prop1", NULL),1);
+
+    freeElementNode(root);
+}
@@ -46,6 +46,11 @@ static void exec_func_test(rbusGtest_t test)
       runtime = 15;
       break;
     }
+    case RBUS_GTEST_INTERVAL_SUB1:
+    {
+      runtime = 6;
+      break;
+    }
     default:
     {
       runtime = 3;
@@ -78,6 +83,8 @@ static void exec_func_test(rbusGtest_t test)
       case RBUS_GTEST_GET22:
       case RBUS_GTEST_GET23:
       case RBUS_GTEST_GET24:
+      case RBUS_GTEST_TABLE_ROWS2:
+      case RBUS_GTEST_GET_PAGE3:
         ret = rbuscoreProvider(test, pid, &consumer_status);
         break;
       case RBUS_GTEST_ASYNC_SUB5:
@@ -182,6 +189,29 @@ TEST(rbusApiGetExt, test2)
     wait(NULL);
 }
 
+TEST(rbusApiGetExt, test3)
+{
+  int j = 0;
+  pid_t pid_arr[3];
+  for(j = 0 ; j < 3 ; j++ )
+  {
+    pid_arr[j] = fork();
+
+    if (0 == pid_arr[j]) {
+      int ret = 0;
+      ret = rbusMultiProvider(j);
+
+      exit(ret);
+    } else {
+      int ret = 0;
+      ret = rbusConsumer(RBUS_GTEST_GET_EXT3, pid_arr[j], 0);
+    }
+  }
+
+  for(j = 0 ; j < 3 ; j++ )
+    wait(NULL);
+}
+
 TEST(rbusApiGet, test1)
 {
   exec_func_test(RBUS_GTEST_GET1);
@@ -511,3 +541,96 @@ TEST(rbusUnRegRowTest, test)
 {
   exec_func_test(RBUS_GTEST_UNREG_ROW);
 }
+
+TEST(rbusTableRowsTest, oldConsumerNewProvider)
+{
+  exec_func_test(RBUS_GTEST_TABLE_ROWS1);
+}
+
+TEST(rbusTableRowsTest, newConsumerOldProvider)
+{
+  exec_func_test(RBUS_GTEST_TABLE_ROWS2);
+}
+
+TEST(rbusIntervalSubTest, sampleUntilDuration)
+{
+  exec_func_test(RBUS_GTEST_INTERVAL_SUB1);
+}
+
+TEST(rbusEventBatchTest, publishBatch)
+{
+  exec_func_test(RBUS_GTEST_EVENT_BATCH1);
+}
+
+TEST(rbusTableRowsTest, wildcardMatchesNewRows)
+{
+  exec_func_test(RBUS_GTEST_TABLE_ROWS3);
+}
+
+TEST(rbusTableRowsTest, registerRows)
+{
+  exec_func_test(RBUS_GTEST_TABLE_ROWS4);
+}
+
+TEST(rbusApiValueCache, ttlAndCoherence)
+{
+  exec_func_test(RBUS_GTEST_VALUE_CACHE1);
+}
+
+TEST(rbusApiAsync, getAndSet)
+{
+  exec_func_test(RBUS_GTEST_ASYNC_GETSET1);
+}
+
+TEST(rbusApiGetPage, tableGetHandler)
+{
+  exec_func_test(RBUS_GTEST_GET_PAGE1);
+}
+
+TEST(rbusApiGetPage, multipleDestinations)
+{
+  int j = 0;
+  pid_t pid_arr[3];
+  for(j = 0 ; j < 3 ; j++ )
+  {
+    pid_arr[j] = fork();
+
+    if (0 == pid_arr[j]) {
+      int ret = 0;
+      ret = rbusMultiProvider(j);
+
+      exit(ret);
+    } else {
+      int ret = 0;
+      ret = rbusConsumer(RBUS_GTEST_GET_PAGE2, pid_arr[j], 0);
+    }
+  }
+
+  for(j = 0 ; j < 3 ; j++ )
+    wait(NULL);
+}
+
+TEST(rbusApiGetPage, legacyProvider)
+{
+  exec_func_test(RBUS_GTEST_GET_PAGE3);
+}
+
+TEST(rbusApiMultiHandler, get)
+{
+  exec_func_test(RBUS_GTEST_GET_MULTI_HANDLER1);
+}
+
+TEST(rbusApiMultiHandler, set)
+{
+  exec_func_test(RBUS_GTEST_SET_MULTI_HANDLER1);
+}
+
+TEST(rbusValueChangeTest, notifyAndPolling)
+{
+  exec_func_test(RBUS_GTEST_VALUE_CHANGE_NOTIFY1);
+}
+
+TEST(rbusValueChangeTest, subscriberPeriod)
+{
+  exec_func_test(RBUS_GTEST_VALUE_CHANGE_PERIOD1);
+}
@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include <rbus.h>
+#include "../src/rbus_buffer.h"
 TEST(rbusObjectTestName, testName1)
 {
   rbusObject_t obj;
@@ -338,3 +339,53 @@ TEST(rbusObjectTest, testFwrite)
   EXPECT_NE(strstr(stream_buf,"ptr_gTestObject"), nullptr);
 }
 
+
+TEST(rbusObjectTest, testEncodeDecode)
+{
+  rbusObject_t obj, obj_ch1, obj_ch2, decoded = NULL, child;
+  rbusValue_t val;
+  rbusBuffer_t buff;
+  int count = 0;
+
+  rbusValue_Init(&val);
+  rbusValue_SetString(val, "ptr_string");
+  rbusObject_Init(&obj, "ptr_gTestObject");
+  rbusObject_SetValue(obj, "ptr_gTestProp", val);
+  rbusValue_Release(val);
+
+  rbusValue_Init(&val);
+  rbusValue_SetInt32(val, 7);
+  rbusObject_Init(&obj_ch1, "ch1_gTestObject");
+  rbusObject_SetValue(obj_ch1, "ch1_gTestProp", val);
+  rbusValue_Release(val);
+
+  rbusValue_Init(&val);
+  rbusValue_SetInt32(val, 8);
+  rbusObject_Init(&obj_ch2, "ch2_gTestObject");
+  rbusObject_SetValue(obj_ch2, "ch2_gTestProp", val);
+  rbusValue_Release(val);
+
+  rbusObject_SetChildren(obj, obj_ch1);
+  rbusObject_SetNext(obj_ch1, obj_ch2);
+
+  rbusBuffer_Create(&buff);
+  EXPECT_EQ(rbusObject_Encode(obj, buff), 0);
+  EXPECT_EQ(rbusObject_Decode(&decoded, buff), 0);
+  EXPECT_EQ(buff->posRead, buff->posWrite);
+  rbusBuffer_Destroy(buff);
+
+  EXPECT_EQ(rbusObject_Compare(obj, decoded, true), 0);
+
+  /*decoded children must point back at the decoded parent*/
+  for(child = rbusObject_GetChildren(decoded); child; child = rbusObject_GetNext(child))
+  {
+    EXPECT_EQ(rbusObject_GetParent(child), decoded);
+    count++;
+  }
+  EXPECT_EQ(count, 2);
+
+  rbusObject_Release(decoded);
+  rbusObject_Release(obj_ch2);
+  rbusObject_Release(obj_ch1);
+  rbusObject_Release(obj);
+}
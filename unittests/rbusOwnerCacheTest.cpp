@@ -0,0 +1,115 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/rbus_ownercache.h"
+
+/*the cache is process wide and the functional tests use it too, so each test starts it empty*/
+
+/*the cached owner of name, or "" if there is none*/
+static char const* lookup(char const* name)
+{
+  static char owner[64];
+  char const* names[1] = {name};
+  char* owners[1];
+
+  owner[0] = 0;
+  if(rbusOwnerCache_Lookup(1, names, owners) == 1)
+  {
+    snprintf(owner, sizeof(owner), "%s", owners[0]);
+    free(owners[0]);
+  }
+  return owner;
+}
+
+TEST(rbusOwnerCacheTest, addAndLookup)
+{
+  char const* names[3] = {"Device.A.Param1", "Device.B.Param1", "Device.A.Param2"};
+  char* owners[3];
+
+  rbusOwnerCache_Clear();
+  rbusOwnerCache_Add("Device.A.Param1", "compA");
+  rbusOwnerCache_Add("Device.A.Param2", "compA");
+
+  EXPECT_EQ(rbusOwnerCache_Lookup(3, names, owners), 2);
+  EXPECT_STREQ(owners[0], "compA");
+  EXPECT_EQ(owners[1], (char*)NULL);
+  EXPECT_STREQ(owners[2], "compA");
+  free(owners[0]);
+  free(owners[2]);
+
+  /*names are whole, not prefixes*/
+  EXPECT_STREQ(lookup("Device.A."), "");
+  EXPECT_STREQ(lookup("Device.A.Param10"), "");
+
+  /*adding a name again moves it to its new owner*/
+  rbusOwnerCache_Add("Device.A.Param1", "compB");
+  EXPECT_STREQ(lookup("Device.A.Param1"), "compB");
+  EXPECT_STREQ(lookup("Device.A.Param2"), "compA");
+
+  rbusOwnerCache_Clear();
+}
+
+TEST(rbusOwnerCacheTest, remove)
+{
+  rbusOwnerCache_Clear();
+  rbusOwnerCache_Add("Device.A.Param1", "compA");
+  rbusOwnerCache_Add("Device.A.Param2", "compA");
+  rbusOwnerCache_Add("Device.B.Param1", "compB");
+
+  rbusOwnerCache_Remove("Device.A.Param1");
+  rbusOwnerCache_Remove("Device.C.Param1");
+  EXPECT_STREQ(lookup("Device.A.Param1"), "");
+  EXPECT_STREQ(lookup("Device.A.Param2"), "compA");
+
+  rbusOwnerCache_RemoveOwner("compA");
+  EXPECT_STREQ(lookup("Device.A.Param2"), "");
+  EXPECT_STREQ(lookup("Device.B.Param1"), "compB");
+
+  rbusOwnerCache_Clear();
+  EXPECT_STREQ(lookup("Device.B.Param1"), "");
+}
+
+TEST(rbusOwnerCacheTest, full)
+{
+  char name[64];
+  int i, cached = 0;
+
+  rbusOwnerCache_Clear();
+
+  /*when full it starts over, so it holds at most 4096 names and always the newest*/
+  for(i = 0; i < 5000; i++)
+  {
+    snprintf(name, sizeof(name), "Device.A.%d", i);
+    rbusOwnerCache_Add(name, "compA");
+    EXPECT_STREQ(lookup(name), "compA");
+  }
+  for(i = 0; i < 5000; i++)
+  {
+    snprintf(name, sizeof(name), "Device.A.%d", i);
+    if(strcmp(lookup(name), "compA") == 0)
+      cached++;
+  }
+  EXPECT_EQ(cached, 5000 - 4096);
+
+  rbusOwnerCache_Clear();
+}
@@ -0,0 +1,142 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+
+#include <pthread.h>
+#include <string.h>
+#include "../src/rbus_pool.h"
+
+static bool is_zeroed(void* p, size_t len)
+{
+  size_t i;
+  for(i = 0; i < len; i++)
+  {
+    if(((unsigned char*)p)[i] != 0)
+      return false;
+  }
+  return true;
+}
+
+TEST(rbusPoolTest, reuseZeroed)
+{
+  void *p1, *p2;
+
+  p1 = rbusPool_Alloc(RBUS_POOL_VALUE, 96);
+  EXPECT_TRUE(is_zeroed(p1, 96));
+  memset(p1, 0xa5, 96);
+  rbusPool_Free(RBUS_POOL_VALUE, p1);
+
+  /*the block comes back off this thread's free list and must be zeroed again*/
+  p2 = rbusPool_Alloc(RBUS_POOL_VALUE, 96);
+  EXPECT_EQ(p1, p2);
+  EXPECT_TRUE(is_zeroed(p2, 96));
+  rbusPool_Free(RBUS_POOL_VALUE, p2);
+}
+
+static void* free_on_thread(void* p)
+{
+  void** blocks = (void**)p;
+
+  rbusPool_Free(RBUS_POOL_PROPERTY, blocks[0]);
+  rbusPool_Free(RBUS_POOL_PROPERTY, blocks[1]);
+  rbusPool_FreeString((char*)blocks[2]);
+  return NULL;
+}
+
+TEST(rbusPoolTest, freeOnOtherThread)
+{
+  void* blocks[3];
+  rbusArena_t arena;
+  pthread_t thread;
+  int base = rbusArena_LiveChunks();
+
+  blocks[0] = rbusPool_Alloc(RBUS_POOL_PROPERTY, 64);
+  rbusArena_Begin(&arena);
+  blocks[1] = rbusPool_Alloc(RBUS_POOL_PROPERTY, 64);
+  blocks[2] = rbusPool_StrDup("Device.Test.Name");
+  rbusArena_End(arena);
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+
+  /*heap blocks move to the other thread's free list and arena blocks release their chunk*/
+  ASSERT_EQ(pthread_create(&thread, NULL, free_on_thread, blocks), 0);
+  pthread_join(thread, NULL);
+  EXPECT_EQ(rbusArena_LiveChunks(), base);
+}
+
+TEST(rbusPoolTest, chunkReleasedAfterLastBlockAndEnd)
+{
+  void *p1, *p2;
+  char* s;
+  rbusArena_t arena;
+  int base = rbusArena_LiveChunks();
+
+  rbusArena_Begin(&arena);
+  p1 = rbusPool_Alloc(RBUS_POOL_OBJECT, 64);
+  p2 = rbusPool_Alloc(RBUS_POOL_OBJECT, 64);
+  s = rbusPool_StrDup("name");
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+
+  /*freeing every block keeps the chunk while the arena still carves from it*/
+  rbusPool_Free(RBUS_POOL_OBJECT, p1);
+  rbusPool_Free(RBUS_POOL_OBJECT, p2);
+  rbusPool_FreeString(s);
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+  rbusArena_End(arena);
+  EXPECT_EQ(rbusArena_LiveChunks(), base);
+
+  /*blocks outliving the arena keep the chunk until the last of them is freed*/
+  rbusArena_Begin(&arena);
+  p1 = rbusPool_Alloc(RBUS_POOL_OBJECT, 64);
+  p2 = rbusPool_Alloc(RBUS_POOL_OBJECT, 64);
+  rbusArena_End(arena);
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+  memset(p1, 0xa5, 64);
+  rbusPool_Free(RBUS_POOL_OBJECT, p1);
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+  rbusPool_Free(RBUS_POOL_OBJECT, p2);
+  EXPECT_EQ(rbusArena_LiveChunks(), base);
+}
+
+TEST(rbusPoolTest, oversizeFromHeap)
+{
+  char *s1, *s2;
+  char name[2048];
+  rbusArena_t arena;
+  int base = rbusArena_LiveChunks();
+
+  memset(name, 'x', sizeof(name) - 1);
+  name[sizeof(name) - 1] = 0;
+
+  rbusArena_Begin(&arena);
+  s1 = rbusPool_StrDup(name);
+  EXPECT_STREQ(s1, name);
+
+  /*too big to carve, so no chunk was allocated*/
+  EXPECT_EQ(rbusArena_LiveChunks(), base);
+  s2 = rbusPool_StrDup("short");
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+  rbusArena_End(arena);
+
+  /*the heap string stays valid after the arena ends and is freed on its own*/
+  EXPECT_STREQ(s1, name);
+  rbusPool_FreeString(s1);
+  EXPECT_EQ(rbusArena_LiveChunks(), base + 1);
+  rbusPool_FreeString(s2);
+  EXPECT_EQ(rbusArena_LiveChunks(), base);
+}
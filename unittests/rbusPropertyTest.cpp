@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include <rbus.h>
+#include "../src/rbus_buffer.h"
 
 TEST(rbusPropertyTest, testName)
 {
@@ -249,3 +250,35 @@ TEST(rbusPropertyTest, testFwrite)
   pRet += strlen("value:");
   EXPECT_EQ(strncmp(pRet,"test1",strlen("test1")),0);
 }
+
+TEST(rbusPropertyTest, testEncodeDecodeList)
+{
+  rbusProperty_t first, prop, decoded = NULL;
+  rbusValue_t value;
+  rbusBuffer_t buff;
+
+  rbusValue_Init(&value);
+  rbusValue_SetString(value, "test1");
+  rbusProperty_Init(&first, "Device.rbusPropertyTest1", value);
+  rbusValue_Release(value);
+
+  rbusValue_Init(&value);
+  rbusValue_SetUInt32(value, 42);
+  rbusProperty_Init(&prop, "Device.rbusPropertyTest2", value);
+  rbusValue_Release(value);
+  rbusProperty_Append(first, prop);
+  rbusProperty_Release(prop);
+
+  rbusBuffer_Create(&buff);
+  EXPECT_EQ(rbusPropertyList_Encode(first, buff), 0);
+  EXPECT_EQ(rbusPropertyList_Decode(&decoded, buff), 0);
+  EXPECT_EQ(buff->posRead, buff->posWrite);
+  rbusBuffer_Destroy(buff);
+
+  EXPECT_EQ(rbusProperty_Count(decoded), 2);
+  EXPECT_EQ(rbusProperty_Compare(first, decoded), 0);
+  EXPECT_EQ(rbusProperty_Compare(rbusProperty_GetNext(first), rbusProperty_GetNext(decoded)), 0);
+
+  rbusProperty_Release(decoded);
+  rbusProperty_Release(first);
+}
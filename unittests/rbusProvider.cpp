@@ -128,6 +128,142 @@ rbusError_t getVCHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHa
   return RBUS_ERROR_SUCCESS;
 }
 
+static rbusError_t publishEvent(rbusHandle_t handle, rbusEventType_t type, char const* name, int32_t val, int32_t oldVal)
+{
+  rbusError_t rc;
+  rbusEvent_t event = {0};
+  rbusObject_t data;
+  rbusValue_t value;
+
+  rbusObject_Init(&data, NULL);
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, val);
+  rbusObject_SetValue(data, "value", value);
+  if(type == RBUS_EVENT_VALUE_CHANGED)
+  {
+    rbusValue_SetInt32(value, oldVal);
+    rbusObject_SetValue(data, "oldValue", value);
+  }
+  rbusValue_Release(value);
+
+  event.name = name;
+  event.type = type;
+  event.data = data;
+  rc = rbusEvent_Publish(handle, &event);
+  rbusObject_Release(data);
+  return rc;
+}
+
+/*queued with batching on until the flush, so the consumer gets them all in one message*/
+static rbusError_t publishBatch(rbusHandle_t handle)
+{
+  rbusError_t rc = RBUS_ERROR_SUCCESS;
+  int i;
+
+  for(i = 0; i < 5; i++)
+    rc = (rbusError_t)(rc | publishEvent(handle, RBUS_EVENT_GENERAL, "Device.rbusProvider.Event1!", i, 0));
+
+  /*coalesced into a single value-change from 0 to 3*/
+  for(i = 1; i <= 3; i++)
+    rc = (rbusError_t)(rc | publishEvent(handle, RBUS_EVENT_VALUE_CHANGED, "Device.rbusProvider.Event1!", i, i-1));
+
+  rc = (rbusError_t)(rc | rbusEvent_FlushPublishBatch(handle));
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  return rc;
+}
+
+/*rows registered after the consumer's wildcard subscription, which has to start matching them*/
+static rbusError_t registerRowEvents(rbusHandle_t handle)
+{
+  rbusError_t rc = RBUS_ERROR_SUCCESS;
+  char eventName[64];
+  uint32_t i;
+
+  for(i = 1; i <= 3; i++)
+    rc = (rbusError_t)(rc | rbusTable_registerRow(handle, "Device.rbusProvider.Rows", i, NULL));
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+
+  for(i = 1; i <= 3; i++)
+  {
+    snprintf(eventName, sizeof(eventName), "Device.rbusProvider.Rows.%u.Event1!", i);
+    rc = (rbusError_t)(rc | publishEvent(handle, RBUS_EVENT_GENERAL, eventName, (int32_t)i, 0));
+  }
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  return rc;
+}
+
+static rbusError_t registerRows(rbusHandle_t handle)
+{
+  rbusError_t rc;
+  uint32_t instNums[4] = {1, 2, 3, 4};
+  char const* aliasNames[4] = {"one", NULL, "three", NULL};
+  uint32_t takenNums[2] = {4, 5};
+  char const* takenAliases[2] = {NULL, "one"};
+
+  rc = rbusTable_registerRows(handle, "Device.rbusProvider.Rows", 4, instNums, aliasNames);
+  EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  if(RBUS_ERROR_SUCCESS != rc) return rc;
+
+  /*a taken instance number or alias skips just that row*/
+  rc = rbusTable_registerRows(handle, "Device.rbusProvider.Rows", 2, takenNums, takenAliases);
+  EXPECT_EQ(rc,RBUS_ERROR_INVALID_INPUT);
+  return (RBUS_ERROR_INVALID_INPUT == rc) ? RBUS_ERROR_SUCCESS : RBUS_ERROR_BUS_ERROR;
+}
+
+static rbusError_t unregisterRows(rbusHandle_t handle)
+{
+  rbusError_t rc;
+  /*by number, by alias with a trailing dot, and one that doesn't exist*/
+  char const* rowNames[3] = {"Device.rbusProvider.Rows.2", "Device.rbusProvider.Rows.[three].", "Device.rbusProvider.Rows.9"};
+
+  rc = rbusTable_unregisterRows(handle, 3, rowNames);
+  EXPECT_EQ(rc,RBUS_ERROR_INVALID_INPUT);
+  return (RBUS_ERROR_INVALID_INPUT == rc) ? RBUS_ERROR_SUCCESS : RBUS_ERROR_BUS_ERROR;
+}
+
+/*Device.rbusProvider.Notified only changes when the consumer asks, and is never polled unless it asks for that too*/
+static int32_t notifiedValue = 0;
+
+/*the gets of Device.rbusProvider.Polled since Device.rbusProvider.PollCount was last read*/
+static int32_t polledGets = 0;
+
+static void setInt32Value(rbusProperty_t property, int32_t i)
+{
+  rbusValue_t value;
+
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, i);
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+}
+
+rbusError_t notifiedGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+  setInt32Value(property, notifiedValue);
+  return RBUS_ERROR_SUCCESS;
+}
+
+/*never changes, so value-change polling is the only thing calling it*/
+rbusError_t polledGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+  polledGets++;
+  setInt32Value(property, 1);
+  return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t pollCountGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+  setInt32Value(property, polledGets);
+  polledGets = 0;
+  return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t setHandler(rbusHandle_t handle, rbusProperty_t property, rbusSetHandlerOptions_t* opts)
 {
   (void)handle;
@@ -153,12 +289,55 @@ rbusError_t setHandler(rbusHandle_t handle, rbusProperty_t property, rbusSetHand
   } else if(strcmp(val,"unregister_row_fail") == 0) {
     rc = rbusTable_unregisterRow(handle, "Device.rbusProvider.PartialPath123");
     EXPECT_EQ(rc,RBUS_ERROR_INVALID_INPUT);
+  } else if(strcmp(val,"publish_batch") == 0) {
+    rc = publishBatch(handle);
+  } else if(strcmp(val,"register_row_events") == 0) {
+    rc = registerRowEvents(handle);
+  } else if(strcmp(val,"register_rows") == 0) {
+    rc = registerRows(handle);
+  } else if(strcmp(val,"unregister_rows") == 0) {
+    rc = unregisterRows(handle);
+  } else if(strcmp(val,"change_notified") == 0) {
+    notifiedValue++;
+    rc = rbusEvent_NotifyValueChanged(handle, "Device.rbusProvider.Notified");
+  } else if(strcmp(val,"change_notified_silently") == 0) {
+    notifiedValue++;
+  } else if(strcmp(val,"poll_notified") == 0) {
+    rc = rbusEvent_SetValueChangePolling(handle, "Device.rbusProvider.Notified", true);
   }
 
   free(val);
   return rc;
 }
 
+rbusError_t rowParamGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+  rbusValue_t value;
+
+  rbusValue_Init(&value);
+  rbusValue_SetString(value, rbusProperty_GetName(property));
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+  return RBUS_ERROR_SUCCESS;
+}
+
+/*a new value on every get, so the consumer can tell a cached value from a fresh one*/
+rbusError_t counterGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+  static int32_t counter = 0;
+  rbusValue_t value;
+
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, ++counter);
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+  return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t ppTableGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
 {
   char const* name = rbusProperty_GetName(property);
@@ -201,6 +380,25 @@ rbusError_t ppTableRemRowHandler(
   return RBUS_ERROR_SUCCESS;
 }
 
+rbusError_t ppTableRemRowsHandler(
+    rbusHandle_t handle,
+    char const* tableName,
+    int numRows,
+    char const* const* rowNames,
+    rbusError_t* results)
+{
+  (void)handle;
+  (void)rowNames;
+  (void)results;
+
+  printf("ppTableRemRowsHandler table=%s numRows=%d\n", tableName, numRows);
+
+  /*row names which end in a dot or are aliases must still give the table name*/
+  if(strcmp(tableName, "Device.rbusProvider.PartialPath."))
+    return RBUS_ERROR_INVALID_INPUT;
+  return RBUS_ERROR_SUCCESS;
+}
+
 rbusError_t ppParamGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
 {
   rbusValue_t value;
@@ -234,6 +432,169 @@ rbusError_t ppParamGetHandler(rbusHandle_t handle, rbusProperty_t property, rbus
   }
 }
 
+/*returns all the rows at once, the way a table getHandler can*/
+rbusError_t pageTableGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  char name[64];
+  rbusProperty_t row;
+  rbusValue_t value;
+  int i;
+
+  (void)handle;
+  (void)opts;
+
+  printf("pageTableGetHandler called: property=%s\n", rbusProperty_GetName(property));
+
+  for(i = 1; i <= 5; i++)
+  {
+    snprintf(name, sizeof(name), "Device.rbusProvider.PageTable.%d.Param1", i);
+    rbusValue_Init(&value);
+    rbusValue_SetString(value, name);
+    rbusProperty_Init(&row, name, value);
+    rbusProperty_Append(property, row);
+    rbusProperty_Release(row);
+    rbusValue_Release(value);
+  }
+  return RBUS_ERROR_SUCCESS;
+}
+
+/*the multi handler calls since Device.rbusProvider.MultiStats was last read*/
+static int multiGets = 0;
+static int multiGetProps = 0;
+static int multiSingleGets = 0;
+static int multiSets = 0;
+static int multiSetProps = 0;
+static int multiCommits = 0;
+
+/*the values set through the multi set handler; the others read back as their names*/
+static struct
+{
+  char name[64];
+  char value[64];
+} multiValues[8];
+static int numMultiValues = 0;
+
+static void setMultiValue(rbusProperty_t property)
+{
+  char const* name = rbusProperty_GetName(property);
+  rbusValue_t value;
+  int i;
+
+  for(i = 0; i < numMultiValues; i++)
+  {
+    if(strcmp(multiValues[i].name, name) == 0)
+    {
+      name = multiValues[i].value;
+      break;
+    }
+  }
+
+  rbusValue_Init(&value);
+  rbusValue_SetString(value, name);
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+}
+
+/*leaves Param4 without a value, so it falls back to its own getHandler*/
+rbusError_t multiGetHandler(rbusHandle_t handle, int numProps, rbusProperty_t* properties, rbusGetHandlerOptions_t* opts)
+{
+  int i;
+
+  (void)handle;
+  (void)opts;
+
+  printf("multiGetHandler called: numProps=%d\n", numProps);
+
+  multiGets++;
+  multiGetProps += numProps;
+  for(i = 0; i < numProps; i++)
+  {
+    if(strcmp(rbusProperty_GetName(properties[i]), "Device.rbusProvider.Multi.Param4"))
+      setMultiValue(properties[i]);
+  }
+  return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t multiParamGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  (void)handle;
+  (void)opts;
+
+  printf("multiParamGetHandler called: property=%s\n", rbusProperty_GetName(property));
+
+  multiSingleGets++;
+  setMultiValue(property);
+  return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t multiSetHandler(rbusHandle_t handle, int numProps, rbusProperty_t* properties, rbusSetHandlerOptions_t* opts)
+{
+  int i, j;
+
+  (void)handle;
+
+  printf("multiSetHandler called: numProps=%d commit=%d\n", numProps, opts->commit);
+
+  multiSets++;
+  multiSetProps += numProps;
+  if(opts->commit)
+    multiCommits++;
+  for(i = 0; i < numProps; i++)
+  {
+    char const* name = rbusProperty_GetName(properties[i]);
+    char* value = rbusValue_ToString(rbusProperty_GetValue(properties[i]), NULL, 0);
+
+    for(j = 0; j < numMultiValues; j++)
+      if(strcmp(multiValues[j].name, name) == 0)
+        break;
+    if(j < 8)
+    {
+      snprintf(multiValues[j].name, sizeof(multiValues[j].name), "%s", name);
+      snprintf(multiValues[j].value, sizeof(multiValues[j].value), "%s", value);
+      if(j == numMultiValues)
+        numMultiValues++;
+    }
+    free(value);
+  }
+  return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t multiSetStatsGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  char stats[128];
+  rbusValue_t value;
+
+  (void)handle;
+  (void)opts;
+
+  snprintf(stats, sizeof(stats), "sets=%d props=%d commits=%d", multiSets, multiSetProps, multiCommits);
+  multiSets = multiSetProps = multiCommits = 0;
+
+  rbusValue_Init(&value);
+  rbusValue_SetString(value, stats);
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+  return RBUS_ERROR_SUCCESS;
+}
+
+rbusError_t multiStatsGetHandler(rbusHandle_t handle, rbusProperty_t property, rbusGetHandlerOptions_t* opts)
+{
+  char stats[128];
+  rbusValue_t value;
+
+  (void)handle;
+  (void)opts;
+
+  snprintf(stats, sizeof(stats), "gets=%d props=%d singles=%d", multiGets, multiGetProps, multiSingleGets);
+  multiGets = multiGetProps = multiSingleGets = 0;
+
+  rbusValue_Init(&value);
+  rbusValue_SetString(value, stats);
+  rbusProperty_SetValue(property, value);
+  rbusValue_Release(value);
+  return RBUS_ERROR_SUCCESS;
+}
+
 static void* asyncMethodFunc(void *p)
 {
     MethodData* data;
@@ -373,6 +734,42 @@ int rbusProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
     {(char *)"Device.rbusProvider.MethodAsync_2()", RBUS_ELEMENT_TYPE_METHOD, {NULL, NULL, NULL, NULL, NULL, methodHandler}}
   };
 #define elements_count sizeof(dataElements)/sizeof(dataElements[0])
+  rbusDataElement_t eventElements[] = {
+    {(char *)"Device.rbusProvider.Event1!", RBUS_ELEMENT_TYPE_EVENT, {NULL, NULL, NULL, NULL, NULL, NULL}}
+  };
+  rbusDataElement_t rowElements[] = {
+    {(char *)"Device.rbusProvider.Rows.{i}.", RBUS_ELEMENT_TYPE_TABLE, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Rows.{i}.Param1", RBUS_ELEMENT_TYPE_PROPERTY, {rowParamGetHandler, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Rows.{i}.Event1!", RBUS_ELEMENT_TYPE_EVENT, {NULL, NULL, NULL, NULL, NULL, NULL}}
+  };
+#define row_elements_count sizeof(rowElements)/sizeof(rowElements[0])
+  rbusDataElement_t counterElements[] = {
+    {(char *)"Device.rbusProvider.Counter", RBUS_ELEMENT_TYPE_PROPERTY, {counterGetHandler, NULL, NULL, NULL, NULL, NULL}}
+  };
+  rbusDataElement_t valueChangeElements[] = {
+    {(char *)"Device.rbusProvider.Notified", RBUS_ELEMENT_TYPE_PROPERTY, {notifiedGetHandler, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Polled", RBUS_ELEMENT_TYPE_PROPERTY, {polledGetHandler, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.PollCount", RBUS_ELEMENT_TYPE_PROPERTY, {pollCountGetHandler, NULL, NULL, NULL, NULL, NULL}}
+  };
+#define value_change_elements_count sizeof(valueChangeElements)/sizeof(valueChangeElements[0])
+  rbusDataElement_t pageElements[] = {
+    {(char *)"Device.rbusProvider.PageTable.{i}.", RBUS_ELEMENT_TYPE_TABLE, {pageTableGetHandler, NULL, NULL, NULL, NULL, NULL}}
+  };
+  rbusDataElement_t multiElements[] = {
+    {(char *)"Device.rbusProvider.Multi.Param1", RBUS_ELEMENT_TYPE_PROPERTY, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Multi.Param2", RBUS_ELEMENT_TYPE_PROPERTY, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Multi.Param3", RBUS_ELEMENT_TYPE_PROPERTY, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Multi.Param4", RBUS_ELEMENT_TYPE_PROPERTY, {multiParamGetHandler, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.MultiStats", RBUS_ELEMENT_TYPE_PROPERTY, {multiStatsGetHandler, NULL, NULL, NULL, NULL, NULL}}
+  };
+#define multi_elements_count sizeof(multiElements)/sizeof(multiElements[0])
+  rbusDataElement_t multiSetElements[] = {
+    {(char *)"Device.rbusProvider.Multi.Table.{i}.", RBUS_ELEMENT_TYPE_TABLE, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.Multi.Table.{i}.Param1", RBUS_ELEMENT_TYPE_PROPERTY, {NULL, NULL, NULL, NULL, NULL, NULL}},
+    {(char *)"Device.rbusProvider.MultiSetStats", RBUS_ELEMENT_TYPE_PROPERTY, {multiSetStatsGetHandler, NULL, NULL, NULL, NULL, NULL}}
+  };
+#define multi_set_elements_count sizeof(multiSetElements)/sizeof(multiSetElements[0])
+  char const* rowNames[] = {"Device.rbusProvider.Rows.1", "Device.rbusProvider.Rows.2", "Device.rbusProvider.Rows.3", "Device.rbusProvider.Rows.4"};
 
   componentName = strdup(__func__);
   printf("%s: start\n",componentName);
@@ -388,6 +785,61 @@ int rbusProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
   EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
   if(RBUS_ERROR_SUCCESS != rc) goto exit1;
 
+  if(RBUS_GTEST_TABLE_ROWS1 == test)
+  {
+    rc = rbusTable_setRowsHandlers(handle, "Device.rbusProvider.PartialPath.", NULL, ppTableRemRowsHandler);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_EVENT_BATCH1 == test)
+  {
+    rc = rbus_regDataElements(handle, 1, eventElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+    /*long enough that only the explicit flush sends the batch*/
+    rc |= rbusEvent_SetPublishBatching(handle, 10000, 0, true);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_TABLE_ROWS3 == test || RBUS_GTEST_TABLE_ROWS4 == test)
+  {
+    rc = rbus_regDataElements(handle, row_elements_count, rowElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_VALUE_CACHE1 == test)
+  {
+    rc = rbus_regDataElements(handle, 1, counterElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_VALUE_CHANGE_NOTIFY1 == test || RBUS_GTEST_VALUE_CHANGE_PERIOD1 == test)
+  {
+    rc = rbus_regDataElements(handle, value_change_elements_count, valueChangeElements);
+    rc |= rbusEvent_SetValueChangePolling(handle, "Device.rbusProvider.Notified", false);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_GET_PAGE1 == test)
+  {
+    rc = rbus_regDataElements(handle, 1, pageElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_GET_MULTI_HANDLER1 == test || RBUS_GTEST_SET_MULTI_HANDLER1 == test)
+  {
+    rc = rbus_regDataElements(handle, multi_elements_count, multiElements);
+    rc |= rbus_regGetMultiHandler(handle, "Device.rbusProvider.Multi.", multiGetHandler);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_SET_MULTI_HANDLER1 == test)
+  {
+    rc = rbus_regDataElements(handle, multi_set_elements_count, multiSetElements);
+    rc |= rbus_regSetMultiHandler(handle, "Device.rbusProvider.Multi.", multiSetHandler);
+    rc |= rbusTable_registerRow(handle, "Device.rbusProvider.Multi.Table.", 1, NULL);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
   if(RBUS_GTEST_GET1 == test ||
       RBUS_GTEST_GET_EXT1 == test ||
       RBUS_GTEST_SET4 == test ||
@@ -412,6 +864,51 @@ int rbusProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
     EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
   }
 
+  if(RBUS_GTEST_EVENT_BATCH1 == test)
+  {
+    rc |= rbus_unregDataElements(handle, 1, eventElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_TABLE_ROWS3 == test || RBUS_GTEST_TABLE_ROWS4 == test)
+  {
+    /*whichever rows the test left behind, any missing one is skipped*/
+    rbusTable_unregisterRows(handle, 4, rowNames);
+    rc |= rbus_unregDataElements(handle, row_elements_count, rowElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_VALUE_CACHE1 == test)
+  {
+    rc |= rbus_unregDataElements(handle, 1, counterElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_SET_MULTI_HANDLER1 == test)
+  {
+    rc |= rbusTable_unregisterRow(handle, "Device.rbusProvider.Multi.Table.1");
+    rc |= rbus_unregDataElements(handle, multi_set_elements_count, multiSetElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_GET_MULTI_HANDLER1 == test || RBUS_GTEST_SET_MULTI_HANDLER1 == test)
+  {
+    rc |= rbus_unregDataElements(handle, multi_elements_count, multiElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_VALUE_CHANGE_NOTIFY1 == test || RBUS_GTEST_VALUE_CHANGE_PERIOD1 == test)
+  {
+    rc |= rbus_unregDataElements(handle, value_change_elements_count, valueChangeElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
+  if(RBUS_GTEST_GET_PAGE1 == test)
+  {
+    rc |= rbus_unregDataElements(handle, 1, pageElements);
+    EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
+  }
+
   rc |= rbus_unregDataElements(handle, elements_count, dataElements);
   EXPECT_EQ(rc,RBUS_ERROR_SUCCESS);
 
@@ -513,6 +1010,24 @@ static int handle_get(const char * destination, const char * method, rbusMessage
 
   rbusMessage_Init(response);
 
+  /*an older provider returns every property of a partial path query and no cursor, whatever the page size*/
+  if(RBUS_GTEST_GET_PAGE3 == *test)
+  {
+    int i;
+
+    rbusMessage_SetInt32(*response, RTMESSAGE_BUS_SUCCESS);
+    rbusMessage_SetInt32(*response, 3);
+    for(i = 1; i <= 3; i++)
+    {
+      snprintf(buffer, sizeof(buffer), "Device.rbuscoreProvider.Page.Param%d", i);
+      rbusMessage_SetString(*response, buffer);
+      rbusMessage_SetInt32(*response, RBUS_LEGACY_INT);
+      snprintf(buffer, sizeof(buffer), "%d", i);
+      rbusMessage_SetString(*response, buffer);
+    }
+    return 0;
+  }
+
   rbusMessage_SetInt32(*response, RTMESSAGE_BUS_SUCCESS);
   rbusMessage_SetInt32(*response, 1);
   if(RBUS_GTEST_GET24 != *test)
@@ -579,12 +1094,37 @@ static int handle_get(const char * destination, const char * method, rbusMessage
   return 0;
 }
 
+/*an older rbus provider reads only the session id and the row name of a remove row request and returns only the result*/
+static int handle_remove_row(const char * destination, const char * method, rbusMessage message, void * user_data, rbusMessage *response, const rtMessageHeader* hdr)
+{
+  (void) destination;
+  (void) method;
+  (void) hdr;
+  int sessionId = 0;
+  char const* rowName = NULL;
+  int *numRemoved = (int *)user_data;
+
+  rbusMessage_GetInt32(message, &sessionId);
+  rbusMessage_GetString(message, &rowName);
+  printf("%s: row %s\n", __func__, rowName);
+  (*numRemoved)++;
+
+  rbusMessage_Init(response);
+  rbusMessage_SetInt32(*response, RBUS_ERROR_SUCCESS);
+  return 0;
+}
+
 int rbuscoreProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
 {
   rbus_error_t err = RTMESSAGE_BUS_ERROR_GENERAL;
   int rc = RBUS_ERROR_BUS_ERROR, wait_ret = -1;
   const char *object_name = NULL;
+  int numRemoved = 0;
+  const char *rowNames[] = {"Device.rbuscoreProvider.Table.1", "Device.rbuscoreProvider.Table.2.", "Device.rbuscoreProvider.Table.3"};
+  const char *pageNames[] = {"Device.rbuscoreProvider.Page.Param1", "Device.rbuscoreProvider.Page.Param2", "Device.rbuscoreProvider.Page.Param3"};
   rbus_method_table_entry_t table[1] = {{METHOD_GETPARAMETERVALUES, &test, handle_get}};
+  rbus_method_table_entry_t rowTable[1] = {{METHOD_DELETETBLROW, &numRemoved, handle_remove_row}};
+  int i;
 
   printf("%s: start \n",__func__);
   switch(test)
@@ -601,6 +1141,8 @@ int rbuscoreProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
     case RBUS_GTEST_GET22: object_name = "Device.rbuscoreProvider.GetLegString";   break;
     case RBUS_GTEST_GET23: object_name = "Device.rbuscoreProvider.GetLegInt32";    break;
     case RBUS_GTEST_GET24: object_name = "Device.rbuscoreProvider.GetLegCrInt32";  break;
+    case RBUS_GTEST_TABLE_ROWS2: object_name = "Device.rbuscoreProvider.Table";   break;
+    case RBUS_GTEST_GET_PAGE3: object_name = "Device.rbuscoreProvider.Page";     break;
   }
 
   err = rbus_openBrokerConnection(object_name);
@@ -611,7 +1153,18 @@ int rbuscoreProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
   EXPECT_EQ(err,RTMESSAGE_BUS_SUCCESS);
   if(RTMESSAGE_BUS_SUCCESS != err) goto exit2;
 
-  err = rbus_registerMethodTable(object_name, table, 1);
+  if(RBUS_GTEST_TABLE_ROWS2 == test)
+  {
+    err = rbus_registerMethodTable(object_name, rowTable, 1);
+    for(i = 0; i < 3 && RTMESSAGE_BUS_SUCCESS == err; i++)
+      err = rbus_addElement(object_name, rowNames[i]);
+  }
+  else
+  {
+    err = rbus_registerMethodTable(object_name, table, 1);
+    for(i = 0; i < 3 && RBUS_GTEST_GET_PAGE3 == test && RTMESSAGE_BUS_SUCCESS == err; i++)
+      err = rbus_addElement(object_name, pageNames[i]);
+  }
   EXPECT_EQ(err,RTMESSAGE_BUS_SUCCESS);
   if(RTMESSAGE_BUS_SUCCESS != err) goto exit2;
 
@@ -621,6 +1174,10 @@ int rbuscoreProvider(rbusGtest_t test, pid_t pid, int *consumer_status)
   if(wait_ret != pid) printf("%s: waitpid() failed %d: %s\n",__func__,errno,strerror(errno));
   rc = (wait_ret != pid) ? RBUS_ERROR_BUS_ERROR : RBUS_ERROR_SUCCESS;
 
+  /*the rows after the first were sent again one request at a time*/
+  if(RBUS_GTEST_TABLE_ROWS2 == test)
+    EXPECT_EQ(numRemoved,3);
+
 exit2:
   err = rbus_closeBrokerConnection();
   EXPECT_EQ(err,RTMESSAGE_BUS_SUCCESS);
@@ -60,6 +60,7 @@ typedef enum
   RBUS_GTEST_GET31,
   RBUS_GTEST_GET_EXT1,
   RBUS_GTEST_GET_EXT2,
+  RBUS_GTEST_GET_EXT3,
   RBUS_GTEST_SET1,
   RBUS_GTEST_SET2,
   RBUS_GTEST_SET3,
@@ -88,6 +89,21 @@ typedef enum
   RBUS_GTEST_METHOD_ASYNC1,
   RBUS_GTEST_REG_ROW,
   RBUS_GTEST_UNREG_ROW,
+  RBUS_GTEST_TABLE_ROWS1,
+  RBUS_GTEST_TABLE_ROWS2,
+  RBUS_GTEST_INTERVAL_SUB1,
+  RBUS_GTEST_EVENT_BATCH1,
+  RBUS_GTEST_TABLE_ROWS3,
+  RBUS_GTEST_TABLE_ROWS4,
+  RBUS_GTEST_VALUE_CACHE1,
+  RBUS_GTEST_ASYNC_GETSET1,
+  RBUS_GTEST_GET_PAGE1,
+  RBUS_GTEST_GET_PAGE2,
+  RBUS_GTEST_GET_PAGE3,
+  RBUS_GTEST_GET_MULTI_HANDLER1,
+  RBUS_GTEST_SET_MULTI_HANDLER1,
+  RBUS_GTEST_VALUE_CHANGE_NOTIFY1,
+  RBUS_GTEST_VALUE_CHANGE_PERIOD1,
 } rbusGtest_t;
 
 int rbusConsumer(rbusGtest_t test, pid_t pid, int runtime);
@@ -0,0 +1,226 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file
+ * the following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+#include <rbus.h>
+#include "../src/rbus_valuecache.h"
+
+/*the tests keep the cache non-coherent, so it never subscribes and needs no handle*/
+
+static void put_int32(rbusValueCache_t cache, char const* name, int32_t i)
+{
+  rbusValue_t value;
+
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, i);
+  rbusValueCache_Put(cache, name, value, rbusValueCache_GetGeneration(cache));
+  rbusValue_Release(value);
+}
+
+/*the cached value of name, or -1 if there is none*/
+static int32_t get_int32(rbusValueCache_t cache, char const* name)
+{
+  rbusValue_t value;
+  int32_t i;
+
+  value = rbusValueCache_Get(cache, name);
+  if(!value)
+    return -1;
+  i = rbusValue_GetInt32(value);
+  rbusValue_Release(value);
+  return i;
+}
+
+static void update_int32(rbusValueCache_t cache, rbusEventType_t type, char const* name, int32_t i)
+{
+  rbusEvent_t event = {0};
+  rbusObject_t data;
+  rbusValue_t value;
+
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, i);
+  rbusObject_Init(&data, NULL);
+  rbusObject_SetValue(data, "value", value);
+  rbusValue_Release(value);
+
+  event.name = name;
+  event.type = type;
+  event.data = data;
+  rbusValueCache_Update(cache, &event);
+  rbusObject_Release(data);
+}
+
+TEST(rbusValueCacheTest, ttl)
+{
+  rbusValueCache_t cache;
+
+  rbusValueCache_Create(&cache, NULL);
+
+  /*off until it has a ttl*/
+  put_int32(cache, "Device.Test.Param1", 1);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+
+  rbusValueCache_SetOptions(cache, 100, false);
+  put_int32(cache, "Device.Test.Param1", 2);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), 2);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param2"), -1);
+
+  usleep(150000);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+
+  /*a new ttl drops the values cached with the old one*/
+  put_int32(cache, "Device.Test.Param1", 3);
+  rbusValueCache_SetOptions(cache, 100000, false);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+
+  put_int32(cache, "Device.Test.Param1", 4);
+  rbusValueCache_SetOptions(cache, 0, false);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+
+  rbusValueCache_Destroy(cache);
+}
+
+TEST(rbusValueCacheTest, prefixTTL)
+{
+  rbusValueCache_t cache;
+
+  rbusValueCache_Create(&cache, NULL);
+  rbusValueCache_SetOptions(cache, 100000, false);
+  rbusValueCache_SetTTL(cache, "Device.Test.", 100);
+  rbusValueCache_SetTTL(cache, "Device.Test.Off", 0);
+
+  put_int32(cache, "Device.Test.Param1", 1);
+  put_int32(cache, "Device.Test.Off.Param1", 2);
+  put_int32(cache, "Device.Test.Offset", 3);
+  put_int32(cache, "Device.Other.Param1", 4);
+
+  /*the longest prefix wins, and a prefix without a dot only matches whole names*/
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), 1);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Off.Param1"), -1);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Offset"), 3);
+  EXPECT_EQ(get_int32(cache, "Device.Other.Param1"), 4);
+
+  usleep(150000);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Offset"), -1);
+  EXPECT_EQ(get_int32(cache, "Device.Other.Param1"), 4);
+
+  /*setting a prefix's ttl again replaces it*/
+  rbusValueCache_SetTTL(cache, "Device.Test.Off", 100000);
+  put_int32(cache, "Device.Test.Off.Param1", 5);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Off.Param1"), 5);
+
+  rbusValueCache_Destroy(cache);
+}
+
+TEST(rbusValueCacheTest, invalidateAndUpdate)
+{
+  rbusValueCache_t cache;
+
+  rbusValueCache_Create(&cache, NULL);
+  rbusValueCache_SetOptions(cache, 100000, false);
+
+  put_int32(cache, "Device.Test.Param1", 1);
+  put_int32(cache, "Device.Test.Param2", 2);
+  rbusValueCache_Invalidate(cache, "Device.Test.Param1");
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param2"), 2);
+
+  /*a value-change event refills an entry, but only a value-change event and only for a cached name*/
+  update_int32(cache, RBUS_EVENT_VALUE_CHANGED, "Device.Test.Param1", 3);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), 3);
+  update_int32(cache, RBUS_EVENT_GENERAL, "Device.Test.Param1", 4);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), 3);
+  update_int32(cache, RBUS_EVENT_VALUE_CHANGED, "Device.Test.Param3", 5);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param3"), -1);
+
+  /*a put replaces the value*/
+  put_int32(cache, "Device.Test.Param2", 6);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param2"), 6);
+
+  rbusValueCache_Destroy(cache);
+}
+
+TEST(rbusValueCacheTest, stalePut)
+{
+  rbusValueCache_t cache;
+  rbusValue_t value;
+  uint64_t generation;
+
+  rbusValueCache_Create(&cache, NULL);
+  rbusValueCache_SetOptions(cache, 100000, false);
+  rbusValue_Init(&value);
+  rbusValue_SetInt32(value, 1);
+
+  /*a get in flight when its name is invalidated doesn't cache what it got*/
+  put_int32(cache, "Device.Test.Param1", 1);
+  generation = rbusValueCache_GetGeneration(cache);
+  rbusValueCache_Invalidate(cache, "Device.Test.Param1");
+  rbusValueCache_Put(cache, "Device.Test.Param1", value, generation);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), -1);
+
+  /*nor when it's updated by an event*/
+  put_int32(cache, "Device.Test.Param1", 2);
+  generation = rbusValueCache_GetGeneration(cache);
+  update_int32(cache, RBUS_EVENT_VALUE_CHANGED, "Device.Test.Param1", 3);
+  rbusValueCache_Put(cache, "Device.Test.Param1", value, generation);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param1"), 3);
+
+  /*nor when the name wasn't cached yet*/
+  generation = rbusValueCache_GetGeneration(cache);
+  rbusValueCache_Invalidate(cache, "Device.Test.Param2");
+  rbusValueCache_Put(cache, "Device.Test.Param2", value, generation);
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param2"), -1);
+
+  /*a get made after the invalidation is cached*/
+  rbusValueCache_Put(cache, "Device.Test.Param2", value, rbusValueCache_GetGeneration(cache));
+  EXPECT_EQ(get_int32(cache, "Device.Test.Param2"), 1);
+
+  rbusValue_Release(value);
+  rbusValueCache_Destroy(cache);
+}
+
+TEST(rbusValueCacheTest, full)
+{
+  rbusValueCache_t cache;
+  char name[64];
+  int i, cached = 0;
+
+  rbusValueCache_Create(&cache, NULL);
+  rbusValueCache_SetOptions(cache, 100000, false);
+
+  /*filling it past its size evicts older entries but always keeps the newest*/
+  for(i = 0; i < 10000; i++)
+  {
+    snprintf(name, sizeof(name), "Device.Test.%d", i);
+    put_int32(cache, name, i);
+    EXPECT_EQ(get_int32(cache, name), i);
+  }
+  for(i = 0; i < 10000; i++)
+  {
+    snprintf(name, sizeof(name), "Device.Test.%d", i);
+    if(get_int32(cache, name) == i)
+      cached++;
+  }
+  EXPECT_GT(cached, 0);
+  EXPECT_LE(cached, 4096);
+
+  rbusValueCache_Destroy(cache);
+}
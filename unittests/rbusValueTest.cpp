@@ -1126,3 +1126,89 @@ TEST(rbusValueEncDecTlv, enc_dec_tlv_string)
   sprintf(buffer,"%s","test string");
   exec_encode_decode_tlv_test(RBUS_STRING,buffer);
 }
+
+TEST(rbusValueEncDecTlv, enc_dec_tlv_sequence)
+{
+  rbusValue_t valIn[3], valOut;
+  rbusBuffer_t buff;
+  int i;
+
+  rbusValue_Init(&valIn[0]);
+  rbusValue_SetInt32(valIn[0], -12345);
+  rbusValue_Init(&valIn[1]);
+  rbusValue_SetString(valIn[1], "round trip");
+  rbusValue_Init(&valIn[2]);
+  rbusValue_SetBoolean(valIn[2], true);
+
+  rbusBuffer_Create(&buff);
+  for(i = 0; i < 3; i++)
+    EXPECT_GE(rbusValue_Encode(valIn[i], buff), 0);
+
+  for(i = 0; i < 3; i++)
+  {
+    EXPECT_GE(rbusValue_Decode(&valOut, buff), 0);
+    EXPECT_EQ(rbusValue_Compare(valIn[i], valOut), 0);
+    rbusValue_Release(valOut);
+  }
+  EXPECT_EQ(buff->posRead, buff->posWrite);
+  rbusBuffer_Destroy(buff);
+
+  for(i = 0; i < 3; i++)
+    rbusValue_Release(valIn[i]);
+}
+
+TEST(rbusValueEncDecTlv, buffer_read_bounds)
+{
+  rbusBuffer_t buff;
+  uint8_t data[64];
+  uint8_t out[64];
+
+  memset(data, 0xa5, sizeof(data));
+  rbusBuffer_Create(&buff);
+  rbusBuffer_Write(buff, data, sizeof(data));
+  EXPECT_EQ(buff->lenAlloc, (int)sizeof(data));
+
+  /*a read that ends exactly at the end of the buffer succeeds*/
+  EXPECT_EQ(rbusBuffer_Read(buff, out, sizeof(out)), 0);
+  EXPECT_EQ(memcmp(data, out, sizeof(out)), 0);
+
+  /*one byte past the end fails and leaves the read position alone*/
+  EXPECT_EQ(rbusBuffer_Read(buff, out, 1), -1);
+  buff->posRead = 60;
+  EXPECT_EQ(rbusBuffer_Read(buff, out, 5), -1);
+  EXPECT_EQ(buff->posRead, 60);
+  EXPECT_EQ(rbusBuffer_Read(buff, out, 4), 0);
+
+  rbusBuffer_Destroy(buff);
+}
+
+TEST(rbusValueEncDecTlv, enc_dec_tlv_exact_length)
+{
+  struct _rbusBuffer view;
+  rbusValue_t valIn, valOut = NULL;
+  rbusBuffer_t buff;
+
+  rbusValue_Init(&valIn);
+  rbusValue_SetUInt64(valIn, 0x0102030405060708ULL);
+  rbusBuffer_Create(&buff);
+  rbusValue_Encode(valIn, buff);
+
+  /*decode from a view sized to the encoded bytes, as rbus does for received messages,
+    so the value's last byte is the buffer's last byte*/
+  memset(&view, 0, sizeof(view));
+  view.data = buff->data;
+  view.lenAlloc = view.posWrite = buff->posWrite;
+  EXPECT_GE(rbusValue_Decode(&valOut, &view), 0);
+  EXPECT_EQ(rbusValue_Compare(valIn, valOut), 0);
+  EXPECT_EQ(view.posRead, view.lenAlloc);
+  rbusValue_Release(valOut);
+
+  /*one byte short of the value fails*/
+  view.posRead = 0;
+  view.lenAlloc = view.posWrite = buff->posWrite - 1;
+  EXPECT_EQ(rbusValue_Decode(&valOut, &view), -1);
+  rbusValue_Release(valOut);
+
+  rbusBuffer_Destroy(buff);
+  rbusValue_Release(valIn);
+}